@@ -9,6 +9,7 @@
 #ifndef CPPTRADER_MATCHING_LEVEL_H
 #define CPPTRADER_MATCHING_LEVEL_H
 
+#include "level_queue.h"
 #include "order.h"
 #include "update.h"
 
@@ -33,17 +34,17 @@ struct Level
     //! Level type
     LevelType Type;
     //! Level price
-    uint64_t Price;
+    PriceValue Price;
     //! Level volume
-    uint64_t TotalVolume;
+    VolumeValue TotalVolume;
     //! Level hidden volume
-    uint64_t HiddenVolume;
+    VolumeValue HiddenVolume;
     //! Level visible volume
-    uint64_t VisibleVolume;
+    VolumeValue VisibleVolume;
     //! Level orders
-    size_t Orders;
+    CountValue Orders;
 
-    Level(LevelType type, uint64_t price) noexcept;
+    Level(LevelType type, PriceValue price) noexcept;
     Level(const Level&) noexcept = default;
     Level(Level&&) noexcept = default;
     ~Level() noexcept = default;
@@ -77,10 +78,30 @@ struct Level
 //! Price level node
 struct LevelNode : public Level, public CppCommon::BinTreeAVL<LevelNode>::Node
 {
-    //! Price level orders
+    //! Price level displayed orders
     CppCommon::List<OrderNode> OrderList;
-
-    LevelNode(LevelType type, uint64_t price) noexcept;
+    //! Price level displayed orders queue
+    LevelQueue Queue;
+    //! Price level hidden orders
+    CppCommon::List<OrderNode> HiddenOrderList;
+    //! Price level hidden orders queue
+    LevelQueue HiddenQueue;
+    //! Price level hidden orders volume
+    VolumeValue HiddenOrderVolume;
+    //! Price level hidden orders
+    CountValue HiddenOrders;
+    //! Price level 'All-Or-None' orders volume
+    VolumeValue AONVolume;
+    //! Price level 'All-Or-None' orders
+    CountValue AONOrders;
+    //! Price level top order which improved the market (nullptr if none)
+    OrderNode* TopOrder;
+    //! Price level owners filter (bloom filter of owner bits of resting orders)
+    uint64_t OwnerMask;
+    //! Price level owners filter keeps owners of orders which left the price level
+    bool OwnerMaskStale;
+
+    LevelNode(LevelType type, PriceValue price) noexcept;
     LevelNode(const Level& level) noexcept;
     LevelNode(const LevelNode&) noexcept = default;
     LevelNode(LevelNode&&) noexcept = default;
@@ -90,6 +111,19 @@ struct LevelNode : public Level, public CppCommon::BinTreeAVL<LevelNode>::Node
     LevelNode& operator=(const LevelNode&) noexcept = default;
     LevelNode& operator=(LevelNode&&) noexcept = default;
 
+    //! Get the first order of the price level in the matching order
+    /*!
+        Displayed orders are matched ahead of hidden orders of the price level.
+    */
+    OrderNode* FrontOrder() noexcept
+    { return (OrderList.front() != nullptr) ? OrderList.front() : HiddenOrderList.front(); }
+    //! Get the next order of the price level in the matching order
+    OrderNode* NextOrder(const OrderNode* order_ptr) noexcept
+    { return ((order_ptr->next == nullptr) && !order_ptr->IsHidden()) ? HiddenOrderList.front() : order_ptr->next; }
+
+    //! Rebuild the stale price level owners filter from owners of resting orders
+    void RebuildOwnerMask() noexcept;
+
     // Price level comparison
     friend bool operator==(const LevelNode& level1, const LevelNode& level2) noexcept
     { return level1.Price == level2.Price; }
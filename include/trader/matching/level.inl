@@ -27,7 +27,7 @@ inline TOutputStream& operator<<(TOutputStream& stream, LevelType type)
     return stream;
 }
 
-inline Level::Level(LevelType type, uint64_t price) noexcept
+inline Level::Level(LevelType type, PriceValue price) noexcept
     : Type(type),
       Price(price),
       TotalVolume(0),
@@ -50,12 +50,27 @@ inline TOutputStream& operator<<(TOutputStream& stream, const Level& level)
     return stream;
 }
 
-inline LevelNode::LevelNode(LevelType type, uint64_t price) noexcept
-    : Level(type, price)
+inline LevelNode::LevelNode(LevelType type, PriceValue price) noexcept
+    : Level(type, price),
+      HiddenOrderVolume(0),
+      HiddenOrders(0),
+      AONVolume(0),
+      AONOrders(0),
+      TopOrder(nullptr),
+      OwnerMask(0),
+      OwnerMaskStale(false)
 {
 }
 
-inline LevelNode::LevelNode(const Level& level) noexcept : Level(level)
+inline LevelNode::LevelNode(const Level& level) noexcept
+    : Level(level),
+      HiddenOrderVolume(0),
+      HiddenOrders(0),
+      AONVolume(0),
+      AONOrders(0),
+      TopOrder(nullptr),
+      OwnerMask(0),
+      OwnerMaskStale(false)
 {
 }
 
@@ -63,9 +78,29 @@ inline LevelNode& LevelNode::operator=(const Level& level) noexcept
 {
     Level::operator=(level);
     OrderList.clear();
+    Queue.clear();
+    HiddenOrderList.clear();
+    HiddenQueue.clear();
+    HiddenOrderVolume = 0;
+    HiddenOrders = 0;
+    AONVolume = 0;
+    AONOrders = 0;
+    TopOrder = nullptr;
+    OwnerMask = 0;
+    OwnerMaskStale = false;
     return *this;
 }
 
+inline void LevelNode::RebuildOwnerMask() noexcept
+{
+    OwnerMask = 0;
+    for (const OrderNode* order_ptr = OrderList.front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+        OwnerMask |= order_ptr->OwnerMask();
+    for (const OrderNode* order_ptr = HiddenOrderList.front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+        OwnerMask |= order_ptr->OwnerMask();
+    OwnerMaskStale = false;
+}
+
 inline LevelUpdate::LevelUpdate(UpdateType type, const Level& update, bool top) noexcept
     : Type(type),
       Update(update),
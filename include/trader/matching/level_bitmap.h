@@ -0,0 +1,90 @@
+/*!
+    \file level_bitmap.h
+    \brief Price level bitmap definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_LEVEL_BITMAP_H
+#define CPPTRADER_MATCHING_LEVEL_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace CppTrader {
+namespace Matching {
+
+//! Price level bitmap
+/*!
+    Price level bitmap is a hierarchical occupancy bitmap over price ticks.
+    Each bit of the upper bitmap level marks a non-empty 64-bit word of the
+    lower one, so finding the next or the previous occupied price tick takes
+    one bit scan per bitmap level (three levels cover 262144 price ticks).
+
+    Not thread-safe.
+*/
+class LevelBitmap
+{
+public:
+    //! Not found index
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    //! Initialize the price level bitmap
+    /*!
+        \param size - Bitmap size in bits (default is 0)
+    */
+    explicit LevelBitmap(size_t size = 0);
+    LevelBitmap(const LevelBitmap&) = default;
+    LevelBitmap(LevelBitmap&&) = default;
+    ~LevelBitmap() = default;
+
+    LevelBitmap& operator=(const LevelBitmap&) = default;
+    LevelBitmap& operator=(LevelBitmap&&) = default;
+
+    //! Get the bitmap size in bits
+    size_t size() const noexcept { return _size; }
+
+    //! Test the bit with the given index
+    bool test(size_t index) const noexcept;
+    //! Set the bit with the given index
+    void set(size_t index) noexcept;
+    //! Reset the bit with the given index
+    void reset(size_t index) noexcept;
+    //! Reset all bits
+    void clear() noexcept;
+
+    //! Find the first set bit with the index greater or equal to the given one
+    /*!
+        \param index - Bit index to start from
+        \return Index of the found bit or npos
+    */
+    size_t FindNext(size_t index) const noexcept;
+    //! Find the last set bit with the index less or equal to the given one
+    /*!
+        \param index - Bit index to start from
+        \return Index of the found bit or npos
+    */
+    size_t FindPrev(size_t index) const noexcept;
+
+private:
+    size_t _size;
+    // Bitmap levels from the lowest (one bit per price tick) to the highest (single word)
+    std::vector<std::vector<uint64_t>> _levels;
+
+    static size_t LowestBit(uint64_t value) noexcept;
+    static size_t HighestBit(uint64_t value) noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "level_bitmap.inl"
+
+#endif // CPPTRADER_MATCHING_LEVEL_BITMAP_H
@@ -0,0 +1,159 @@
+/*!
+    \file level_bitmap.inl
+    \brief Price level bitmap inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline LevelBitmap::LevelBitmap(size_t size) : _size(size)
+{
+    // Build bitmap levels until the single word level
+    size_t bits = size;
+    while (bits > 0)
+    {
+        size_t words = (bits + 63) / 64;
+        _levels.emplace_back(words, 0);
+        bits = (words > 1) ? words : 0;
+    }
+}
+
+inline size_t LevelBitmap::LowestBit(uint64_t value) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return index;
+#else
+    return (size_t)__builtin_ctzll(value);
+#endif
+}
+
+inline size_t LevelBitmap::HighestBit(uint64_t value) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return index;
+#else
+    return (size_t)(63 - __builtin_clzll(value));
+#endif
+}
+
+inline bool LevelBitmap::test(size_t index) const noexcept
+{
+    return (index < _size) && ((_levels[0][index >> 6] & (1ull << (index & 63))) != 0);
+}
+
+inline void LevelBitmap::set(size_t index) noexcept
+{
+    for (auto& level : _levels)
+    {
+        uint64_t& word = level[index >> 6];
+        bool empty = (word == 0);
+        word |= (1ull << (index & 63));
+
+        // Upper levels already mark the non-empty word
+        if (!empty)
+            break;
+
+        index >>= 6;
+    }
+}
+
+inline void LevelBitmap::reset(size_t index) noexcept
+{
+    for (auto& level : _levels)
+    {
+        uint64_t& word = level[index >> 6];
+        word &= ~(1ull << (index & 63));
+
+        // Upper levels must mark the non-empty word
+        if (word != 0)
+            break;
+
+        index >>= 6;
+    }
+}
+
+inline void LevelBitmap::clear() noexcept
+{
+    for (auto& level : _levels)
+        std::fill(level.begin(), level.end(), 0);
+}
+
+inline size_t LevelBitmap::FindNext(size_t index) const noexcept
+{
+    if (index >= _size)
+        return npos;
+
+    // Ascend bitmap levels until the set bit is found
+    size_t level = 0;
+    for (;;)
+    {
+        if (level == _levels.size())
+            return npos;
+
+        size_t word = index >> 6;
+        if (word >= _levels[level].size())
+            return npos;
+
+        uint64_t bits = _levels[level][word] & (~0ull << (index & 63));
+        if (bits != 0)
+        {
+            index = (word << 6) + LowestBit(bits);
+            break;
+        }
+
+        index = word + 1;
+        ++level;
+    }
+
+    // Descend bitmap levels to the lowest set bit
+    while (level-- > 0)
+        index = (index << 6) + LowestBit(_levels[level][index]);
+
+    return index;
+}
+
+inline size_t LevelBitmap::FindPrev(size_t index) const noexcept
+{
+    if (_size == 0)
+        return npos;
+    if (index >= _size)
+        index = _size - 1;
+
+    // Ascend bitmap levels until the set bit is found
+    size_t level = 0;
+    for (;;)
+    {
+        if (level == _levels.size())
+            return npos;
+
+        size_t word = index >> 6;
+        uint64_t bits = _levels[level][word] & (~0ull >> (63 - (index & 63)));
+        if (bits != 0)
+        {
+            index = (word << 6) + HighestBit(bits);
+            break;
+        }
+
+        if (word == 0)
+            return npos;
+
+        index = word - 1;
+        ++level;
+    }
+
+    // Descend bitmap levels to the highest set bit
+    while (level-- > 0)
+        index = (index << 6) + HighestBit(_levels[level][index]);
+
+    return index;
+}
+
+} // namespace Matching
+} // namespace CppTrader
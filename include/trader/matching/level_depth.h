@@ -0,0 +1,126 @@
+/*!
+    \file level_depth.h
+    \brief Price level depth cache definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_LEVEL_DEPTH_H
+#define CPPTRADER_MATCHING_LEVEL_DEPTH_H
+
+#include "level.h"
+
+#include <cassert>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Price level depth cache
+/*!
+    Price level depth cache keeps copies of the top N price levels of one
+    order book side in a contiguous array from the best price level to the
+    worst one. Order book updates the cache in place on every price level
+    change, so depth consumers read it as a plain array without walking
+    price level containers. Version is incremented on every cache change
+    and could be used to detect updates and torn copies.
+
+    Depth cache with zero capacity is disabled.
+
+    Not thread-safe.
+*/
+class LevelDepth
+{
+public:
+    // Standard container type definitions
+    typedef Level value_type;
+    typedef std::vector<Level>::const_iterator const_iterator;
+
+    //! Initialize the price level depth cache
+    /*!
+        \param type - Price level type of the order book side
+        \param capacity - Depth cache capacity (default is 0)
+    */
+    explicit LevelDepth(LevelType type, size_t capacity = 0);
+    LevelDepth(const LevelDepth&) = delete;
+    LevelDepth(LevelDepth&&) = delete;
+    ~LevelDepth() = default;
+
+    LevelDepth& operator=(const LevelDepth&) = delete;
+    LevelDepth& operator=(LevelDepth&&) = delete;
+
+    //! Check if the depth cache is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Is the depth cache empty?
+    bool empty() const noexcept { return _levels.empty(); }
+    //! Is the depth cache full?
+    bool full() const noexcept { return _levels.size() == _capacity; }
+
+    //! Get the depth cache size
+    size_t size() const noexcept { return _levels.size(); }
+    //! Get the depth cache capacity
+    size_t capacity() const noexcept { return _capacity; }
+    //! Get the depth cache version
+    uint64_t version() const noexcept { return _version; }
+
+    //! Get the depth cache price levels from the best one
+    const Level* data() const noexcept { return _levels.data(); }
+    //! Get the depth cache price level with the given index
+    const Level& operator[](size_t index) const noexcept { return _levels[index]; }
+
+    //! Get the begin depth cache iterator
+    const_iterator begin() const noexcept { return _levels.begin(); }
+    //! Get the end depth cache iterator
+    const_iterator end() const noexcept { return _levels.end(); }
+
+    //! Clear the depth cache and set its capacity
+    /*!
+        \param capacity - Depth cache capacity
+    */
+    void reset(size_t capacity);
+
+    //! Insert a new price level into the depth cache
+    /*!
+        Price level worse than all cached ones is not inserted into the full
+        depth cache. The worst cached price level is dropped when a better
+        price level is inserted into the full depth cache.
+
+        \param level - Price level to insert
+    */
+    void insert(const Level& level);
+    //! Update the cached price level
+    /*!
+        \param level - Price level to update
+    */
+    void update(const Level& level);
+    //! Erase the price level from the depth cache
+    /*!
+        \param level - Price level to erase
+        \return 'true' if the price level was cached, 'false' otherwise
+    */
+    bool erase(const Level& level);
+    //! Append the price level worse than all cached ones to the depth cache
+    /*!
+        \param level - Price level to append
+    */
+    void push_back(const Level& level);
+
+private:
+    LevelType _type;
+    size_t _capacity;
+    uint64_t _version;
+    std::vector<Level> _levels;
+
+    bool IsBetter(PriceValue price1, PriceValue price2) const noexcept
+    { return (_type == LevelType::BID) ? (price1 > price2) : (price1 < price2); }
+    size_t GetPosition(PriceValue price) const noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "level_depth.inl"
+
+#endif // CPPTRADER_MATCHING_LEVEL_DEPTH_H
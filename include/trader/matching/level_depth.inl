@@ -0,0 +1,86 @@
+/*!
+    \file level_depth.inl
+    \brief Price level depth cache inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline LevelDepth::LevelDepth(LevelType type, size_t capacity)
+    : _type(type),
+      _capacity(0),
+      _version(0)
+{
+    reset(capacity);
+}
+
+inline void LevelDepth::reset(size_t capacity)
+{
+    // Reserve the whole capacity, so cached price levels are never moved
+    _levels.clear();
+    _levels.reserve(capacity);
+    _capacity = capacity;
+    ++_version;
+}
+
+inline size_t LevelDepth::GetPosition(PriceValue price) const noexcept
+{
+    // Find the first cached price level which is not better than the given price
+    size_t index = 0;
+    while ((index < _levels.size()) && IsBetter(_levels[index].Price, price))
+        ++index;
+    return index;
+}
+
+inline void LevelDepth::insert(const Level& level)
+{
+    size_t index = GetPosition(level.Price);
+
+    // Skip the price level worse than all levels of the full depth cache
+    if (index == _capacity)
+        return;
+
+    // Drop the worst cached price level
+    if (full())
+        _levels.pop_back();
+
+    _levels.insert(_levels.begin() + index, level);
+    ++_version;
+}
+
+inline void LevelDepth::update(const Level& level)
+{
+    size_t index = GetPosition(level.Price);
+    if ((index < _levels.size()) && (_levels[index].Price == level.Price))
+    {
+        _levels[index] = level;
+        ++_version;
+    }
+}
+
+inline bool LevelDepth::erase(const Level& level)
+{
+    size_t index = GetPosition(level.Price);
+    if ((index < _levels.size()) && (_levels[index].Price == level.Price))
+    {
+        _levels.erase(_levels.begin() + index);
+        ++_version;
+        return true;
+    }
+    return false;
+}
+
+inline void LevelDepth::push_back(const Level& level)
+{
+    assert(!full() && "Price level depth cache is full!");
+    assert((empty() || IsBetter(_levels.back().Price, level.Price)) && "Price level must be worse than all cached ones!");
+
+    _levels.push_back(level);
+    ++_version;
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,195 @@
+/*!
+    \file level_ladder.h
+    \brief Price level ladder definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_LEVEL_LADDER_H
+#define CPPTRADER_MATCHING_LEVEL_LADDER_H
+
+#include "level.h"
+#include "level_bitmap.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+class LevelLadder;
+
+//! Price level ladder iterator
+/*!
+    Iterates price levels of the ladder in ascending price order.
+*/
+template <typename T>
+class LevelLadderIterator
+{
+    friend class LevelLadder;
+
+public:
+    // Standard iterator type definitions
+    typedef std::ptrdiff_t difference_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T* pointer;
+    typedef std::forward_iterator_tag iterator_category;
+
+    LevelLadderIterator() noexcept : _container(nullptr), _node(nullptr) {}
+    LevelLadderIterator(const LevelLadder* container, T* node) noexcept : _container(container), _node(node) {}
+    LevelLadderIterator(const LevelLadderIterator&) noexcept = default;
+    LevelLadderIterator(LevelLadderIterator&&) noexcept = default;
+    ~LevelLadderIterator() noexcept = default;
+
+    LevelLadderIterator& operator=(const LevelLadderIterator&) noexcept = default;
+    LevelLadderIterator& operator=(LevelLadderIterator&&) noexcept = default;
+
+    friend bool operator==(const LevelLadderIterator& it1, const LevelLadderIterator& it2) noexcept
+    { return it1._node == it2._node; }
+    friend bool operator!=(const LevelLadderIterator& it1, const LevelLadderIterator& it2) noexcept
+    { return it1._node != it2._node; }
+
+    LevelLadderIterator& operator++() noexcept;
+    LevelLadderIterator operator++(int) noexcept;
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept { return _node; }
+
+private:
+    const LevelLadder* _container;
+    T* _node;
+};
+
+//! Price level ladder
+/*!
+    Price level ladder is a container of price levels for one side of the order
+    book. Price levels near the best price are kept in a contiguous array indexed
+    by the price tick, so price level lookup, insert and delete are O(1). Occupied
+    slots are tracked in the hierarchical bitmap, so the next price level and the
+    best price level are found with a few bit scans. The array window is centred
+    on the best price and recentred when the best price leaves the inner half of
+    the window. Price levels outside of the window or not aligned to the tick are
+    kept in an overflow AVL tree.
+
+    Ladder with zero size keeps all price levels in the overflow tree.
+
+    Not thread-safe.
+*/
+class LevelLadder
+{
+public:
+    //! Overflow price level container
+    typedef CppCommon::BinTreeAVL<LevelNode, std::less<LevelNode>> Overflow;
+
+    // Standard container type definitions
+    typedef LevelNode value_type;
+    typedef LevelLadderIterator<LevelNode> iterator;
+    typedef LevelLadderIterator<const LevelNode> const_iterator;
+
+    //! Initialize the price level ladder
+    /*!
+        \param type - Price level type of the ladder side
+        \param size - Ladder window size in price ticks (default is 0 which means no ladder)
+        \param tick - Ladder price tick (default is 1)
+    */
+    explicit LevelLadder(LevelType type, size_t size = 0, uint64_t tick = 1);
+    LevelLadder(const LevelLadder&) = delete;
+    LevelLadder(LevelLadder&&) = delete;
+    ~LevelLadder() = default;
+
+    LevelLadder& operator=(const LevelLadder&) = delete;
+    LevelLadder& operator=(LevelLadder&&) = delete;
+
+    //! Check if the ladder is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Is the ladder empty?
+    bool empty() const noexcept { return _size == 0; }
+
+    //! Get the ladder size
+    size_t size() const noexcept { return _size; }
+    //! Get the ladder window size in price ticks
+    size_t window() const noexcept { return _slots.size(); }
+    //! Get the ladder price tick
+    uint64_t tick() const noexcept { return _tick; }
+
+    //! Get the ladder best price level
+    LevelNode* best() const noexcept { return _best; }
+    //! Get the ladder lowest price level
+    LevelNode* lowest() const noexcept;
+    //! Get the ladder highest price level
+    LevelNode* highest() const noexcept;
+
+    //! Get the next price level with a higher price
+    LevelNode* higher(const LevelNode* level) const noexcept;
+    //! Get the next price level with a lower price
+    LevelNode* lower(const LevelNode* level) const noexcept;
+
+    //! Get the begin ladder iterator
+    iterator begin() noexcept { return iterator(this, lowest()); }
+    const_iterator begin() const noexcept { return const_iterator(this, lowest()); }
+    //! Get the end ladder iterator
+    iterator end() noexcept { return iterator(this, nullptr); }
+    const_iterator end() const noexcept { return const_iterator(this, nullptr); }
+
+    //! Find the price level with the given price
+    /*!
+        \param price - Price
+        \return Pointer to the price level with the given price or nullptr
+    */
+    LevelNode* find(PriceValue price) const noexcept;
+
+    //! Insert a new price level into the ladder
+    /*!
+        \param level - Price level to insert
+    */
+    void insert(LevelNode& level);
+    //! Erase the price level from the ladder
+    /*!
+        \param level - Price level to erase
+    */
+    void erase(LevelNode& level);
+
+    //! Recentre the ladder window on the given price
+    /*!
+        \param price - Price to recentre on
+    */
+    void recenter(PriceValue price);
+
+    //! Clear the ladder
+    void clear() noexcept;
+
+private:
+    // Ladder side
+    LevelType _type;
+    size_t _size;
+    LevelNode* _best;
+
+    // Ladder window
+    uint64_t _tick;
+    uint64_t _base;
+    size_t _count;
+    std::vector<LevelNode*> _slots;
+    LevelBitmap _bitmap;
+
+    // Overflow price levels
+    Overflow _overflow;
+
+    // Ladder window helpers
+    bool IsSlot(PriceValue price) const noexcept;
+    size_t GetSlot(PriceValue price) const noexcept { return (size_t)(price / _tick - _base); }
+    bool IsCentered(PriceValue price) const noexcept;
+    LevelNode* FindSlotForward(size_t index) const noexcept;
+    LevelNode* FindSlotBackward(size_t index) const noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "level_ladder.inl"
+
+#endif // CPPTRADER_MATCHING_LEVEL_LADDER_H
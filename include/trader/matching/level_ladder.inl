@@ -0,0 +1,159 @@
+/*!
+    \file level_ladder.inl
+    \brief Price level ladder inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <typename T>
+inline LevelLadderIterator<T>& LevelLadderIterator<T>::operator++() noexcept
+{
+    if (_node != nullptr)
+        _node = _container->higher(_node);
+    return *this;
+}
+
+template <typename T>
+inline LevelLadderIterator<T> LevelLadderIterator<T>::operator++(int) noexcept
+{
+    LevelLadderIterator<T> result(*this);
+    operator++();
+    return result;
+}
+
+template <typename T>
+inline typename LevelLadderIterator<T>::reference LevelLadderIterator<T>::operator*() const noexcept
+{
+    assert((_node != nullptr) && "Iterator must be valid!");
+
+    return *_node;
+}
+
+inline bool LevelLadder::IsSlot(PriceValue price) const noexcept
+{
+    if (_slots.empty() || ((price % _tick) != 0))
+        return false;
+
+    uint64_t tick = price / _tick;
+    return (tick >= _base) && ((tick - _base) < _slots.size());
+}
+
+inline bool LevelLadder::IsCentered(PriceValue price) const noexcept
+{
+    // Zero size ladder never needs recentering
+    if (_slots.empty())
+        return true;
+
+    // Window that already starts at zero price cannot be moved lower
+    uint64_t tick = price / _tick;
+    uint64_t quarter = _slots.size() / 4;
+    if ((tick < (_base + quarter)) && (_base > 0))
+        return false;
+
+    return (tick < (_base + _slots.size() - quarter));
+}
+
+inline LevelNode* LevelLadder::FindSlotForward(size_t index) const noexcept
+{
+    if (_count == 0)
+        return nullptr;
+
+    // Find the first occupied slot starting from the given index
+    size_t slot = _bitmap.FindNext(index);
+    return (slot != LevelBitmap::npos) ? _slots[slot] : nullptr;
+}
+
+inline LevelNode* LevelLadder::FindSlotBackward(size_t index) const noexcept
+{
+    if ((_count == 0) || (index == 0))
+        return nullptr;
+
+    // Find the last occupied slot before the given index
+    size_t slot = _bitmap.FindPrev(index - 1);
+    return (slot != LevelBitmap::npos) ? _slots[slot] : nullptr;
+}
+
+inline LevelNode* LevelLadder::lowest() const noexcept
+{
+    LevelNode* slot = FindSlotForward(0);
+    LevelNode* tree = (LevelNode*)_overflow.lowest();
+
+    if (slot == nullptr)
+        return tree;
+    if (tree == nullptr)
+        return slot;
+    return (tree->Price < slot->Price) ? tree : slot;
+}
+
+inline LevelNode* LevelLadder::highest() const noexcept
+{
+    LevelNode* slot = FindSlotBackward(_slots.size());
+    LevelNode* tree = (LevelNode*)_overflow.highest();
+
+    if (slot == nullptr)
+        return tree;
+    if (tree == nullptr)
+        return slot;
+    return (tree->Price > slot->Price) ? tree : slot;
+}
+
+inline LevelNode* LevelLadder::higher(const LevelNode* level) const noexcept
+{
+    // Find the first slot with a price greater than the given one
+    uint64_t tick = level->Price / _tick + 1;
+    LevelNode* slot = FindSlotForward((tick > _base) ? (size_t)std::min<uint64_t>(tick - _base, _slots.size()) : 0);
+    if (_overflow.empty())
+        return slot;
+
+    auto it = _overflow.upper_bound(*level);
+    LevelNode* tree = (it != _overflow.end()) ? (LevelNode*)it.operator->() : nullptr;
+
+    if (slot == nullptr)
+        return tree;
+    if (tree == nullptr)
+        return slot;
+    return (tree->Price < slot->Price) ? tree : slot;
+}
+
+inline LevelNode* LevelLadder::lower(const LevelNode* level) const noexcept
+{
+    // Find the last slot with a price less than the given one
+    uint64_t tick = level->Price / _tick + (((level->Price % _tick) != 0) ? 1 : 0);
+    LevelNode* slot = FindSlotBackward((tick > _base) ? (size_t)std::min<uint64_t>(tick - _base, _slots.size()) : 0);
+    if (_overflow.empty())
+        return slot;
+
+    // Find the last overflow price level with a price less than the given one
+    LevelNode* tree = nullptr;
+    auto it = _overflow.lower_bound(*level);
+    if (it != _overflow.end())
+    {
+        Overflow::const_reverse_iterator rit(&_overflow, it.operator->());
+        ++rit;
+        tree = (LevelNode*)rit.operator->();
+    }
+    else
+        tree = (LevelNode*)_overflow.highest();
+
+    if (slot == nullptr)
+        return tree;
+    if (tree == nullptr)
+        return slot;
+    return (tree->Price > slot->Price) ? tree : slot;
+}
+
+inline LevelNode* LevelLadder::find(PriceValue price) const noexcept
+{
+    if (IsSlot(price))
+        return _slots[GetSlot(price)];
+
+    auto it = _overflow.find(LevelNode(_type, price));
+    return (it != _overflow.end()) ? (LevelNode*)it.operator->() : nullptr;
+}
+
+} // namespace Matching
+} // namespace CppTrader
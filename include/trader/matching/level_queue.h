@@ -0,0 +1,135 @@
+/*!
+    \file level_queue.h
+    \brief Price level queue definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_LEVEL_QUEUE_H
+#define CPPTRADER_MATCHING_LEVEL_QUEUE_H
+
+#include "types.h"
+
+#include <cassert>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Order queue position
+struct QueuePosition
+{
+    //! Count of orders ahead
+    CountValue Position;
+    //! Visible volume ahead
+    VolumeValue VisibleVolume;
+    //! Hidden volume ahead
+    VolumeValue HiddenVolume;
+
+    QueuePosition() noexcept : Position(0), VisibleVolume(0), HiddenVolume(0) {}
+    QueuePosition(const QueuePosition&) noexcept = default;
+    QueuePosition(QueuePosition&&) noexcept = default;
+    ~QueuePosition() noexcept = default;
+
+    QueuePosition& operator=(const QueuePosition&) noexcept = default;
+    QueuePosition& operator=(QueuePosition&&) noexcept = default;
+};
+
+//! Price level queue
+/*!
+    Price level queue assigns sequence numbers to orders in the order they
+    are queued at the price level and keeps Fenwick trees of orders count,
+    visible and hidden leaves quantity over the sequence numbers. Queue
+    position of an order and the volume ahead of it are prefix sums, so
+    both updates and queries take O(log N).
+
+    Sequence numbers are never reused. When the queue runs out of sequence
+    numbers the owner rebuilds it from the price level orders list with
+    the capacity twice the count of live orders, which keeps the amortized
+    update cost logarithmic under heavy cancel churn.
+
+    Queue is inactive (empty) until it is built for the first time.
+
+    Not thread-safe.
+*/
+class LevelQueue
+{
+public:
+    //! Minimal queue capacity
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    LevelQueue() noexcept : _next(0) {}
+    LevelQueue(const LevelQueue&) noexcept : _next(0) {}
+    LevelQueue(LevelQueue&&) noexcept = default;
+    ~LevelQueue() noexcept = default;
+
+    LevelQueue& operator=(const LevelQueue&) noexcept { clear(); return *this; }
+    LevelQueue& operator=(LevelQueue&&) noexcept = default;
+
+    //! Is the queue active?
+    bool active() const noexcept { return !_tree.empty(); }
+    //! Is the queue out of sequence numbers?
+    bool full() const noexcept { return _next == _tree.size(); }
+
+    //! Get the queue capacity
+    size_t capacity() const noexcept { return _tree.size(); }
+
+    //! Reset the queue with the given capacity
+    /*!
+        \param capacity - Queue capacity
+    */
+    void reset(size_t capacity);
+    //! Clear and deactivate the queue
+    void clear() noexcept;
+
+    //! Push a new order to the end of the queue
+    /*!
+        \param visible - Order visible quantity
+        \param hidden - Order hidden quantity
+        \return Order sequence number
+    */
+    size_t push(QuantityValue visible, QuantityValue hidden) noexcept;
+    //! Reduce the order in the queue
+    /*!
+        \param sequence - Order sequence number
+        \param visible - Order visible quantity to reduce
+        \param hidden - Order hidden quantity to reduce
+    */
+    void reduce(size_t sequence, QuantityValue visible, QuantityValue hidden) noexcept;
+    //! Erase the order from the queue
+    /*!
+        \param sequence - Order sequence number
+        \param visible - Order visible quantity
+        \param hidden - Order hidden quantity
+    */
+    void erase(size_t sequence, QuantityValue visible, QuantityValue hidden) noexcept;
+
+    //! Get the queue position of the order
+    /*!
+        \param sequence - Order sequence number
+        \return Count of orders and volume ahead of the order
+    */
+    QueuePosition position(size_t sequence) const noexcept;
+
+private:
+    struct Node
+    {
+        uint64_t Orders;
+        uint64_t Visible;
+        uint64_t Hidden;
+    };
+
+    std::vector<Node> _tree;
+    size_t _next;
+
+    void Add(size_t sequence, uint64_t orders, uint64_t visible, uint64_t hidden) noexcept;
+    void Subtract(size_t sequence, uint64_t orders, uint64_t visible, uint64_t hidden) noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "level_queue.inl"
+
+#endif // CPPTRADER_MATCHING_LEVEL_QUEUE_H
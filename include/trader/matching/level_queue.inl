@@ -0,0 +1,89 @@
+/*!
+    \file level_queue.inl
+    \brief Price level queue inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline void LevelQueue::reset(size_t capacity)
+{
+    _tree.assign(capacity, Node{ 0, 0, 0 });
+    _next = 0;
+}
+
+inline void LevelQueue::clear() noexcept
+{
+    _tree.clear();
+    _next = 0;
+}
+
+inline size_t LevelQueue::push(QuantityValue visible, QuantityValue hidden) noexcept
+{
+    assert(!full() && "Price level queue is out of sequence numbers!");
+
+    size_t sequence = _next++;
+    Add(sequence, 1, visible, hidden);
+    return sequence;
+}
+
+inline void LevelQueue::reduce(size_t sequence, QuantityValue visible, QuantityValue hidden) noexcept
+{
+    Subtract(sequence, 0, visible, hidden);
+}
+
+inline void LevelQueue::erase(size_t sequence, QuantityValue visible, QuantityValue hidden) noexcept
+{
+    Subtract(sequence, 1, visible, hidden);
+}
+
+inline QueuePosition LevelQueue::position(size_t sequence) const noexcept
+{
+    assert((sequence < _next) && "Invalid price level queue sequence number!");
+
+    // Sum up all orders with lower sequence numbers
+    uint64_t orders = 0;
+    uint64_t visible = 0;
+    uint64_t hidden = 0;
+    for (size_t i = sequence; i > 0; i &= i - 1)
+    {
+        const Node& node = _tree[i - 1];
+        orders += node.Orders;
+        visible += node.Visible;
+        hidden += node.Hidden;
+    }
+
+    QueuePosition result;
+    result.Position = (CountValue)orders;
+    result.VisibleVolume = (VolumeValue)visible;
+    result.HiddenVolume = (VolumeValue)hidden;
+    return result;
+}
+
+inline void LevelQueue::Add(size_t sequence, uint64_t orders, uint64_t visible, uint64_t hidden) noexcept
+{
+    for (size_t i = sequence + 1; i <= _tree.size(); i += i & (0 - i))
+    {
+        Node& node = _tree[i - 1];
+        node.Orders += orders;
+        node.Visible += visible;
+        node.Hidden += hidden;
+    }
+}
+
+inline void LevelQueue::Subtract(size_t sequence, uint64_t orders, uint64_t visible, uint64_t hidden) noexcept
+{
+    for (size_t i = sequence + 1; i <= _tree.size(); i += i & (0 - i))
+    {
+        Node& node = _tree[i - 1];
+        node.Orders -= orders;
+        node.Visible -= visible;
+        node.Hidden -= hidden;
+    }
+}
+
+} // namespace Matching
+} // namespace CppTrader
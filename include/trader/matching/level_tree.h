@@ -0,0 +1,113 @@
+/*!
+    \file level_tree.h
+    \brief Price level tree definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_LEVEL_TREE_H
+#define CPPTRADER_MATCHING_LEVEL_TREE_H
+
+#include "level.h"
+
+namespace CppTrader {
+namespace Matching {
+
+//! Price level tree
+/*!
+    Price level tree is a container of price levels for one side of the order
+    book based on the AVL tree. Price level lookup, insert and delete are
+    O(log n), the best price level is cached.
+
+    Not thread-safe.
+*/
+class LevelTree
+{
+public:
+    //! Price level tree container
+    typedef CppCommon::BinTreeAVL<LevelNode, std::less<LevelNode>> Tree;
+
+    // Standard container type definitions
+    typedef LevelNode value_type;
+    typedef Tree::iterator iterator;
+    typedef Tree::const_iterator const_iterator;
+
+    //! Initialize the price level tree
+    /*!
+        \param type - Price level type of the tree side
+        \param size - Unused
+        \param tick - Unused
+    */
+    explicit LevelTree(LevelType type, size_t size = 0, uint64_t tick = 1);
+    LevelTree(const LevelTree&) = delete;
+    LevelTree(LevelTree&&) = delete;
+    ~LevelTree() = default;
+
+    LevelTree& operator=(const LevelTree&) = delete;
+    LevelTree& operator=(LevelTree&&) = delete;
+
+    //! Check if the tree is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Is the tree empty?
+    bool empty() const noexcept { return _tree.empty(); }
+
+    //! Get the tree size
+    size_t size() const noexcept { return _tree.size(); }
+
+    //! Get the tree best price level
+    LevelNode* best() const noexcept { return _best; }
+    //! Get the tree lowest price level
+    LevelNode* lowest() const noexcept { return (LevelNode*)_tree.lowest(); }
+    //! Get the tree highest price level
+    LevelNode* highest() const noexcept { return (LevelNode*)_tree.highest(); }
+
+    //! Get the next price level with a higher price
+    LevelNode* higher(const LevelNode* level) const noexcept;
+    //! Get the next price level with a lower price
+    LevelNode* lower(const LevelNode* level) const noexcept;
+
+    //! Get the begin tree iterator
+    iterator begin() noexcept { return _tree.begin(); }
+    const_iterator begin() const noexcept { return _tree.begin(); }
+    //! Get the end tree iterator
+    iterator end() noexcept { return _tree.end(); }
+    const_iterator end() const noexcept { return _tree.end(); }
+
+    //! Find the price level with the given price
+    /*!
+        \param price - Price
+        \return Pointer to the price level with the given price or nullptr
+    */
+    LevelNode* find(PriceValue price) const noexcept;
+
+    //! Insert a new price level into the tree
+    /*!
+        \param level - Price level to insert
+    */
+    void insert(LevelNode& level);
+    //! Erase the price level from the tree
+    /*!
+        \param level - Price level to erase
+    */
+    void erase(LevelNode& level);
+
+    //! Clear the tree
+    void clear() noexcept;
+
+private:
+    // Tree side
+    LevelType _type;
+    LevelNode* _best;
+
+    // Tree price levels
+    Tree _tree;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "level_tree.inl"
+
+#endif // CPPTRADER_MATCHING_LEVEL_TREE_H
@@ -0,0 +1,65 @@
+/*!
+    \file level_tree.inl
+    \brief Price level tree inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline LevelTree::LevelTree(LevelType type, size_t, uint64_t)
+    : _type(type),
+      _best(nullptr)
+{
+}
+
+inline LevelNode* LevelTree::higher(const LevelNode* level) const noexcept
+{
+    Tree::const_iterator it(&_tree, level);
+    ++it;
+    return (LevelNode*)it.operator->();
+}
+
+inline LevelNode* LevelTree::lower(const LevelNode* level) const noexcept
+{
+    Tree::const_reverse_iterator it(&_tree, level);
+    ++it;
+    return (LevelNode*)it.operator->();
+}
+
+inline LevelNode* LevelTree::find(PriceValue price) const noexcept
+{
+    auto it = _tree.find(LevelNode(_type, price));
+    return (it != _tree.end()) ? (LevelNode*)it.operator->() : nullptr;
+}
+
+inline void LevelTree::insert(LevelNode& level)
+{
+    // Insert the price level into the tree
+    _tree.insert(level);
+
+    // Update the best price level by the tree type
+    if ((_best == nullptr) || ((_type == LevelType::BID) ? (level.Price > _best->Price) : (level.Price < _best->Price)))
+        _best = &level;
+}
+
+inline void LevelTree::erase(LevelNode& level)
+{
+    // Update the best price level by the tree type
+    if (&level == _best)
+        _best = (_type == LevelType::BID) ? lower(&level) : higher(&level);
+
+    // Erase the price level from the tree
+    _tree.erase(Tree::iterator(&_tree, &level));
+}
+
+inline void LevelTree::clear() noexcept
+{
+    _tree.clear();
+    _best = nullptr;
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,165 @@
+/*!
+    \file level_vector.h
+    \brief Price level vector definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_LEVEL_VECTOR_H
+#define CPPTRADER_MATCHING_LEVEL_VECTOR_H
+
+#include "level.h"
+
+#include <iterator>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Price level vector iterator
+/*!
+    Iterates price levels of the vector in ascending price order.
+*/
+template <typename T>
+class LevelVectorIterator
+{
+public:
+    // Standard iterator type definitions
+    typedef std::ptrdiff_t difference_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T* pointer;
+    typedef std::forward_iterator_tag iterator_category;
+
+    LevelVectorIterator() noexcept : _levels(nullptr), _index(0), _reverse(false) {}
+    LevelVectorIterator(const std::vector<LevelNode*>* levels, size_t index, bool reverse) noexcept : _levels(levels), _index(index), _reverse(reverse) {}
+    LevelVectorIterator(const LevelVectorIterator&) noexcept = default;
+    LevelVectorIterator(LevelVectorIterator&&) noexcept = default;
+    ~LevelVectorIterator() noexcept = default;
+
+    LevelVectorIterator& operator=(const LevelVectorIterator&) noexcept = default;
+    LevelVectorIterator& operator=(LevelVectorIterator&&) noexcept = default;
+
+    friend bool operator==(const LevelVectorIterator& it1, const LevelVectorIterator& it2) noexcept
+    { return it1._index == it2._index; }
+    friend bool operator!=(const LevelVectorIterator& it1, const LevelVectorIterator& it2) noexcept
+    { return it1._index != it2._index; }
+
+    LevelVectorIterator& operator++() noexcept { ++_index; return *this; }
+    LevelVectorIterator operator++(int) noexcept { LevelVectorIterator result(*this); ++_index; return result; }
+
+    reference operator*() const noexcept { return *operator->(); }
+    pointer operator->() const noexcept { return (*_levels)[_reverse ? (_levels->size() - _index - 1) : _index]; }
+
+private:
+    const std::vector<LevelNode*>* _levels;
+    size_t _index;
+    bool _reverse;
+};
+
+//! Price level vector
+/*!
+    Price level vector is a container of price levels for one side of the order
+    book based on the sorted vector with the best price level at the back. Most
+    of the market activity happens near the best price, so price level lookup,
+    insert and delete scan the vector from the back and touch only a few
+    contiguous elements.
+
+    Not thread-safe.
+*/
+class LevelVector
+{
+public:
+    // Standard container type definitions
+    typedef LevelNode value_type;
+    typedef LevelVectorIterator<LevelNode> iterator;
+    typedef LevelVectorIterator<const LevelNode> const_iterator;
+
+    //! Initialize the price level vector
+    /*!
+        \param type - Price level type of the vector side
+        \param size - Reserved price levels count (default is 0)
+        \param tick - Unused
+    */
+    explicit LevelVector(LevelType type, size_t size = 0, uint64_t tick = 1);
+    LevelVector(const LevelVector&) = delete;
+    LevelVector(LevelVector&&) = delete;
+    ~LevelVector() = default;
+
+    LevelVector& operator=(const LevelVector&) = delete;
+    LevelVector& operator=(LevelVector&&) = delete;
+
+    //! Check if the vector is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Is the vector empty?
+    bool empty() const noexcept { return _levels.empty(); }
+
+    //! Get the vector size
+    size_t size() const noexcept { return _levels.size(); }
+
+    //! Get the vector best price level
+    LevelNode* best() const noexcept { return _levels.empty() ? nullptr : _levels.back(); }
+    //! Get the vector lowest price level
+    LevelNode* lowest() const noexcept;
+    //! Get the vector highest price level
+    LevelNode* highest() const noexcept;
+
+    //! Get the next price level with a higher price
+    LevelNode* higher(const LevelNode* level) const noexcept;
+    //! Get the next price level with a lower price
+    LevelNode* lower(const LevelNode* level) const noexcept;
+
+    //! Get the begin vector iterator
+    iterator begin() noexcept { return iterator(&_levels, 0, !IsBid()); }
+    const_iterator begin() const noexcept { return const_iterator(&_levels, 0, !IsBid()); }
+    //! Get the end vector iterator
+    iterator end() noexcept { return iterator(&_levels, _levels.size(), !IsBid()); }
+    const_iterator end() const noexcept { return const_iterator(&_levels, _levels.size(), !IsBid()); }
+
+    //! Find the price level with the given price
+    /*!
+        \param price - Price
+        \return Pointer to the price level with the given price or nullptr
+    */
+    LevelNode* find(PriceValue price) const noexcept;
+
+    //! Insert a new price level into the vector
+    /*!
+        \param level - Price level to insert
+    */
+    void insert(LevelNode& level);
+    //! Erase the price level from the vector
+    /*!
+        \param level - Price level to erase
+    */
+    void erase(LevelNode& level);
+
+    //! Clear the vector
+    void clear() noexcept { _levels.clear(); }
+
+private:
+    // Vector side
+    LevelType _type;
+
+    // Vector price levels sorted from the worst to the best price
+    std::vector<LevelNode*> _levels;
+
+    bool IsBid() const noexcept { return _type == LevelType::BID; }
+    bool IsBetter(PriceValue price1, PriceValue price2) const noexcept { return IsBid() ? (price1 > price2) : (price1 < price2); }
+
+    // Find the position after the last price level not better than the given price
+    size_t GetPosition(PriceValue price) const noexcept;
+    // Get the next price level better than the given price
+    LevelNode* GetBetter(PriceValue price) const noexcept;
+    // Get the next price level worse than the given price
+    LevelNode* GetWorse(PriceValue price) const noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "level_vector.inl"
+
+#endif // CPPTRADER_MATCHING_LEVEL_VECTOR_H
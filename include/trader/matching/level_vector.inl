@@ -0,0 +1,95 @@
+/*!
+    \file level_vector.inl
+    \brief Price level vector inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline LevelVector::LevelVector(LevelType type, size_t size, uint64_t)
+    : _type(type)
+{
+    _levels.reserve(size);
+}
+
+inline size_t LevelVector::GetPosition(PriceValue price) const noexcept
+{
+    // Scan price levels from the best one at the back
+    size_t position = _levels.size();
+    while ((position > 0) && IsBetter(_levels[position - 1]->Price, price))
+        --position;
+    return position;
+}
+
+inline LevelNode* LevelVector::GetBetter(PriceValue price) const noexcept
+{
+    size_t position = GetPosition(price);
+    return (position < _levels.size()) ? _levels[position] : nullptr;
+}
+
+inline LevelNode* LevelVector::GetWorse(PriceValue price) const noexcept
+{
+    size_t position = GetPosition(price);
+
+    // Skip the price level with the same price
+    if ((position > 0) && (_levels[position - 1]->Price == price))
+        --position;
+
+    return (position > 0) ? _levels[position - 1] : nullptr;
+}
+
+inline LevelNode* LevelVector::lowest() const noexcept
+{
+    if (_levels.empty())
+        return nullptr;
+
+    return IsBid() ? _levels.front() : _levels.back();
+}
+
+inline LevelNode* LevelVector::highest() const noexcept
+{
+    if (_levels.empty())
+        return nullptr;
+
+    return IsBid() ? _levels.back() : _levels.front();
+}
+
+inline LevelNode* LevelVector::higher(const LevelNode* level) const noexcept
+{
+    return IsBid() ? GetBetter(level->Price) : GetWorse(level->Price);
+}
+
+inline LevelNode* LevelVector::lower(const LevelNode* level) const noexcept
+{
+    return IsBid() ? GetWorse(level->Price) : GetBetter(level->Price);
+}
+
+inline LevelNode* LevelVector::find(PriceValue price) const noexcept
+{
+    size_t position = GetPosition(price);
+    return ((position > 0) && (_levels[position - 1]->Price == price)) ? _levels[position - 1] : nullptr;
+}
+
+inline void LevelVector::insert(LevelNode& level)
+{
+    assert((find(level.Price) == nullptr) && "Price level with the same price already exists!");
+
+    _levels.insert(_levels.begin() + GetPosition(level.Price), &level);
+}
+
+inline void LevelVector::erase(LevelNode& level)
+{
+    size_t position = GetPosition(level.Price);
+
+    assert(((position > 0) && (_levels[position - 1] == &level)) && "Price level is not found in the vector!");
+    if ((position == 0) || (_levels[position - 1] != &level))
+        return;
+
+    _levels.erase(_levels.begin() + (position - 1));
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,199 @@
+/*!
+    \file market_gateway.h
+    \brief Market gateway definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_GATEWAY_H
+#define CPPTRADER_MATCHING_MARKET_GATEWAY_H
+
+#include "market_manager.h"
+
+#include "threads/thread.h"
+
+#include <atomic>
+#include <memory>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market command completion
+/*!
+    Market command completion is a slot owned by the session which receives
+    the result of the market command applied by the market gateway. The same
+    completion could be reused for the next command once it is done.
+*/
+struct MarketCompletion
+{
+    //! Command error code
+    ErrorCode Result;
+    //! Is the order still active after the command?
+    bool Active;
+    //! Order state after the command (valid only for active orders)
+    Order State;
+
+    MarketCompletion() noexcept : Result(ErrorCode::OK), Active(false), State(), _done(true) {}
+    MarketCompletion(const MarketCompletion&) = delete;
+    MarketCompletion(MarketCompletion&&) = delete;
+    ~MarketCompletion() noexcept = default;
+
+    MarketCompletion& operator=(const MarketCompletion&) = delete;
+    MarketCompletion& operator=(MarketCompletion&&) = delete;
+
+    //! Is the command done?
+    bool IsDone() const noexcept { return _done.load(std::memory_order_acquire); }
+
+    //! Wait for the command to be done
+    /*!
+        \return Command error code
+    */
+    ErrorCode Wait() const noexcept;
+
+private:
+    template <class TLevels>
+    friend class MarketGatewayT;
+
+    std::atomic<bool> _done;
+};
+
+//! Market gateway
+/*!
+    Market gateway is a lock-free multi-producer/single-consumer commands
+    queue in front of the market manager. Session threads submit AddOrder(),
+    ModifyOrder() and DeleteOrder() commands, and the market manager thread
+    applies them in batches with Process() method.
+
+    Commands are stored in the bounded ring. Each submitted command takes
+    one atomic increment of the ring tail and one release store of its slot
+    turn. Session threads wait while the ring is full. The market manager
+    thread never waits, it applies only already submitted commands.
+
+    Command result and the order state after the command are reported to
+    the optional completion slot provided with the command.
+
+    Thread-safe for any number of session threads submitting commands and
+    one market manager thread processing them.
+*/
+template <class TLevels>
+class MarketGatewayT
+{
+public:
+    //! Market manager
+    typedef MarketManagerT<TLevels> MarketManager;
+
+    //! Initialize the market gateway
+    /*!
+        \param market - Market manager to apply commands
+        \param capacity - Commands ring capacity, must be a power of two (default is 65536)
+        \param batch - Maximal count of commands applied by one Process() call (default is 256)
+    */
+    explicit MarketGatewayT(MarketManager& market, size_t capacity = 65536, size_t batch = 256);
+    MarketGatewayT(const MarketGatewayT&) = delete;
+    MarketGatewayT(MarketGatewayT&&) = delete;
+    ~MarketGatewayT() = default;
+
+    MarketGatewayT& operator=(const MarketGatewayT&) = delete;
+    MarketGatewayT& operator=(MarketGatewayT&&) = delete;
+
+    //! Get the market manager
+    MarketManager& market() noexcept { return _market; }
+
+    //! Get the commands ring capacity
+    size_t capacity() const noexcept { return _mask + 1; }
+    //! Get the commands batch size
+    size_t batch() const noexcept { return _batch; }
+
+    //! Get the count of submitted commands
+    uint64_t submitted() const noexcept { return _tail.load(std::memory_order_acquire); }
+    //! Get the count of applied commands
+    uint64_t applied() const noexcept { return _head.load(std::memory_order_acquire); }
+
+    //! Submit a new order
+    /*!
+        Order parameters are validated in the session thread.
+
+        \param order - Order to add
+        \param completion - Completion slot of the command (default is nullptr)
+        \return Error code of the order validation
+    */
+    ErrorCode AddOrder(const Order& order, MarketCompletion* completion = nullptr);
+    //! Submit the order modification
+    /*!
+        \param id - Order Id
+        \param new_price - Order price to modify
+        \param new_quantity - Order quantity to modify
+        \param completion - Completion slot of the command (default is nullptr)
+        \return Error code
+    */
+    ErrorCode ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity, MarketCompletion* completion = nullptr);
+    //! Submit the order deletion
+    /*!
+        \param id - Order Id
+        \param completion - Completion slot of the command (default is nullptr)
+        \return Error code
+    */
+    ErrorCode DeleteOrder(uint64_t id, MarketCompletion* completion = nullptr);
+
+    //! Apply the batch of submitted commands to the market manager
+    /*!
+        Must be called only from the market manager thread.
+
+        \return Count of applied commands
+    */
+    size_t Process();
+
+private:
+    enum class CommandType : uint8_t
+    {
+        ADD_ORDER,
+        MODIFY_ORDER,
+        DELETE_ORDER
+    };
+
+    struct Command
+    {
+        CommandType Type;
+        uint64_t Id;
+        uint64_t Price;
+        uint64_t Quantity;
+        Order OrderData;
+        MarketCompletion* Completion;
+
+        Command() noexcept : Type(CommandType::ADD_ORDER), Id(0), Price(0), Quantity(0), OrderData(), Completion(nullptr) {}
+    };
+
+    // Commands ring slot is free for the command with the sequence number equal
+    // to its turn and keeps the submitted command while its turn is one greater.
+    struct Slot
+    {
+        std::atomic<uint64_t> Turn;
+        Command Data;
+    };
+
+    MarketManager& _market;
+
+    // Commands ring
+    std::unique_ptr<Slot[]> _ring;
+    size_t _mask;
+    size_t _batch;
+
+    // Session threads position
+    alignas(64) std::atomic<uint64_t> _tail;
+    // Market manager thread position
+    alignas(64) std::atomic<uint64_t> _head;
+
+    void Submit(Command& command);
+    ErrorCode Apply(const Command& command);
+};
+
+//! Market gateway with the default price level container
+typedef MarketGatewayT<LevelLadder> MarketGateway;
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_gateway.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_GATEWAY_H
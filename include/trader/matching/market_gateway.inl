@@ -0,0 +1,40 @@
+/*!
+    \file market_gateway.inl
+    \brief Market gateway inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline ErrorCode MarketCompletion::Wait() const noexcept
+{
+    while (!IsDone())
+        CppCommon::Thread::Yield();
+
+    return Result;
+}
+
+template <class TLevels>
+inline void MarketGatewayT<TLevels>::Submit(Command& command)
+{
+    // Reset the completion slot before it is visible to the market manager thread
+    if (command.Completion != nullptr)
+        command.Completion->_done.store(false, std::memory_order_relaxed);
+
+    // Claim the commands ring slot with a single atomic increment
+    uint64_t tail = _tail.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = _ring[tail & _mask];
+
+    // Wait for the market manager thread while the commands ring is full
+    while (slot.Turn.load(std::memory_order_acquire) != tail)
+        CppCommon::Thread::Yield();
+
+    slot.Data = command;
+    slot.Turn.store(tail + 1, std::memory_order_release);
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -17,6 +17,11 @@
 namespace CppTrader {
 namespace Matching {
 
+template <class TLevels>
+class MarketManagerT;
+template <class TLevels>
+class ShardedMarketManagerT;
+
 //! Market handler class
 /*!
     Market handler is used to handle all market events from MarketManager
@@ -27,20 +32,28 @@ namespace Matching {
     \li Order executions
     \li Order book updates
 
+    Market handler is parametrized with the same price level container as
+    the corresponding market manager and order book.
+
     Not thread-safe.
 */
-class MarketHandler
+template <class TLevels>
+class MarketHandlerT
 {
-    friend class MarketManager;
+    friend class MarketManagerT<TLevels>;
+    friend class ShardedMarketManagerT<TLevels>;
 
 public:
-    MarketHandler() = default;
-    MarketHandler(const MarketHandler&) = delete;
-    MarketHandler(MarketHandler&&) = delete;
-    virtual ~MarketHandler() = default;
+    //! Order book
+    typedef OrderBookT<TLevels> OrderBook;
 
-    MarketHandler& operator=(const MarketHandler&) = delete;
-    MarketHandler& operator=(MarketHandler&&) = delete;
+    MarketHandlerT() = default;
+    MarketHandlerT(const MarketHandlerT&) = delete;
+    MarketHandlerT(MarketHandlerT&&) = delete;
+    virtual ~MarketHandlerT() = default;
+
+    MarketHandlerT& operator=(const MarketHandlerT&) = delete;
+    MarketHandlerT& operator=(MarketHandlerT&&) = delete;
 
 protected:
     // Symbol handlers
@@ -64,8 +77,12 @@ protected:
 
     // Order execution handlers
     virtual void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) {}
+    virtual void onExecuteSweep(const Order& order, const Fill* fills, size_t count) {}
 };
 
+//! Market handler with the default price level container
+typedef MarketHandlerT<LevelLadder> MarketHandler;
+
 } // namespace Matching
 } // namespace CppTrader
 
@@ -0,0 +1,336 @@
+/*!
+    \file market_handler_async.h
+    \brief Asynchronous market handler definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_HANDLER_ASYNC_H
+#define CPPTRADER_MATCHING_MARKET_HANDLER_ASYNC_H
+
+#include "market_handler.h"
+
+#include "threads/thread.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Asynchronous market handler overload policy
+enum class AsyncPolicy : uint8_t
+{
+    BLOCK,          //!< Wait for consumers while the events ring is full
+    DROP_OLDEST,    //!< Drop the oldest event while the events ring is full
+    CONFLATE        //!< Conflate order book and price level updates while the events ring is full
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, AsyncPolicy policy);
+
+//! Market event type
+enum class MarketEventType : uint8_t
+{
+    ADD_SYMBOL,
+    DELETE_SYMBOL,
+    ADD_ORDER_BOOK,
+    UPDATE_ORDER_BOOK,
+    DELETE_ORDER_BOOK,
+    ADD_LEVEL,
+    UPDATE_LEVEL,
+    DELETE_LEVEL,
+    ADD_ORDER,
+    UPDATE_ORDER,
+    DELETE_ORDER,
+    EXECUTE_ORDER
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, MarketEventType type);
+
+//! Market event order book data
+struct MarketEventOrderBook
+{
+    //! Best bid price
+    PriceValue BidPrice;
+    //! Best bid visible volume
+    VolumeValue BidVolume;
+    //! Best ask price
+    PriceValue AskPrice;
+    //! Best ask visible volume
+    VolumeValue AskVolume;
+};
+
+//! Market event price level data
+struct MarketEventLevel
+{
+    //! Level price
+    PriceValue Price;
+    //! Level volume
+    VolumeValue TotalVolume;
+    //! Level hidden volume
+    VolumeValue HiddenVolume;
+    //! Level visible volume
+    VolumeValue VisibleVolume;
+    //! Level orders
+    CountValue Orders;
+    //! Level type
+    LevelType Type;
+};
+
+//! Market event order data
+struct MarketEventOrder
+{
+    //! Order Id
+    OrderIdValue Id;
+    //! Order price
+    PriceValue Price;
+    //! Order quantity
+    QuantityValue Quantity;
+    //! Order executed quantity
+    QuantityValue ExecutedQuantity;
+    //! Order leaves quantity
+    QuantityValue LeavesQuantity;
+    //! Order type
+    OrderType Type;
+    //! Order side
+    OrderSide Side;
+};
+
+//! Market event execution data
+struct MarketEventExecution
+{
+    //! Executed order Id
+    OrderIdValue Id;
+    //! Execution price
+    PriceValue Price;
+    //! Execution quantity
+    QuantityValue Quantity;
+    //! Executed order leaves quantity before the execution (zero for sweep fills)
+    QuantityValue LeavesQuantity;
+    //! Aggressive order Id of the sweep (zero for single executions)
+    OrderIdValue AggressorId;
+};
+
+//! Market event
+/*!
+    Market event is a compact binary record of the market handler event.
+    Order books and orders are not copied, the event keeps only their
+    fields which are interesting for market data consumers.
+*/
+struct MarketEvent
+{
+    //! Market event type
+    MarketEventType Type;
+    //! Is the top of the order book changed? (order book and price level events)
+    bool Top;
+    //! Symbol Id
+    uint32_t SymbolId;
+    union
+    {
+        //! Symbol name (symbol events)
+        char SymbolName[8];
+        //! Order book data (order book events)
+        MarketEventOrderBook OrderBookData;
+        //! Price level data (price level events)
+        MarketEventLevel LevelData;
+        //! Order data (order events)
+        MarketEventOrder OrderData;
+        //! Execution data (execution events)
+        MarketEventExecution ExecutionData;
+    };
+
+    MarketEvent() noexcept : Type(MarketEventType::ADD_SYMBOL), Top(false), SymbolId(0), OrderData() {}
+    MarketEvent(const MarketEvent&) noexcept = default;
+    MarketEvent(MarketEvent&&) noexcept = default;
+    ~MarketEvent() noexcept = default;
+
+    MarketEvent& operator=(const MarketEvent&) noexcept = default;
+    MarketEvent& operator=(MarketEvent&&) noexcept = default;
+
+    template <class TOutputStream>
+    friend TOutputStream& operator<<(TOutputStream& stream, const MarketEvent& event);
+
+    //! Is the market event conflatable?
+    /*!
+        Order book and price level updates describe the latest state, so
+        the later update of the same order book or price level could replace
+        the earlier one.
+    */
+    bool IsConflatable() const noexcept { return (Type == MarketEventType::UPDATE_ORDER_BOOK) || (Type == MarketEventType::UPDATE_LEVEL); }
+    //! Is the market event conflatable with the given one?
+    bool IsConflatable(const MarketEvent& event) const noexcept;
+};
+
+//! Asynchronous market handler
+/*!
+    Asynchronous market handler decouples market data consumers from the
+    matching path. Market manager events are serialized into compact market
+    event records stored in the preallocated events ring. Consumer threads
+    drain the events ring and call onMarketEvent() handler, so slow consumers
+    do not stall the market manager.
+
+    Overload policy defines what happens when the events ring is full:
+    \li BLOCK - market manager waits for consumers, no events are lost
+    \li DROP_OLDEST - the oldest event in the events ring is dropped
+    \li CONFLATE - order book and price level updates are conflated with
+        earlier updates of the same order book or price level waiting for
+        the free space, other events wait for consumers
+
+    Conflated updates are published before any later event, so they could
+    be reordered only between each other. Each dropped or conflated event is
+    counted in lost() counter.
+
+    Events are numbered in the order of publishing. With several consumer
+    threads onMarketEvent() handler is called concurrently and events could
+    be handled out of order, consumers should use event sequence numbers to
+    restore the order if required.
+
+    Consumer threads must be started before the events ring is full,
+    otherwise BLOCK policy and CONFLATE policy for other events wait forever.
+
+    Thread-safe for one market manager thread and any number of consumer
+    threads. Start(), Stop() and Flush() must be called from the market
+    manager thread.
+*/
+template <class TLevels>
+class AsyncMarketHandlerT : public MarketHandlerT<TLevels>
+{
+public:
+    //! Order book
+    typedef OrderBookT<TLevels> OrderBook;
+
+    //! Initialize the asynchronous market handler
+    /*!
+        \param capacity - Events ring capacity, must be a power of two (default is 65536)
+        \param policy - Overload policy (default is AsyncPolicy::BLOCK)
+    */
+    explicit AsyncMarketHandlerT(size_t capacity = 65536, AsyncPolicy policy = AsyncPolicy::BLOCK);
+    AsyncMarketHandlerT(const AsyncMarketHandlerT&) = delete;
+    AsyncMarketHandlerT(AsyncMarketHandlerT&&) = delete;
+    virtual ~AsyncMarketHandlerT();
+
+    AsyncMarketHandlerT& operator=(const AsyncMarketHandlerT&) = delete;
+    AsyncMarketHandlerT& operator=(AsyncMarketHandlerT&&) = delete;
+
+    //! Get the events ring capacity
+    size_t capacity() const noexcept { return _mask + 1; }
+    //! Get the overload policy
+    AsyncPolicy policy() const noexcept { return _policy; }
+
+    //! Get the count of events published into the events ring
+    uint64_t published() const noexcept { return _tail.load(std::memory_order_acquire); }
+    //! Get the count of events handled by consumers
+    uint64_t consumed() const noexcept { return _consumed.load(std::memory_order_acquire); }
+    //! Get the count of events lost under overload
+    uint64_t lost() const noexcept { return _lost.load(std::memory_order_acquire); }
+
+    //! Is the asynchronous market handler started?
+    bool IsStarted() const noexcept { return _started; }
+
+    //! Start consumer threads
+    /*!
+        \param consumers - Consumer threads count (default is 1)
+        \return 'true' if consumer threads were successfully started, 'false' if they are already started
+    */
+    bool Start(size_t consumers = 1);
+    //! Flush and stop consumer threads
+    /*!
+        \return 'true' if consumer threads were successfully stopped, 'false' if they are already stopped
+    */
+    bool Stop();
+
+    //! Wait for consumers to handle all published and conflated events
+    void Flush();
+
+protected:
+    //! Market event handler
+    /*!
+        Called in consumer threads.
+
+        \param sequence - Market event sequence number
+        \param event - Market event
+    */
+    virtual void onMarketEvent(uint64_t sequence, const MarketEvent& event) {}
+
+    // Symbol handlers
+    void onAddSymbol(const Symbol& symbol) override;
+    void onDeleteSymbol(const Symbol& symbol) override;
+
+    // Order book handlers
+    void onAddOrderBook(const OrderBook& order_book) override;
+    void onUpdateOrderBook(const OrderBook& order_book, bool top, int symbol_id) override;
+    void onDeleteOrderBook(const OrderBook& order_book) override;
+
+    // Price level handlers
+    void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override;
+    void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override;
+    void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override;
+
+    // Order handlers
+    void onAddOrder(const Order& order) override;
+    void onUpdateOrder(const Order& order) override;
+    void onDeleteOrder(const Order& order) override;
+
+    // Order execution handlers
+    void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override;
+    void onExecuteSweep(const Order& order, const Fill* fills, size_t count) override;
+
+private:
+    static_assert(sizeof(MarketEvent) <= 56, "Market event must fit into the cache line with its slot turn!");
+
+    // Events ring slot is free for the event with the sequence number equal to
+    // its turn and keeps the published event while its turn is one greater.
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> Turn;
+        MarketEvent Event;
+    };
+
+    AsyncPolicy _policy;
+
+    // Events ring
+    std::unique_ptr<Slot[]> _ring;
+    size_t _mask;
+
+    // Market manager thread position
+    alignas(64) std::atomic<uint64_t> _tail;
+    std::atomic<uint64_t> _lost;
+    uint64_t _dropped;
+    std::vector<MarketEvent> _conflated;
+    // Consumer threads position
+    alignas(64) std::atomic<uint64_t> _head;
+    alignas(64) std::atomic<uint64_t> _consumed;
+
+    // Consumer threads
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _running;
+    bool _started;
+
+    void Publish(const MarketEvent& event);
+    bool TryPublish(const MarketEvent& event) noexcept;
+    bool TryPublishConflated();
+    void Conflate(const MarketEvent& event);
+    void Lose() noexcept;
+
+    bool TryConsume(uint64_t& sequence, MarketEvent& event) noexcept;
+    void Run();
+
+    void PublishOrderBook(MarketEventType type, const OrderBook& order_book, bool top);
+    void PublishLevel(MarketEventType type, const OrderBook& order_book, const Level& level, bool top);
+    void PublishOrder(MarketEventType type, const Order& order);
+};
+
+//! Asynchronous market handler with the default price level container
+typedef AsyncMarketHandlerT<LevelLadder> AsyncMarketHandler;
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_handler_async.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_HANDLER_ASYNC_H
@@ -0,0 +1,172 @@
+/*!
+    \file market_handler_async.inl
+    \brief Asynchronous market handler inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, AsyncPolicy policy)
+{
+    switch (policy)
+    {
+        case AsyncPolicy::BLOCK:
+            stream << "BLOCK";
+            break;
+        case AsyncPolicy::DROP_OLDEST:
+            stream << "DROP_OLDEST";
+            break;
+        case AsyncPolicy::CONFLATE:
+            stream << "CONFLATE";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, MarketEventType type)
+{
+    switch (type)
+    {
+        case MarketEventType::ADD_SYMBOL:
+            stream << "ADD_SYMBOL";
+            break;
+        case MarketEventType::DELETE_SYMBOL:
+            stream << "DELETE_SYMBOL";
+            break;
+        case MarketEventType::ADD_ORDER_BOOK:
+            stream << "ADD_ORDER_BOOK";
+            break;
+        case MarketEventType::UPDATE_ORDER_BOOK:
+            stream << "UPDATE_ORDER_BOOK";
+            break;
+        case MarketEventType::DELETE_ORDER_BOOK:
+            stream << "DELETE_ORDER_BOOK";
+            break;
+        case MarketEventType::ADD_LEVEL:
+            stream << "ADD_LEVEL";
+            break;
+        case MarketEventType::UPDATE_LEVEL:
+            stream << "UPDATE_LEVEL";
+            break;
+        case MarketEventType::DELETE_LEVEL:
+            stream << "DELETE_LEVEL";
+            break;
+        case MarketEventType::ADD_ORDER:
+            stream << "ADD_ORDER";
+            break;
+        case MarketEventType::UPDATE_ORDER:
+            stream << "UPDATE_ORDER";
+            break;
+        case MarketEventType::DELETE_ORDER:
+            stream << "DELETE_ORDER";
+            break;
+        case MarketEventType::EXECUTE_ORDER:
+            stream << "EXECUTE_ORDER";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, const MarketEvent& event)
+{
+    stream << "MarketEvent(Type=" << event.Type
+        << "; SymbolId=" << event.SymbolId;
+    switch (event.Type)
+    {
+        case MarketEventType::ADD_ORDER_BOOK:
+        case MarketEventType::UPDATE_ORDER_BOOK:
+        case MarketEventType::DELETE_ORDER_BOOK:
+            stream << "; Top=" << (event.Top ? "Yes" : "No")
+                << "; BidPrice=" << event.OrderBookData.BidPrice
+                << "; BidVolume=" << event.OrderBookData.BidVolume
+                << "; AskPrice=" << event.OrderBookData.AskPrice
+                << "; AskVolume=" << event.OrderBookData.AskVolume;
+            break;
+        case MarketEventType::ADD_LEVEL:
+        case MarketEventType::UPDATE_LEVEL:
+        case MarketEventType::DELETE_LEVEL:
+            stream << "; Top=" << (event.Top ? "Yes" : "No")
+                << "; LevelType=" << event.LevelData.Type
+                << "; Price=" << event.LevelData.Price
+                << "; TotalVolume=" << event.LevelData.TotalVolume
+                << "; HiddenVolume=" << event.LevelData.HiddenVolume
+                << "; VisibleVolume=" << event.LevelData.VisibleVolume
+                << "; Orders=" << event.LevelData.Orders;
+            break;
+        case MarketEventType::ADD_ORDER:
+        case MarketEventType::UPDATE_ORDER:
+        case MarketEventType::DELETE_ORDER:
+            stream << "; Id=" << event.OrderData.Id
+                << "; OrderType=" << event.OrderData.Type
+                << "; Side=" << event.OrderData.Side
+                << "; Price=" << event.OrderData.Price
+                << "; Quantity=" << event.OrderData.Quantity
+                << "; ExecutedQuantity=" << event.OrderData.ExecutedQuantity
+                << "; LeavesQuantity=" << event.OrderData.LeavesQuantity;
+            break;
+        case MarketEventType::EXECUTE_ORDER:
+            stream << "; Id=" << event.ExecutionData.Id
+                << "; Price=" << event.ExecutionData.Price
+                << "; Quantity=" << event.ExecutionData.Quantity
+                << "; LeavesQuantity=" << event.ExecutionData.LeavesQuantity
+                << "; AggressorId=" << event.ExecutionData.AggressorId;
+            break;
+        default:
+            break;
+    }
+    stream << ")";
+    return stream;
+}
+
+inline bool MarketEvent::IsConflatable(const MarketEvent& event) const noexcept
+{
+    if ((Type != event.Type) || (SymbolId != event.SymbolId))
+        return false;
+
+    switch (Type)
+    {
+        case MarketEventType::UPDATE_ORDER_BOOK:
+            return true;
+        case MarketEventType::UPDATE_LEVEL:
+            return (LevelData.Type == event.LevelData.Type) && (LevelData.Price == event.LevelData.Price);
+        default:
+            return false;
+    }
+}
+
+template <class TLevels>
+inline bool AsyncMarketHandlerT<TLevels>::TryPublish(const MarketEvent& event) noexcept
+{
+    uint64_t tail = _tail.load(std::memory_order_relaxed);
+    Slot& slot = _ring[tail & _mask];
+
+    // Slot is still occupied by the unconsumed event
+    if (slot.Turn.load(std::memory_order_acquire) != tail)
+        return false;
+
+    slot.Event = event;
+    slot.Turn.store(tail + 1, std::memory_order_release);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template <class TLevels>
+inline void AsyncMarketHandlerT<TLevels>::Lose() noexcept
+{
+    _lost.store(_lost.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+} // namespace Matching
+} // namespace CppTrader
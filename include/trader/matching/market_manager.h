@@ -11,6 +11,7 @@
 
 #include "fast_hash.h"
 #include "market_handler.h"
+#include "order_index.h"
 
 #include "containers/hashmap.h"
 #include "memory/allocator_pool.h"
@@ -33,28 +34,44 @@ namespace Matching {
     Automatic orders matching can be enabled with EnableMatching() method or can be
     manually performed with Match() method.
 
+    Aggressive orders with the owner Id and the self-trade prevention mode never
+    match resting orders of the same owner. Each price level keeps a filter of its
+    owners, so price levels without orders of the owner are matched without
+    checking each order. 'Fill-Or-Kill' and 'All-Or-None' aggressive orders skip
+    resting orders of the same owner and cancel them if the mode cancels resting
+    orders.
+
+    Market manager is parametrized with the price level container used by all
+    its order books (LevelTree, LevelVector or LevelLadder). Market events are
+    reported to the market handler with the same price level container.
+
     Not thread-safe.
 */
-class MarketManager
+template <class TLevels>
+class MarketManagerT
 {
-    friend class OrderBook;
+    friend class OrderBookT<TLevels>;
 
 public:
+    //! Market handler
+    typedef MarketHandlerT<TLevels> MarketHandler;
+    //! Order book
+    typedef OrderBookT<TLevels> OrderBook;
     //! Symbols container
     typedef std::vector<Symbol*> Symbols;
     //! Order books container
     typedef std::vector<OrderBook*> OrderBooks;
     //! Orders container
-    typedef CppCommon::HashMap<uint64_t, OrderNode*, FastHash> Orders;
+    typedef OrderIndex Orders;
 
-    MarketManager();
-    MarketManager(MarketHandler& market_handler);
-    MarketManager(const MarketManager&) = delete;
-    MarketManager(MarketManager&&) = delete;
-    ~MarketManager();
+    MarketManagerT();
+    MarketManagerT(MarketHandler& market_handler);
+    MarketManagerT(const MarketManagerT&) = delete;
+    MarketManagerT(MarketManagerT&&) = delete;
+    ~MarketManagerT();
 
-    MarketManager& operator=(const MarketManager&) = delete;
-    MarketManager& operator=(MarketManager&&) = delete;
+    MarketManagerT& operator=(const MarketManagerT&) = delete;
+    MarketManagerT& operator=(MarketManagerT&&) = delete;
 
     //! Get the symbols container
     const Symbols& symbols() const noexcept { return _symbols; }
@@ -77,10 +94,26 @@ public:
     const OrderBook* GetOrderBook(uint32_t id) const noexcept;
     //! Get the order with the given Id
     /*!
+        Stop price (and price of the stop-limit order) of the tracking trailing
+        stop order is resolved from the trailing reference price of its order
+        book before the order is returned.
+
         \param id - Order Id
         \return Pointer to the order with the given Id or nullptr
     */
     const Order* GetOrder(uint64_t id) const noexcept;
+    //! Get the queue position of the limit order with the given Id
+    /*!
+        Queue position is the count of orders and the visible and hidden volume
+        ahead of the order at its price level. Hidden orders are queued behind
+        all displayed orders of the price level. Price level queues are built on
+        the first request and then maintained incrementally.
+
+        \param id - Order Id
+        \param position - Order queue position
+        \return Error code
+    */
+    ErrorCode GetQueuePosition(uint64_t id, QueuePosition& position);
 
     //! Add a new symbol
     /*!
@@ -97,16 +130,72 @@ public:
 
     //! Add a new order book
     /*!
+        Price level containers of the order book are created with the given size
+        and price tick. LevelLadder uses them as the ladder window size in price
+        ticks and the price tick, LevelVector reserves the given size, LevelTree
+        ignores them.
+
         \param symbol - Symbol of the order book to add
+        \param size - Price level container size (default is 0)
+        \param tick - Price level container price tick (default is 1)
         \return Error code
     */
-    ErrorCode AddOrderBook(const Symbol& symbol);
+    ErrorCode AddOrderBook(const Symbol& symbol, size_t size = 0, uint64_t tick = 1);
     //! Delete the order book
     /*!
+        Orders of the order book are erased and released without notifications.
+
         \param id - Symbol Id of the order book
         \return Error code
     */
     ErrorCode DeleteOrderBook(uint32_t id);
+    //! Set the top of the book depth cache capacity of the order book
+    /*!
+        Order book keeps copies of the given count of the top bid and ask price
+        levels in contiguous depth caches updated in place on every price level
+        change (see OrderBook::bid_depth() and OrderBook::ask_depth()).
+
+        \param id - Symbol Id of the order book
+        \param depth - Count of cached price levels on each side (0 to disable)
+        \return Error code
+    */
+    ErrorCode SetOrderBookDepth(uint32_t id, size_t depth);
+    //! Set the allocation policy of the order book
+    /*!
+        Allocation policy defines how an aggressive order is allocated among
+        resting orders of a matched price level. Pro-rata policies allocate
+        the execution in one pass over the displayed orders of the price level
+        proportionally to their visible quantity ('iceberg' orders take part
+        with their displayed slices) and give the rounding remainder in the
+        time priority. Resting orders of the owner of a self-trade preventing
+        order are left out of its allocation. Price levels which displayed
+        slices of other owners are taken entirely and price levels with
+        'All-Or-None' orders are always executed in the price-time priority.
+        Order books are created with the FIFO allocation policy.
+
+        Allocation policy is a runtime property of the order book, so FIFO
+        order books pay one branch on the policy per matched price level.
+        Pro-rata policies additionally walk displayed orders of the price
+        level to leave out the aggressive order owner when the price level
+        owners filter reports it.
+
+        \param id - Symbol Id of the order book
+        \param allocation - Allocation policy
+        \return Error code
+    */
+    ErrorCode SetOrderBookAllocation(uint32_t id, AllocationType allocation);
+    //! Set the top of the book publishing of the order book
+    /*!
+        Published top of the book is updated after each price level update of
+        the order book and could be read by other threads without locks (see
+        OrderBook::top_of_book()). Readers must stop using it before publishing
+        is disabled or the order book is deleted.
+
+        \param id - Symbol Id of the order book
+        \param publish - Publish the top of the book
+        \return Error code
+    */
+    ErrorCode SetOrderBookTopOfBook(uint32_t id, bool publish);
 
     //! Add a new order
     /*!
@@ -114,6 +203,16 @@ public:
         \return Error code
     */
     ErrorCode AddOrder(const Order& order);
+    //! Add a new order and get its handle
+    /*!
+        Order handle is empty if the order was not added to the order book
+        (e.g. market order or limit order filled completely on arrival).
+
+        \param order - Order to add
+        \param handle - Order handle of the added order
+        \return Error code
+    */
+    ErrorCode AddOrder(const Order& order, OrderHandle& handle);
     //! Reduce the order by the given quantity
     /*!
         \param id - Order Id
@@ -121,6 +220,13 @@ public:
         \return Error code
     */
     ErrorCode ReduceOrder(uint64_t id, uint64_t quantity);
+    //! Reduce the order by the given quantity using its handle
+    /*!
+        \param handle - Order handle
+        \param quantity - Order quantity to reduce
+        \return Error code
+    */
+    ErrorCode ReduceOrder(OrderHandle handle, uint64_t quantity);
     //! Modify the order
     /*!
         Order new quantity will be calculated in a following way:
@@ -135,6 +241,14 @@ public:
         \return Error code
     */
     ErrorCode ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity);
+    //! Modify the order using its handle
+    /*!
+        \param handle - Order handle
+        \param new_price - Order price to modify
+        \param new_quantity - Order quantity to modify
+        \return Error code
+    */
+    ErrorCode ModifyOrder(OrderHandle handle, uint64_t new_price, uint64_t new_quantity);
     //! Mitigate the order
     /*!
         The in-flight mitigation functionality prevents an order from being filled
@@ -167,6 +281,14 @@ public:
         \return Error code
     */
     ErrorCode MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity);
+    //! Mitigate the order using its handle
+    /*!
+        \param handle - Order handle
+        \param new_price - Order price to mitigate
+        \param new_quantity - Order quantity to mitigate
+        \return Error code
+    */
+    ErrorCode MitigateOrder(OrderHandle handle, uint64_t new_price, uint64_t new_quantity);
     //! Replace the order with a similar order but different Id, price and quantity
     /*!
         \param id - Order Id
@@ -176,6 +298,19 @@ public:
         \return Error code
     */
     ErrorCode ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity);
+    //! Replace the order using its handle with a similar order but different Id, price and quantity
+    /*!
+        Order handle is updated to the replaced order. It is empty if the
+        replaced order was not added to the order book (e.g. filled completely
+        on arrival).
+
+        \param handle - Order handle
+        \param new_id - Order Id to replace
+        \param new_price - Order price to replace
+        \param new_quantity - Order quantity to replace
+        \return Error code
+    */
+    ErrorCode ReplaceOrder(OrderHandle& handle, uint64_t new_id, uint64_t new_price, uint64_t new_quantity);
     //! Replace the order with a new one
     /*!
         \param id - Order Id
@@ -183,12 +318,27 @@ public:
         \return Error code
     */
     ErrorCode ReplaceOrder(uint64_t id, const Order& new_order);
+    //! Replace the order using its handle with a new one
+    /*!
+        Order handle is updated to the new order.
+
+        \param handle - Order handle
+        \param new_order - Order to replace
+        \return Error code
+    */
+    ErrorCode ReplaceOrder(OrderHandle& handle, const Order& new_order);
     //! Delete the order
     /*!
         \param id - Order Id
         \return Error code
     */
     ErrorCode DeleteOrder(uint64_t id);
+    //! Delete the order using its handle
+    /*!
+        \param handle - Order handle
+        \return Error code
+    */
+    ErrorCode DeleteOrder(OrderHandle handle);
 
     //! Execute the order
     /*!
@@ -205,6 +355,21 @@ public:
         \return Error code
     */
     ErrorCode ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity);
+    //! Execute the order using its handle
+    /*!
+        \param handle - Order handle
+        \param quantity - Order executed quantity
+        \return Error code
+    */
+    ErrorCode ExecuteOrder(OrderHandle handle, uint64_t quantity);
+    //! Execute the order using its handle
+    /*!
+        \param handle - Order handle
+        \param price - Order executed price
+        \param quantity - Order executed quantity
+        \return Error code
+    */
+    ErrorCode ExecuteOrder(OrderHandle handle, uint64_t price, uint64_t quantity);
 
     //! Is automatic matching enabled?
     bool IsMatchingEnabled() const noexcept { return _matching; }
@@ -213,6 +378,37 @@ public:
     //! Disable automatic matching
     void DisableMatching() { _matching = false; }
 
+    //! Are batched sweep executions enabled?
+    bool IsSweepExecutionsEnabled() const noexcept { return _sweeps; }
+    //! Enable batched sweep executions
+    /*!
+        Aggressive order matched against resting orders produces a single
+        onExecuteSweep() notification with the contiguous array of resting
+        order fills instead of a pair of onExecuteOrder() notifications per
+        fill. Price level notifications of the sweep are consolidated into
+        one notification per touched price level followed by a single
+        onUpdateOrderBook() notification. Resting order update and delete
+        notifications as well as price level notifications are emitted
+        after onExecuteSweep() notification once the sweep is completed.
+    */
+    void EnableSweepExecutions() { _sweeps = true; }
+    //! Disable batched sweep executions
+    void DisableSweepExecutions() { _sweeps = false; }
+
+    //! Are order book memory arenas enabled?
+    bool IsOrderBookArenasEnabled() const noexcept { return _arena_chunk > 0; }
+    //! Enable memory arenas for new order books
+    /*!
+        Order book with the memory arena allocates its order and price level
+        nodes from its own chunks and releases them wholesale when the order
+        book is deleted. Orders of the deleted order book are erased.
+
+        \param chunk - Memory arena chunk size in bytes (default is 16384)
+    */
+    void EnableOrderBookArenas(size_t chunk = 16384) { _arena_chunk = chunk; }
+    //! Disable memory arenas for new order books
+    void DisableOrderBookArenas() { _arena_chunk = 0; }
+
     //! Match crossed orders in all order books
     /*!
         Method will match all crossed orders in each order book. Buy orders will be
@@ -223,6 +419,39 @@ public:
     */
     void Match();
 
+    //! Calculate the call auction equilibrium price of the order book
+    /*!
+        Equilibrium price is the price level price which maximizes the volume
+        executable between crossed bid and ask orders. Ties are resolved by the
+        minimal volume imbalance and then towards the side with the surplus:
+        the highest price for the buy surplus and the lowest price otherwise.
+        'All-Or-None' orders do not participate in the call auction.
+
+        \param id - Symbol Id of the order book
+        \param price - Equilibrium price
+        \param volume - Executable volume (0 if the order book is not crossed)
+        \return Error code
+    */
+    ErrorCode GetAuctionPrice(uint32_t id, uint64_t& price, uint64_t& volume) const;
+
+    //! Uncross all order books in the call auction
+    /*!
+        Method will execute crossed orders of each order book in bulk at its
+        single equilibrium price. Orders are collected without matching while
+        automatic matching is disabled, e.g. during the opening auction or the
+        trading halt, and should be uncrossed before matching is enabled again.
+        Executed orders are reduced or deleted in the price-time priority with
+        the usual market handler notifications. Stop orders triggered by the
+        equilibrium price are activated after the uncross.
+    */
+    void Uncross();
+    //! Uncross the order book in the call auction
+    /*!
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode UncrossOrderBook(uint32_t id);
+
 private:
     // Market handler
     static MarketHandler _default;
@@ -249,15 +478,30 @@ private:
     CppCommon::PoolMemoryManager<CppCommon::DefaultMemoryManager> _order_memory_manager;
     CppCommon::PoolAllocator<OrderNode, CppCommon::DefaultMemoryManager> _order_pool;
     Orders _orders;
-
-    ErrorCode AddMarketOrder(const Order& order, bool recursive);
-    ErrorCode AddLimitOrder(const Order& order, bool recursive);
-    ErrorCode AddStopOrder(const Order& order, bool recursive);
-    ErrorCode AddStopLimitOrder(const Order& order, bool recursive);
-    ErrorCode ReduceOrder(uint64_t id, uint64_t quantity, bool recursive);
-    ErrorCode ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity, bool mitigate, bool recursive);
-    ErrorCode ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity, bool recursive);
-    ErrorCode DeleteOrder(uint64_t id, bool recursive);
+    // Order node of the order handle in progress, cleared when the order node is released
+    OrderNode* _handle_order;
+
+    // Order book memory arenas chunk size
+    size_t _arena_chunk;
+
+    ErrorCode FindOrder(uint64_t id, OrderNode*& order_ptr);
+    void EraseOrders(OrderBook* order_book_ptr, const TLevels& levels);
+    void EraseOrders(OrderBook* order_book_ptr, OrderNode* order_ptr);
+
+    void ReleaseOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
+
+    ErrorCode AddOrder(const Order& order, OrderNode*& node_ptr);
+    ErrorCode AddMarketOrder(const Order& order, bool recursive, OrderNode*& node_ptr);
+    ErrorCode AddLimitOrder(const Order& order, bool recursive, OrderNode*& node_ptr);
+    ErrorCode AddStopOrder(const Order& order, bool recursive, OrderNode*& node_ptr);
+    ErrorCode AddStopLimitOrder(const Order& order, bool recursive, OrderNode*& node_ptr);
+    ErrorCode ReduceOrder(OrderNode* order_ptr, QuantityValue quantity, bool executed, bool recursive);
+    ErrorCode ModifyOrder(OrderNode* order_ptr, PriceValue new_price, QuantityValue new_quantity, bool mitigate, bool recursive);
+    ErrorCode ReplaceOrder(OrderNode* order_ptr, OrderIdValue new_id, PriceValue new_price, QuantityValue new_quantity, bool recursive);
+    ErrorCode DeleteOrder(OrderNode* order_ptr, bool recursive);
+    ErrorCode ExecuteOrder(OrderNode* order_ptr, PriceValue price, QuantityValue quantity, bool recursive);
+    static void ExecuteSlice(OrderNode* order_ptr, QuantityValue quantity) noexcept;
+    static OrderNode* NextExecutingOrder(OrderNode* order_ptr, OrderNode* next_order_ptr, QuantityValue quantity) noexcept;
 
     // Matching
     bool _matching;
@@ -267,19 +511,63 @@ private:
     void MatchLimit(OrderBook* order_book_ptr, Order* order_ptr);
     void MatchOrder(OrderBook* order_book_ptr, Order* order_ptr);
 
+    // Stop orders activation
+    std::vector<OrderNode*> _activating_orders;
+
     bool ActivateStopOrders(OrderBook* order_book_ptr);
-    bool ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t stop_price);
+    bool ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* stop_level_ptr, LevelNode* trailing_level_ptr, LevelNode* offset_level_ptr, PriceValue stop_price);
     bool ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
     bool ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
 
-    uint64_t CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume);
+    uint64_t CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, const Order* order_ptr, PriceValue price, uint64_t volume, OrderNode*& self_trade_order_ptr);
     uint64_t CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* bid_level_ptr, LevelNode* ask_level_ptr);
-    void ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume);
-    void RecalculateTrailingStopPrice(OrderBook* order_book_ptr, LevelNode* level_ptr);
+    static bool TakeMatchingOrders(OrderNode* resting_order_ptr, const Order* order_ptr, bool self_trade, uint64_t volume, uint64_t& available, uint64_t& reserve, OrderNode*& self_trade_order_ptr) noexcept;
+    void ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, Order* order_ptr, PriceValue price, uint64_t volume);
 
-    void UpdateLevel(const OrderBook& order_book, const LevelUpdate& update, int symbol_id=0) const;
+    // Self-trade prevention
+    static bool IsSelfTradeLevel(LevelNode* level_ptr, const Order* order_ptr) noexcept;
+    bool PreventSelfTrade(OrderNode* resting_order_ptr, Order* order_ptr);
+
+    // Pro-rata allocation
+    std::vector<std::pair<OrderNode*, QuantityValue>> _allocations;
+
+    bool ExecuteAllocation(OrderBook* order_book_ptr, LevelNode* level_ptr, Order* order_ptr, uint64_t owner_id, PriceValue price, uint64_t volume);
+    static uint64_t CalculateAllocationVolume(const LevelNode* level_ptr, uint64_t owner_id) noexcept;
+    static uint64_t CalculateProRata(uint64_t volume, uint64_t quantity, uint64_t total) noexcept;
+
+    // Trailing stop orders recalculation
+    std::vector<OrderNode*> _trailing_orders;
+
+    void RecalculateTrailingStopPrice(OrderBook* order_book_ptr, LevelNode* level_ptr);
+    void UpdateTrackingStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr);
+
+    // Sweep executions
+    bool _sweeps;
+    bool _sweeping;
+    bool _sweep_top;
+    std::vector<Fill> _sweep_fills;
+    std::vector<std::pair<UpdateType, Order>> _sweep_orders;
+    std::vector<LevelUpdate> _sweep_levels;
+
+    void UpdateSweep(const OrderBook& order_book, const Order& order);
+    void ExecuteRestingOrder(const Order& order, PriceValue price, QuantityValue quantity);
+    void UpdateRestingOrder(const Order& order, UpdateType type);
+
+    // Call auction
+    mutable std::vector<std::pair<PriceValue, uint64_t>> _auction_bids;
+    mutable std::vector<std::pair<PriceValue, uint64_t>> _auction_asks;
+
+    uint64_t CalculateAuction(OrderBook* order_book_ptr, PriceValue& price) const;
+    uint64_t CalculateAuctionVolume(const LevelNode* level_ptr) const noexcept;
+    void ExecuteAuction(OrderBook* order_book_ptr, LevelNode* level_ptr, PriceValue price, uint64_t volume);
+    void Uncross(OrderBook* order_book_ptr);
+
+    void UpdateLevel(const OrderBook& order_book, const LevelUpdate& update, int symbol_id=0);
 };
 
+//! Market manager with the default price level container
+typedef MarketManagerT<LevelLadder> MarketManager;
+
 /*! \example market_manager.cpp Market manager example */
 /*! \example matching_engine.cpp Matching engine example */
 
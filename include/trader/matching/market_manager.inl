@@ -9,12 +9,14 @@
 namespace CppTrader {
 namespace Matching {
 
-inline MarketManager::MarketManager()
-    : MarketManager(_default)
+template <class TLevels>
+inline MarketManagerT<TLevels>::MarketManagerT()
+    : MarketManagerT(_default)
 {
 }
 
-inline MarketManager::MarketManager(MarketHandler& market_handler)
+template <class TLevels>
+inline MarketManagerT<TLevels>::MarketManagerT(MarketHandler& market_handler)
     : _market_handler(market_handler),
       _auxiliary_memory_manager(),
       _level_memory_manager(_auxiliary_memory_manager),
@@ -25,30 +27,52 @@ inline MarketManager::MarketManager(MarketHandler& market_handler)
       _order_book_pool(_order_book_memory_manager),
       _order_memory_manager(_auxiliary_memory_manager),
       _order_pool(_order_memory_manager),
-      _orders(16384, 0),
-      _matching(false)
+      _orders(16384),
+      _handle_order(nullptr),
+      _arena_chunk(0),
+      _matching(false),
+      _sweeps(false),
+      _sweeping(false),
+      _sweep_top(false)
 {
 
 }
 
-inline const Symbol* MarketManager::GetSymbol(uint32_t id) const noexcept
+template <class TLevels>
+inline const Symbol* MarketManagerT<TLevels>::GetSymbol(uint32_t id) const noexcept
 {
     return ((id < _symbols.size()) ? _symbols[id] : nullptr);
 }
 
-inline const OrderBook* MarketManager::GetOrderBook(uint32_t id) const noexcept
+template <class TLevels>
+inline const typename MarketManagerT<TLevels>::OrderBook* MarketManagerT<TLevels>::GetOrderBook(uint32_t id) const noexcept
 {
     return ((id < _order_books.size()) ? _order_books[id] : nullptr);
 }
 
-inline const Order* MarketManager::GetOrder(uint64_t id) const noexcept
+template <class TLevels>
+inline const Order* MarketManagerT<TLevels>::GetOrder(uint64_t id) const noexcept
 {
     assert((id > 0) && "Order Id must be greater than zero!");
     if (id == 0)
         return nullptr;
+    if (!IsRepresentable<OrderIdValue>(id))
+        return nullptr;
+
+    auto it = _orders.find((OrderIdValue)id);
+    if (it == _orders.end())
+        return nullptr;
+
+    // Resolve the stop price of the tracking trailing stop order
+    OrderNode* order_ptr = it->second;
+    if (order_ptr->Tracking)
+    {
+        const OrderBook* order_book_ptr = GetOrderBook(order_ptr->SymbolId);
+        if (order_book_ptr != nullptr)
+            order_book_ptr->UpdateTrailingOffsetStopPrice(order_ptr);
+    }
 
-    auto it = _orders.find(id);
-    return ((it != _orders.end()) ? it->second : nullptr);
+    return order_ptr;
 }
 
 } // namespace Matching
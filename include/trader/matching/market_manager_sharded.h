@@ -0,0 +1,340 @@
+/*!
+    \file market_manager_sharded.h
+    \brief Sharded market manager definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_MANAGER_SHARDED_H
+#define CPPTRADER_MATCHING_MARKET_MANAGER_SHARDED_H
+
+#include "market_manager.h"
+
+#include "system/cpu.h"
+#include "threads/spsc_ring_queue.h"
+#include "threads/thread.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Sharded market manager
+/*!
+    Sharded market manager distributes symbols between several market managers
+    (shards) by symbol Id. Each shard runs in its own worker thread, so all
+    orders and order books of one symbol are always managed by the same shard
+    and orders matching never crosses shards.
+
+    Commands are assigned increasing sequence numbers and routed to shards over
+    single-producer/single-consumer ring queues. Commands addressed by order Id
+    are routed with the order Id directory, which is updated when orders are
+    added or replaced and pruned when their delete events are dispatched.
+
+    Shards report market events back over ring queues as well. Dispatch() method
+    merges shard event streams in the commands sequence order and reports them
+    to the market handler. The merged stream contains symbol, order and order
+    execution events. Order book and price level events refer to order books
+    owned by shards, so they are reported only to shard market handlers in the
+    corresponding worker threads.
+
+    Commands are executed asynchronously, so returned error codes cover only
+    commands routing. Shard market managers and their orders, order books and
+    symbols could be accessed only when shards are synchronized with the
+    Synchronize() method or stopped.
+
+    Not thread-safe, all methods must be called from the same thread.
+*/
+template <class TLevels>
+class ShardedMarketManagerT
+{
+public:
+    //! Market manager
+    typedef MarketManagerT<TLevels> MarketManager;
+    //! Market handler
+    typedef MarketHandlerT<TLevels> MarketHandler;
+    //! Order book
+    typedef OrderBookT<TLevels> OrderBook;
+
+    //! Initialize the sharded market manager
+    /*!
+        \param market_handler - Market handler of the merged event stream
+        \param shards - Shards count (default is 0 for the count of logical CPU cores)
+        \param capacity - Commands and events ring queues capacity, must be a power of two (default is 65536)
+    */
+    explicit ShardedMarketManagerT(MarketHandler& market_handler, size_t shards = 0, size_t capacity = 65536);
+    ShardedMarketManagerT(const ShardedMarketManagerT&) = delete;
+    ShardedMarketManagerT(ShardedMarketManagerT&&) = delete;
+    ~ShardedMarketManagerT();
+
+    ShardedMarketManagerT& operator=(const ShardedMarketManagerT&) = delete;
+    ShardedMarketManagerT& operator=(ShardedMarketManagerT&&) = delete;
+
+    //! Get shards count
+    size_t shards() const noexcept { return _shards.size(); }
+    //! Get the last command sequence number
+    uint64_t sequence() const noexcept { return _sequence; }
+
+    //! Get the shard index of the symbol with the given Id
+    size_t GetShard(uint32_t id) const noexcept { return id % _shards.size(); }
+    //! Get the shard market manager
+    /*!
+        \param shard - Shard index
+        \return Shard market manager
+    */
+    const MarketManager& GetMarketManager(size_t shard) const noexcept;
+    //! Set the shard market handler
+    /*!
+        Shard market handler is called in the shard worker thread with all
+        market events of the shard including order book and price level
+        events. It must be set before the sharded market manager is started.
+
+        \param shard - Shard index
+        \param market_handler - Shard market handler
+    */
+    void SetShardHandler(size_t shard, MarketHandler& market_handler);
+
+    //! Get the symbol with the given Id
+    /*!
+        \param id - Symbol Id
+        \return Pointer to the symbol with the given Id or nullptr
+    */
+    const Symbol* GetSymbol(uint32_t id) const noexcept;
+    //! Get the order book for the given symbol Id
+    /*!
+        \param id - Symbol Id of the order book
+        \return Pointer to the order book with the given symbol Id or nullptr
+    */
+    const OrderBook* GetOrderBook(uint32_t id) const noexcept;
+    //! Get the order with the given Id
+    /*!
+        Order is looked up in the shard found in the order Id directory.
+
+        \param id - Order Id
+        \return Pointer to the order with the given Id or nullptr
+    */
+    const Order* GetOrder(uint64_t id) const noexcept;
+
+    //! Is the sharded market manager started?
+    bool IsStarted() const noexcept { return _started; }
+
+    //! Start shard worker threads
+    /*!
+        \param pin - Pin shard worker threads to CPU cores next to the current one (default is false)
+        \return 'true' if shard worker threads were successfully started, 'false' if they are already started
+    */
+    bool Start(bool pin = false);
+    //! Synchronize and stop shard worker threads
+    /*!
+        \return 'true' if shard worker threads were successfully stopped, 'false' if they are already stopped
+    */
+    bool Stop();
+
+    //! Add a new symbol
+    ErrorCode AddSymbol(const Symbol& symbol);
+    //! Delete the symbol
+    ErrorCode DeleteSymbol(uint32_t id);
+
+    //! Add a new order book
+    ErrorCode AddOrderBook(const Symbol& symbol, size_t size = 0, uint64_t tick = 1);
+    //! Delete the order book
+    ErrorCode DeleteOrderBook(uint32_t id);
+
+    //! Add a new order
+    /*!
+        Order with the Id which is still in the order Id directory is rejected
+        with ORDER_DUPLICATE error code.
+
+        \param order - Order to add
+        \return Error code
+    */
+    ErrorCode AddOrder(const Order& order);
+    //! Reduce the order by the given quantity
+    ErrorCode ReduceOrder(uint64_t id, uint64_t quantity);
+    //! Modify the order
+    ErrorCode ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity);
+    //! Mitigate the order
+    ErrorCode MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity);
+    //! Replace the order with a similar order but different Id, price and quantity
+    ErrorCode ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity);
+    //! Replace the order with a new one
+    ErrorCode ReplaceOrder(uint64_t id, const Order& new_order);
+    //! Delete the order
+    ErrorCode DeleteOrder(uint64_t id);
+
+    //! Execute the order
+    ErrorCode ExecuteOrder(uint64_t id, uint64_t quantity);
+    //! Execute the order with the given price
+    ErrorCode ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity);
+
+    //! Is automatic matching enabled?
+    bool IsMatchingEnabled() const noexcept { return _matching; }
+    //! Enable automatic matching in all shards
+    void EnableMatching();
+    //! Disable automatic matching in all shards
+    void DisableMatching();
+
+    //! Match crossed orders in all order books of all shards
+    void Match();
+
+    //! Dispatch market events of shards merged in the commands sequence order
+    /*!
+        Market events are dispatched only when all shards have reported all
+        events of previous commands, so the method could dispatch only a part
+        of already reported events.
+
+        \return Count of dispatched market events
+    */
+    size_t Dispatch();
+    //! Wait for all shards to execute all commands and dispatch all market events
+    void Synchronize();
+
+private:
+    enum class CommandType : uint8_t
+    {
+        ADD_SYMBOL,
+        DELETE_SYMBOL,
+        ADD_ORDER_BOOK,
+        DELETE_ORDER_BOOK,
+        ADD_ORDER,
+        REDUCE_ORDER,
+        MODIFY_ORDER,
+        MITIGATE_ORDER,
+        REPLACE_ORDER,
+        REPLACE_ORDER_NEW,
+        DELETE_ORDER,
+        EXECUTE_ORDER,
+        EXECUTE_ORDER_PRICE,
+        ENABLE_MATCHING,
+        DISABLE_MATCHING,
+        MATCH
+    };
+
+    struct Command
+    {
+        uint64_t Sequence;
+        CommandType Type;
+        uint64_t Id;
+        uint64_t NewId;
+        uint64_t Price;
+        uint64_t Quantity;
+        size_t Size;
+        Symbol SymbolData;
+        Order OrderData;
+
+        Command() noexcept : Sequence(0), Type(CommandType::MATCH), Id(0), NewId(0), Price(0), Quantity(0), Size(0), SymbolData(), OrderData() {}
+    };
+
+    enum class EventType : uint8_t
+    {
+        ADD_SYMBOL,
+        DELETE_SYMBOL,
+        ADD_ORDER,
+        UPDATE_ORDER,
+        DELETE_ORDER,
+        EXECUTE_ORDER,
+        REJECT_ORDER
+    };
+
+    struct Event
+    {
+        uint64_t Sequence;
+        EventType Type;
+        PriceValue Price;
+        QuantityValue Quantity;
+        Symbol SymbolData;
+        Order OrderData;
+
+        Event() noexcept : Sequence(0), Type(EventType::ADD_ORDER), Price(0), Quantity(0), SymbolData(), OrderData() {}
+    };
+
+    // Shard market handler records market events of the shard into its events ring queue
+    class ShardHandler : public MarketHandler
+    {
+    public:
+        explicit ShardHandler(size_t capacity) : Events(capacity), Sequence(0), Handler(&_default) {}
+
+        // Shard events ring queue
+        CppCommon::SPSCRingQueue<Event> Events;
+        // Sequence number of the executed command
+        uint64_t Sequence;
+        // Custom shard market handler
+        MarketHandler* Handler;
+
+        void Report(EventType type, const Order& order, PriceValue price = 0, QuantityValue quantity = 0);
+        void Report(EventType type, const Symbol& symbol);
+
+    protected:
+        void onAddSymbol(const Symbol& symbol) override;
+        void onDeleteSymbol(const Symbol& symbol) override;
+        void onAddOrderBook(const OrderBook& order_book) override;
+        void onUpdateOrderBook(const OrderBook& order_book, bool top, int symbol_id) override;
+        void onDeleteOrderBook(const OrderBook& order_book) override;
+        void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override;
+        void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override;
+        void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override;
+        void onAddOrder(const Order& order) override;
+        void onUpdateOrder(const Order& order) override;
+        void onDeleteOrder(const Order& order) override;
+        void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override;
+    };
+
+    struct Shard
+    {
+        // Shard market handler and manager
+        ShardHandler Handler;
+        MarketManager Manager;
+        // Shard commands ring queue
+        CppCommon::SPSCRingQueue<Command> Commands;
+        // Shard worker thread
+        std::thread Thread;
+        // Sequence number of the last executed command
+        std::atomic<uint64_t> Executed;
+        // Sequence number of the last routed command
+        uint64_t Routed;
+        // Reported events waiting to be merged
+        std::vector<Event> Pending;
+        size_t Position;
+
+        explicit Shard(size_t capacity) : Handler(capacity), Manager(Handler), Commands(capacity), Executed(0), Routed(0), Position(0) {}
+    };
+
+    // Default shard market handler
+    static MarketHandler _default;
+    // Market handler of the merged event stream
+    MarketHandler& _market_handler;
+
+    // Shards
+    std::vector<std::unique_ptr<Shard>> _shards;
+    std::atomic<bool> _running;
+    bool _started;
+    bool _matching;
+
+    // Last command sequence number
+    uint64_t _sequence;
+
+    // Order Id directory
+    CppCommon::HashMap<uint64_t, uint32_t, FastHash> _directory;
+
+    ErrorCode FindShard(uint64_t id, size_t& shard) const noexcept;
+
+    void Route(size_t shard, Command& command);
+    void Broadcast(Command& command);
+    void Collect(Shard& shard);
+
+    void Run(Shard& shard, int cpu);
+    static ErrorCode Execute(Shard& shard, const Command& command);
+};
+
+//! Sharded market manager with the default price level container
+typedef ShardedMarketManagerT<LevelLadder> ShardedMarketManager;
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_manager_sharded.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_MANAGER_SHARDED_H
@@ -0,0 +1,65 @@
+/*!
+    \file market_manager_sharded.inl
+    \brief Sharded market manager inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TLevels>
+inline const typename ShardedMarketManagerT<TLevels>::MarketManager& ShardedMarketManagerT<TLevels>::GetMarketManager(size_t shard) const noexcept
+{
+    assert((shard < _shards.size()) && "Invalid shard index!");
+    return _shards[shard]->Manager;
+}
+
+template <class TLevels>
+inline void ShardedMarketManagerT<TLevels>::SetShardHandler(size_t shard, MarketHandler& market_handler)
+{
+    assert((shard < _shards.size()) && "Invalid shard index!");
+    assert(!IsStarted() && "Shard market handler must be set before the sharded market manager is started!");
+    _shards[shard]->Handler.Handler = &market_handler;
+}
+
+template <class TLevels>
+inline const Symbol* ShardedMarketManagerT<TLevels>::GetSymbol(uint32_t id) const noexcept
+{
+    return _shards[GetShard(id)]->Manager.GetSymbol(id);
+}
+
+template <class TLevels>
+inline const typename ShardedMarketManagerT<TLevels>::OrderBook* ShardedMarketManagerT<TLevels>::GetOrderBook(uint32_t id) const noexcept
+{
+    return _shards[GetShard(id)]->Manager.GetOrderBook(id);
+}
+
+template <class TLevels>
+inline const Order* ShardedMarketManagerT<TLevels>::GetOrder(uint64_t id) const noexcept
+{
+    size_t shard;
+    if (FindShard(id, shard) != ErrorCode::OK)
+        return nullptr;
+
+    return _shards[shard]->Manager.GetOrder(id);
+}
+
+template <class TLevels>
+inline ErrorCode ShardedMarketManagerT<TLevels>::FindShard(uint64_t id, size_t& shard) const noexcept
+{
+    // Zero is the blank key of the order Id directory
+    if (id == 0)
+        return ErrorCode::ORDER_NOT_FOUND;
+
+    auto it = _directory.find(id);
+    if (it == _directory.end())
+        return ErrorCode::ORDER_NOT_FOUND;
+
+    shard = it->second;
+    return ErrorCode::OK;
+}
+
+} // namespace Matching
+} // namespace CppTrader
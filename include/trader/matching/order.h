@@ -10,11 +10,13 @@
 #define CPPTRADER_MATCHING_ORDER_H
 
 #include "errors.h"
+#include "types.h"
 
 #include "containers/list.h"
 #include "utility/iostream.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -117,6 +119,28 @@ enum class OrderTimeInForce : uint8_t
 template <class TOutputStream>
 TOutputStream& operator<<(TOutputStream& stream, OrderTimeInForce tif);
 
+//! Order self-trade prevention mode
+/*!
+    Self-trade prevention mode of the aggressive order defines what happens
+    when it meets a resting order of the same owner:
+    \li <b>NONE</b> - Orders of the same owner are matched as usual
+    \li <b>CANCEL_RESTING</b> - Resting order is cancelled, matching continues
+    \li <b>CANCEL_AGGRESSOR</b> - Remaining part of the aggressive order is cancelled
+    \li <b>CANCEL_BOTH</b> - Resting order and remaining part of the aggressive order are cancelled
+    \li <b>DECREMENT</b> - Both orders are decreased by the smaller leaves quantity without execution
+*/
+enum class OrderSelfTradePrevention : uint8_t
+{
+    NONE,               //!< No self-trade prevention
+    CANCEL_RESTING,     //!< Cancel resting order
+    CANCEL_AGGRESSOR,   //!< Cancel aggressive order
+    CANCEL_BOTH,        //!< Cancel both orders
+    DECREMENT           //!< Decrement both orders
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, OrderSelfTradePrevention stp);
+
 //! Order
 /*!
     An order is an instruction to buy or sell on a trading venue such as a stock market,
@@ -127,28 +151,27 @@ TOutputStream& operator<<(TOutputStream& stream, OrderTimeInForce tif);
 struct Order
 {
     //! Order Id
-    uint64_t Id;
+    OrderIdValue Id;
+    //! Order price
+    PriceValue Price;
+    //! Order leaves quantity
+    QuantityValue LeavesQuantity;
+    //! Order executed quantity
+    QuantityValue ExecutedQuantity;
     //! Symbol Id
     uint32_t SymbolId;
     //! Order type
     OrderType Type;
     //! Order side
     OrderSide Side;
-    //! Order price
-    uint64_t Price;
-    //! Order stop price
-    uint64_t StopPrice;
-
-    //! Order quantity
-    uint64_t Quantity;
-    //! Order executed quantity
-    uint64_t ExecutedQuantity;
-    //! Order leaves quantity
-    uint64_t LeavesQuantity;
-
     //! Time in Force
     OrderTimeInForce TimeInForce;
 
+    //! Order quantity
+    QuantityValue Quantity;
+    //! Order stop price
+    PriceValue StopPrice;
+
     //! Order max visible quantity
     /*!
         This property allows to prepare 'iceberg'/'hidden' orders with the
@@ -159,11 +182,25 @@ struct Order
 
         Supported only for limit and stop-limit orders!
     */
-    uint64_t MaxVisibleQuantity;
+    QuantityValue MaxVisibleQuantity;
+    //! Order executed quantity of the current displayed 'iceberg' slice
+    /*!
+        Executions of the resting 'iceberg' order consume its displayed slice.
+        When the slice is executed completely it is replenished from the hidden
+        quantity and the order loses its time priority at the price level.
+    */
+    QuantityValue SliceExecutedQuantity;
     //! Order hidden quantity
-    uint64_t HiddenQuantity() const noexcept { return (LeavesQuantity > MaxVisibleQuantity) ? (LeavesQuantity - MaxVisibleQuantity) : 0; }
+    QuantityValue HiddenQuantity() const noexcept { return LeavesQuantity - VisibleQuantity(); }
     //! Order visible quantity
-    uint64_t VisibleQuantity() const noexcept { return std::min(LeavesQuantity, MaxVisibleQuantity); }
+    QuantityValue VisibleQuantity() const noexcept { return std::min(LeavesQuantity, MaxVisibleQuantity - SliceExecutedQuantity); }
+    //! Order quantity executable by one fill of the resting order
+    /*!
+        Resting 'iceberg' order is executed by its displayed slice, the rest is
+        executed after the slice is replenished. 'Hidden' and 'All-Or-None'
+        orders are executed by their leaves quantity.
+    */
+    QuantityValue ExecutableQuantity() const noexcept { return (IsHidden() || IsAON()) ? LeavesQuantity : VisibleQuantity(); }
 
     //! Market order slippage
     /*!
@@ -176,7 +213,7 @@ struct Order
 
         Supported only for market and stop orders!
     */
-    uint64_t Slippage;
+    PriceValue Slippage;
 
     //! Order trailing distance to market
     /*!
@@ -197,11 +234,28 @@ struct Order
     */
     int64_t TrailingStep;
 
+    //! Order owner Id
+    /*!
+        Owner Id identifies the market participant of the order. Zero owner Id
+        means the order has no owner and never triggers self-trade prevention.
+    */
+    uint64_t OwnerId;
+    //! Order self-trade prevention mode
+    /*!
+        Applied when the order matches as an aggressive order. 'Fill-Or-Kill'
+        and 'All-Or-None' orders follow the same rules along their matching
+        chain: the order is cancelled when a cancelling mode reaches a resting
+        order of the same owner before the matching chain is completed.
+    */
+    OrderSelfTradePrevention SelfTradePrevention;
+    //! Order owner bit in the price level owners filter
+    uint64_t OwnerMask() const noexcept { return (OwnerId != 0) ? ((uint64_t)1 << ((OwnerId * 0x9E3779B97F4A7C15ull) >> 58)) : 0; }
+
     Order() noexcept = default;
-    Order(uint64_t id, uint32_t symbol, OrderType type, OrderSide side, uint64_t price, uint64_t stop_price, uint64_t quantity,
+    Order(OrderIdValue id, uint32_t symbol, OrderType type, OrderSide side, PriceValue price, PriceValue stop_price, QuantityValue quantity,
         OrderTimeInForce tif = OrderTimeInForce::GTC,
-        uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max(),
-        uint64_t slippage = std::numeric_limits<uint64_t>::max(),
+        QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max(),
+        PriceValue slippage = std::numeric_limits<PriceValue>::max(),
         int64_t trailing_distance = 0,
         int64_t trailing_step = 0) noexcept;
     Order(const Order&) noexcept = default;
@@ -244,64 +298,91 @@ struct Order
     //! Is the 'Hidden' order?
     bool IsHidden() const noexcept { return MaxVisibleQuantity == 0; }
     //! Is the 'Iceberg' order?
-    bool IsIceberg() const noexcept { return MaxVisibleQuantity < std::numeric_limits<uint64_t>::max(); }
+    bool IsIceberg() const noexcept { return MaxVisibleQuantity < std::numeric_limits<QuantityValue>::max(); }
 
     //! Is the order have slippage?
-    bool IsSlippage() const noexcept { return Slippage < std::numeric_limits<uint64_t>::max(); }
+    bool IsSlippage() const noexcept { return Slippage < std::numeric_limits<PriceValue>::max(); }
 
     //! Validate order parameters
     ErrorCode Validate() const noexcept;
 
     //! Prepare a new market order
-    static Order Market(uint64_t id, uint32_t symbol, OrderSide side, uint64_t quantity, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order Market(OrderIdValue id, uint32_t symbol, OrderSide side, QuantityValue quantity, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
     //! Prepare a new buy market order
-    static Order BuyMarket(uint64_t id, uint32_t symbol, uint64_t quantity, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order BuyMarket(OrderIdValue id, uint32_t symbol, QuantityValue quantity, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
     //! Prepare a new sell market order
-    static Order SellMarket(uint64_t id, uint32_t symbol, uint64_t quantity, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order SellMarket(OrderIdValue id, uint32_t symbol, QuantityValue quantity, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
 
     //! Prepare a new limit order
-    static Order Limit(uint64_t id, uint32_t symbol, OrderSide side, uint64_t price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order Limit(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
     //! Prepare a new buy limit order
-    static Order BuyLimit(uint64_t id, uint32_t symbol, uint64_t price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order BuyLimit(OrderIdValue id, uint32_t symbol, PriceValue price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
     //! Prepare a new sell limit order
-    static Order SellLimit(uint64_t id, uint32_t symbol, uint64_t price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order SellLimit(OrderIdValue id, uint32_t symbol, PriceValue price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
 
     //! Prepare a new stop order
-    static Order Stop(uint64_t id, uint32_t symbol, OrderSide side, uint64_t stop_price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order Stop(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue stop_price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
     //! Prepare a new buy stop order
-    static Order BuyStop(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order BuyStop(OrderIdValue id, uint32_t symbol, PriceValue stop_price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
     //! Prepare a new sell stop order
-    static Order SellStop(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order SellStop(OrderIdValue id, uint32_t symbol, PriceValue stop_price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
 
     //! Prepare a new stop-limit order
-    static Order StopLimit(uint64_t id, uint32_t symbol, OrderSide side, uint64_t stop_price, uint64_t price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order StopLimit(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue stop_price, PriceValue price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
     //! Prepare a new buy stop-limit order
-    static Order BuyStopLimit(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order BuyStopLimit(OrderIdValue id, uint32_t symbol, PriceValue stop_price, PriceValue price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
     //! Prepare a new sell stop-limit order
-    static Order SellStopLimit(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t price, uint64_t quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order SellStopLimit(OrderIdValue id, uint32_t symbol, PriceValue stop_price, PriceValue price, QuantityValue quantity, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
 
     //! Prepare a new trailing stop order
-    static Order TrailingStop(uint64_t id, uint32_t symbol, OrderSide side, uint64_t stop_price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order TrailingStop(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue stop_price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
     //! Prepare a new trailing buy stop order
-    static Order TrailingBuyStop(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order TrailingBuyStop(OrderIdValue id, uint32_t symbol, PriceValue stop_price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
     //! Prepare a new trailing sell stop order
-    static Order TrailingSellStop(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t slippage = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order TrailingSellStop(OrderIdValue id, uint32_t symbol, PriceValue stop_price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, PriceValue slippage = std::numeric_limits<PriceValue>::max()) noexcept;
 
     //! Prepare a new trailing stop-limit order
-    static Order TrailingStopLimit(uint64_t id, uint32_t symbol, OrderSide side, uint64_t stop_price, uint64_t price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order TrailingStopLimit(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue stop_price, PriceValue price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
     //! Prepare a new trailing buy stop-limit order
-    static Order TrailingBuyStopLimit(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order TrailingBuyStopLimit(OrderIdValue id, uint32_t symbol, PriceValue stop_price, PriceValue price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
     //! Prepare a new trailing sell stop-limit order
-    static Order TrailingSellStopLimit(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, uint64_t max_visible_quantity = std::numeric_limits<uint64_t>::max()) noexcept;
+    static Order TrailingSellStopLimit(OrderIdValue id, uint32_t symbol, PriceValue stop_price, PriceValue price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step = 0, OrderTimeInForce tif = OrderTimeInForce::GTC, QuantityValue max_visible_quantity = std::numeric_limits<QuantityValue>::max()) noexcept;
+};
+
+//! Order fill
+/*!
+    Order fill describes a single execution of the resting order.
+*/
+struct Fill
+{
+    //! Resting order Id
+    OrderIdValue Id;
+    //! Execution price
+    PriceValue Price;
+    //! Execution quantity
+    QuantityValue Quantity;
 };
 
 struct LevelNode;
+struct OrderNode;
 
-//! Order node
-struct OrderNode : public Order, public CppCommon::List<OrderNode>::Node
+//! Order node links
+struct OrderLinks : public CppCommon::List<OrderNode>::Node
 {
+    //! Order price level
     LevelNode* Level;
 
+    OrderLinks() noexcept : Level(nullptr) {}
+};
+
+//! Order node
+struct OrderNode : public OrderLinks, public Order
+{
+    //! Order sequence in the price level queue
+    size_t Sequence;
+    //! Is the trailing stop order tracking the common trailing reference price?
+    bool Tracking;
+
     OrderNode(const Order& order) noexcept;
     OrderNode(const OrderNode&) noexcept = default;
     OrderNode(OrderNode&&) noexcept = default;
@@ -312,6 +393,47 @@ struct OrderNode : public Order, public CppCommon::List<OrderNode>::Node
     OrderNode& operator=(OrderNode&&) noexcept = default;
 };
 
+template <class TLevels>
+class MarketManagerT;
+
+//! Order handle
+/*!
+    Order handle refers to the order node resting in the order book and lets
+    the market manager reduce, modify, replace, execute or delete the order
+    without an order Id lookup.
+
+    Order handle stays valid until the order is deleted from the market
+    manager (onDeleteOrder() market handler notification). Any usage of the
+    stale order handle is undefined behavior.
+*/
+class OrderHandle
+{
+    template <class TLevels>
+    friend class MarketManagerT;
+
+public:
+    OrderHandle() noexcept : _order(nullptr) {}
+    OrderHandle(const OrderHandle&) noexcept = default;
+    OrderHandle(OrderHandle&&) noexcept = default;
+    ~OrderHandle() noexcept = default;
+
+    OrderHandle& operator=(const OrderHandle&) noexcept = default;
+    OrderHandle& operator=(OrderHandle&&) noexcept = default;
+
+    //! Check if the order handle is valid
+    explicit operator bool() const noexcept { return _order != nullptr; }
+
+    //! Get the order
+    const Order& operator*() const noexcept { return *_order; }
+    //! Get the order pointer
+    const Order* operator->() const noexcept { return _order; }
+
+private:
+    OrderNode* _order;
+
+    explicit OrderHandle(OrderNode* order_ptr) noexcept : _order(order_ptr) {}
+};
+
 } // namespace Matching
 } // namespace CppTrader
 
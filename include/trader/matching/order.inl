@@ -81,21 +81,51 @@ inline TOutputStream& operator<<(TOutputStream& stream, OrderTimeInForce tif)
     return stream;
 }
 
-inline Order::Order(uint64_t id, uint32_t symbol, OrderType type, OrderSide side, uint64_t price, uint64_t stop_price, uint64_t quantity, OrderTimeInForce tif, uint64_t max_visible_quantity, uint64_t slippage, int64_t trailing_distance, int64_t trailing_step) noexcept
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, OrderSelfTradePrevention stp)
+{
+    switch (stp)
+    {
+        case OrderSelfTradePrevention::NONE:
+            stream << "NONE";
+            break;
+        case OrderSelfTradePrevention::CANCEL_RESTING:
+            stream << "CANCEL-RESTING";
+            break;
+        case OrderSelfTradePrevention::CANCEL_AGGRESSOR:
+            stream << "CANCEL-AGGRESSOR";
+            break;
+        case OrderSelfTradePrevention::CANCEL_BOTH:
+            stream << "CANCEL-BOTH";
+            break;
+        case OrderSelfTradePrevention::DECREMENT:
+            stream << "DECREMENT";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+inline Order::Order(OrderIdValue id, uint32_t symbol, OrderType type, OrderSide side, PriceValue price, PriceValue stop_price, QuantityValue quantity, OrderTimeInForce tif, QuantityValue max_visible_quantity, PriceValue slippage, int64_t trailing_distance, int64_t trailing_step) noexcept
     : Id(id),
+      Price(price),
+      LeavesQuantity(quantity),
+      ExecutedQuantity(0),
       SymbolId(symbol),
       Type(type),
       Side(side),
-      Price(price),
-      StopPrice(stop_price),
-      Quantity(quantity),
-      ExecutedQuantity(0),
-      LeavesQuantity(quantity),
       TimeInForce(tif),
+      Quantity(quantity),
+      StopPrice(stop_price),
       MaxVisibleQuantity(max_visible_quantity),
+      SliceExecutedQuantity(0),
       Slippage(slippage),
       TrailingDistance(trailing_distance),
-      TrailingStep(trailing_step)
+      TrailingStep(trailing_step),
+      OwnerId(0),
+      SelfTradePrevention(OrderSelfTradePrevention::NONE)
 {
 }
 
@@ -121,108 +151,117 @@ inline TOutputStream& operator<<(TOutputStream& stream, const Order& order)
         stream << "; MaxVisibleQuantity=" << order.MaxVisibleQuantity;
     if (order.IsSlippage())
         stream << "; Slippage=" << order.Slippage;
+    if (order.OwnerId != 0)
+    {
+        stream << "; OwnerId=" << order.OwnerId;
+        stream << "; SelfTradePrevention=" << order.SelfTradePrevention;
+    }
     stream << ")";
     return stream;
 }
 
-inline Order Order::Market(uint64_t id, uint32_t symbol, OrderSide side, uint64_t quantity, uint64_t slippage) noexcept
+inline Order Order::Market(OrderIdValue id, uint32_t symbol, OrderSide side, QuantityValue quantity, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::MARKET, side, 0, 0, quantity, OrderTimeInForce::IOC, std::numeric_limits<uint64_t>::max(), slippage, 0, 0);
+    return Order(id, symbol, OrderType::MARKET, side, 0, 0, quantity, OrderTimeInForce::IOC, std::numeric_limits<QuantityValue>::max(), slippage, 0, 0);
 }
 
-inline Order Order::BuyMarket(uint64_t id, uint32_t symbol, uint64_t quantity, uint64_t slippage) noexcept
+inline Order Order::BuyMarket(OrderIdValue id, uint32_t symbol, QuantityValue quantity, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::MARKET, OrderSide::BUY, 0, 0, quantity, OrderTimeInForce::IOC, std::numeric_limits<uint64_t>::max(), slippage, 0, 0);
+    return Order(id, symbol, OrderType::MARKET, OrderSide::BUY, 0, 0, quantity, OrderTimeInForce::IOC, std::numeric_limits<QuantityValue>::max(), slippage, 0, 0);
 }
 
-inline Order Order::SellMarket(uint64_t id, uint32_t symbol, uint64_t quantity, uint64_t slippage) noexcept
+inline Order Order::SellMarket(OrderIdValue id, uint32_t symbol, QuantityValue quantity, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::MARKET, OrderSide::SELL, 0, 0, quantity, OrderTimeInForce::IOC, std::numeric_limits<uint64_t>::max(), slippage, 0, 0);
+    return Order(id, symbol, OrderType::MARKET, OrderSide::SELL, 0, 0, quantity, OrderTimeInForce::IOC, std::numeric_limits<QuantityValue>::max(), slippage, 0, 0);
 }
 
-inline Order Order::Limit(uint64_t id, uint32_t symbol, OrderSide side, uint64_t price, uint64_t quantity, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::Limit(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue price, QuantityValue quantity, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::LIMIT, side, price, 0, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), 0, 0);
+    return Order(id, symbol, OrderType::LIMIT, side, price, 0, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), 0, 0);
 }
 
-inline Order Order::BuyLimit(uint64_t id, uint32_t symbol, uint64_t price, uint64_t quantity, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::BuyLimit(OrderIdValue id, uint32_t symbol, PriceValue price, QuantityValue quantity, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::LIMIT, OrderSide::BUY, price, 0, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), 0, 0);
+    return Order(id, symbol, OrderType::LIMIT, OrderSide::BUY, price, 0, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), 0, 0);
 }
 
-inline Order Order::SellLimit(uint64_t id, uint32_t symbol, uint64_t price, uint64_t quantity, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::SellLimit(OrderIdValue id, uint32_t symbol, PriceValue price, QuantityValue quantity, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::LIMIT, OrderSide::SELL, price, 0, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), 0, 0);
+    return Order(id, symbol, OrderType::LIMIT, OrderSide::SELL, price, 0, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), 0, 0);
 }
 
-inline Order Order::Stop(uint64_t id, uint32_t symbol, OrderSide side, uint64_t stop_price, uint64_t quantity, OrderTimeInForce tif, uint64_t slippage) noexcept
+inline Order Order::Stop(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue stop_price, QuantityValue quantity, OrderTimeInForce tif, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::STOP, side, 0, stop_price, quantity, tif, std::numeric_limits<uint64_t>::max(), slippage, 0, 0);
+    return Order(id, symbol, OrderType::STOP, side, 0, stop_price, quantity, tif, std::numeric_limits<QuantityValue>::max(), slippage, 0, 0);
 }
 
-inline Order Order::BuyStop(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t quantity, OrderTimeInForce tif, uint64_t slippage) noexcept
+inline Order Order::BuyStop(OrderIdValue id, uint32_t symbol, PriceValue stop_price, QuantityValue quantity, OrderTimeInForce tif, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::STOP, OrderSide::BUY, 0, stop_price, quantity, tif, std::numeric_limits<uint64_t>::max(), slippage, 0, 0);
+    return Order(id, symbol, OrderType::STOP, OrderSide::BUY, 0, stop_price, quantity, tif, std::numeric_limits<QuantityValue>::max(), slippage, 0, 0);
 }
 
-inline Order Order::SellStop(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t quantity, OrderTimeInForce tif, uint64_t slippage) noexcept
+inline Order Order::SellStop(OrderIdValue id, uint32_t symbol, PriceValue stop_price, QuantityValue quantity, OrderTimeInForce tif, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::STOP, OrderSide::SELL, 0, stop_price, quantity, tif, std::numeric_limits<uint64_t>::max(), slippage, 0, 0);
+    return Order(id, symbol, OrderType::STOP, OrderSide::SELL, 0, stop_price, quantity, tif, std::numeric_limits<QuantityValue>::max(), slippage, 0, 0);
 }
 
-inline Order Order::StopLimit(uint64_t id, uint32_t symbol, OrderSide side, uint64_t stop_price, uint64_t price, uint64_t quantity, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::StopLimit(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue stop_price, PriceValue price, QuantityValue quantity, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::STOP_LIMIT, side, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), 0, 0);
+    return Order(id, symbol, OrderType::STOP_LIMIT, side, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), 0, 0);
 }
 
-inline Order Order::BuyStopLimit(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t price, uint64_t quantity, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::BuyStopLimit(OrderIdValue id, uint32_t symbol, PriceValue stop_price, PriceValue price, QuantityValue quantity, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::STOP_LIMIT, OrderSide::BUY, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), 0, 0);
+    return Order(id, symbol, OrderType::STOP_LIMIT, OrderSide::BUY, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), 0, 0);
 }
 
-inline Order Order::SellStopLimit(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t price, uint64_t quantity, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::SellStopLimit(OrderIdValue id, uint32_t symbol, PriceValue stop_price, PriceValue price, QuantityValue quantity, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::STOP_LIMIT, OrderSide::SELL, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), 0, 0);
+    return Order(id, symbol, OrderType::STOP_LIMIT, OrderSide::SELL, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), 0, 0);
 }
 
-inline Order Order::TrailingStop(uint64_t id, uint32_t symbol, OrderSide side, uint64_t stop_price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, uint64_t slippage) noexcept
+inline Order Order::TrailingStop(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue stop_price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::TRAILING_STOP, side, 0, stop_price, quantity, tif, std::numeric_limits<uint64_t>::max(), slippage, trailing_distance, trailing_step);
+    return Order(id, symbol, OrderType::TRAILING_STOP, side, 0, stop_price, quantity, tif, std::numeric_limits<QuantityValue>::max(), slippage, trailing_distance, trailing_step);
 }
 
-inline Order Order::TrailingBuyStop(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, uint64_t slippage) noexcept
+inline Order Order::TrailingBuyStop(OrderIdValue id, uint32_t symbol, PriceValue stop_price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::TRAILING_STOP, OrderSide::BUY, 0, stop_price, quantity, tif, std::numeric_limits<uint64_t>::max(), slippage, trailing_distance, trailing_step);
+    return Order(id, symbol, OrderType::TRAILING_STOP, OrderSide::BUY, 0, stop_price, quantity, tif, std::numeric_limits<QuantityValue>::max(), slippage, trailing_distance, trailing_step);
 }
 
-inline Order Order::TrailingSellStop(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, uint64_t slippage) noexcept
+inline Order Order::TrailingSellStop(OrderIdValue id, uint32_t symbol, PriceValue stop_price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, PriceValue slippage) noexcept
 {
-    return Order(id, symbol, OrderType::TRAILING_STOP, OrderSide::SELL, 0, stop_price, quantity, tif, std::numeric_limits<uint64_t>::max(), slippage, trailing_distance, trailing_step);
+    return Order(id, symbol, OrderType::TRAILING_STOP, OrderSide::SELL, 0, stop_price, quantity, tif, std::numeric_limits<QuantityValue>::max(), slippage, trailing_distance, trailing_step);
 }
 
-inline Order Order::TrailingStopLimit(uint64_t id, uint32_t symbol, OrderSide side, uint64_t stop_price, uint64_t price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::TrailingStopLimit(OrderIdValue id, uint32_t symbol, OrderSide side, PriceValue stop_price, PriceValue price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::TRAILING_STOP_LIMIT, side, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), trailing_distance, trailing_step);
+    return Order(id, symbol, OrderType::TRAILING_STOP_LIMIT, side, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), trailing_distance, trailing_step);
 }
 
-inline Order Order::TrailingBuyStopLimit(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::TrailingBuyStopLimit(OrderIdValue id, uint32_t symbol, PriceValue stop_price, PriceValue price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::TRAILING_STOP_LIMIT, OrderSide::BUY, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), trailing_distance, trailing_step);
+    return Order(id, symbol, OrderType::TRAILING_STOP_LIMIT, OrderSide::BUY, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), trailing_distance, trailing_step);
 }
 
-inline Order Order::TrailingSellStopLimit(uint64_t id, uint32_t symbol, uint64_t stop_price, uint64_t price, uint64_t quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, uint64_t max_visible_quantity) noexcept
+inline Order Order::TrailingSellStopLimit(OrderIdValue id, uint32_t symbol, PriceValue stop_price, PriceValue price, QuantityValue quantity, int64_t trailing_distance, int64_t trailing_step, OrderTimeInForce tif, QuantityValue max_visible_quantity) noexcept
 {
-    return Order(id, symbol, OrderType::TRAILING_STOP_LIMIT, OrderSide::SELL, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), trailing_distance, trailing_step);
+    return Order(id, symbol, OrderType::TRAILING_STOP_LIMIT, OrderSide::SELL, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<PriceValue>::max(), trailing_distance, trailing_step);
 }
 
-inline OrderNode::OrderNode(const Order& order) noexcept : Order(order), Level(nullptr)
+inline OrderNode::OrderNode(const Order& order) noexcept : Order(order), Sequence(0), Tracking(false)
 {
+    SliceExecutedQuantity = 0;
 }
 
 inline OrderNode& OrderNode::operator=(const Order& order) noexcept
 {
     Order::operator=(order);
     Level = nullptr;
+    SliceExecutedQuantity = 0;
+    Sequence = 0;
+    Tracking = false;
     return *this;
 }
 
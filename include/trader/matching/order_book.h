@@ -10,36 +10,98 @@
 #define CPPTRADER_MATCHING_ORDER_BOOK_H
 
 #include "level.h"
+#include "level_depth.h"
+#include "level_ladder.h"
+#include "level_tree.h"
+#include "level_vector.h"
 #include "symbol.h"
+#include "top_of_book.h"
 
 #include "memory/allocator_pool.h"
 
+#include <memory>
+
 namespace CppTrader {
 namespace Matching {
 
-class MarketManager;
+template <class TLevels>
+class MarketManagerT;
+
+//! Order book allocation policy
+/*!
+    Allocation policy defines how an aggressive order execution is allocated
+    among resting orders of a matched price level.
+*/
+enum class AllocationType : uint8_t
+{
+    FIFO,               //!< Strict price-time priority
+    PRO_RATA,           //!< Proportionally to the resting orders visible quantity
+    TOP_ORDER_PRO_RATA  //!< Top order first, the rest proportionally to the resting orders visible quantity
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, AllocationType allocation);
 
 //! Order book
 /*!
     Order book is used to keep buy and sell orders in a price level order.
 
+    Price levels are kept in the given price level container policy:
+    \li LevelTree - AVL tree of price levels
+    \li LevelVector - sorted vector of price levels with the best one at the back
+    \li LevelLadder - tick-indexed ladder of price levels with an overflow tree
+
+    Each price level container is constructed with a price level type, a size
+    and a price tick, and provides find(), insert(), erase(), best(), lowest(),
+    highest(), higher(), lower() and ascending iteration over price levels.
+
+    Each price level keeps displayed orders and hidden orders in separate
+    queues. Displayed orders are matched ahead of hidden orders of the same
+    price level, so displayed queues stay short and never hold hidden nodes.
+
+    Stop and trailing stop orders price levels together with the market
+    prices tracked for their activation are kept in a separate stop book
+    which is allocated on the first stop order. Order books which never
+    receive stop orders stay small and skip stop orders activation.
+
+    Order book could publish its top of the book (best bid and ask prices,
+    their visible volumes and the last trade price) for concurrent readers.
+    Published top of the book is updated after each price level update.
+
+    Order book could own a memory arena for its order and price level nodes.
+    Nodes of the order book are allocated and recycled within its arena, so
+    active order books keep their nodes close in memory. The arena is released
+    wholesale together with the order book. Order books without the arena
+    allocate their nodes from the shared market manager pools.
+
     Not thread-safe.
 */
-class OrderBook
+template <class TLevels>
+class OrderBookT
 {
-    friend class MarketManager;
+    friend class MarketManagerT<TLevels>;
 
 public:
+    //! Market manager
+    typedef MarketManagerT<TLevels> MarketManager;
     //! Price level container
-    typedef CppCommon::BinTreeAVL<LevelNode, std::less<LevelNode>> Levels;
+    typedef TLevels Levels;
 
-    OrderBook(MarketManager& manager, const Symbol& symbol);
-    OrderBook(const OrderBook&) = delete;
-    OrderBook(OrderBook&&) = delete;
-    ~OrderBook();
+    //! Initialize the order book
+    /*!
+        \param manager - Market manager
+        \param symbol - Order book symbol
+        \param size - Price level container size (default is 0)
+        \param tick - Price level container price tick (default is 1)
+        \param arena - Memory arena chunk size in bytes or 0 to use the market manager pools (default is 0)
+    */
+    OrderBookT(MarketManager& manager, const Symbol& symbol, size_t size = 0, uint64_t tick = 1, size_t arena = 0);
+    OrderBookT(const OrderBookT&) = delete;
+    OrderBookT(OrderBookT&&) = delete;
+    ~OrderBookT();
 
-    OrderBook& operator=(const OrderBook&) = delete;
-    OrderBook& operator=(OrderBook&&) = delete;
+    OrderBookT& operator=(const OrderBookT&) = delete;
+    OrderBookT& operator=(OrderBookT&&) = delete;
 
     //! Check if the order book is not empty
     explicit operator bool() const noexcept { return !empty(); }
@@ -48,7 +110,7 @@ public:
     bool empty() const noexcept { return size() == 0; }
 
     //! Get the order book size
-    size_t size() const noexcept { return _bids.size() + _asks.size() + _buy_stop.size() + _sell_stop.size() + _trailing_buy_stop.size() + _trailing_sell_stop.size(); }
+    size_t size() const noexcept { return _bids.size() + _asks.size() + ((_stops != nullptr) ? _stops->size() : 0); }
 
     //! Get the order book symbol
     const Symbol& symbol() const noexcept { return _symbol; }
@@ -63,67 +125,109 @@ public:
     //! Get the order book asks container
     const Levels& asks() const noexcept { return _asks; }
 
+    //! Does the order book own the memory arena?
+    bool has_arena() const noexcept { return _arena != nullptr; }
+    //! Is the order book stop book allocated?
+    bool has_stops() const noexcept { return _stops != nullptr; }
+
     //! Get the order book best buy stop order price level
-    const LevelNode* best_buy_stop() const noexcept { return _best_buy_stop; }
+    const LevelNode* best_buy_stop() const noexcept { return (_stops != nullptr) ? _stops->BestBuyStop : nullptr; }
     //! Get the order book best sell stop order price level
-    const LevelNode* best_sell_stop() const noexcept { return _best_sell_stop; }
+    const LevelNode* best_sell_stop() const noexcept { return (_stops != nullptr) ? _stops->BestSellStop : nullptr; }
+
+    //! Get the order book bids depth cache
+    const LevelDepth& bid_depth() const noexcept { return _bid_depth; }
+    //! Get the order book asks depth cache
+    const LevelDepth& ask_depth() const noexcept { return _ask_depth; }
+
+    //! Get the order book allocation policy
+    AllocationType allocation() const noexcept { return _allocation; }
+
+    //! Get the order book top of the book published for concurrent readers
+    /*!
+        \return Pointer to the published top of the book or nullptr if it is not published
+    */
+    const TopOfBook* top_of_book() const noexcept { return _top_of_book.get(); }
 
     //! Get the order book buy stop orders container
-    const Levels& buy_stop() const noexcept { return _buy_stop; }
+    const Levels& buy_stop() const noexcept { return (_stops != nullptr) ? _stops->BuyStop : EmptyLevels(LevelType::ASK); }
     //! Get the order book sell stop orders container
-    const Levels& sell_stop() const noexcept { return _sell_stop; }
+    const Levels& sell_stop() const noexcept { return (_stops != nullptr) ? _stops->SellStop : EmptyLevels(LevelType::BID); }
 
     //! Get the order book best trailing buy stop order price level
-    const LevelNode* best_trailing_buy_stop() const noexcept { return _best_trailing_buy_stop; }
+    const LevelNode* best_trailing_buy_stop() const noexcept { return (_stops != nullptr) ? _stops->BestTrailingBuyStop : nullptr; }
     //! Get the order book best trailing sell stop order price level
-    const LevelNode* best_trailing_sell_stop() const noexcept { return _best_trailing_sell_stop; }
+    const LevelNode* best_trailing_sell_stop() const noexcept { return (_stops != nullptr) ? _stops->BestTrailingSellStop : nullptr; }
 
     //! Get the order book trailing buy stop orders container
-    const Levels& trailing_buy_stop() const noexcept { return _trailing_buy_stop; }
+    const Levels& trailing_buy_stop() const noexcept { return (_stops != nullptr) ? _stops->TrailingBuyStop : EmptyLevels(LevelType::ASK); }
     //! Get the order book trailing sell stop orders container
-    const Levels& trailing_sell_stop() const noexcept { return _trailing_sell_stop; }
+    const Levels& trailing_sell_stop() const noexcept { return (_stops != nullptr) ? _stops->TrailingSellStop : EmptyLevels(LevelType::BID); }
 
-    template <class TOutputStream>
-    friend TOutputStream& operator<<(TOutputStream& stream, const OrderBook& order_book);
+    //! Get the order book tracking trailing buy stop orders container
+    /*!
+        Trailing stop orders with the absolute trailing distance and without
+        the trailing step which stop price is the trailing reference price
+        plus (buy) or minus (sell) the trailing distance track the common
+        trailing reference price. Such orders are kept in price levels keyed
+        by the trailing distance from the best (smallest) one, so the market
+        move updates the trailing reference price and the stop price of each
+        tracking order in place without moving it between price levels.
+
+        Percentage trailing stop orders (negative trailing distance) and
+        orders with the trailing step are not tracked. They stay in trailing
+        stop price levels and are recalculated and moved to the new stop
+        price level on each favorable market move.
+    */
+    const Levels& trailing_buy_offset() const noexcept { return (_stops != nullptr) ? _stops->TrailingBuyOffset : EmptyLevels(LevelType::ASK); }
+    //! Get the order book tracking trailing sell stop orders container
+    const Levels& trailing_sell_offset() const noexcept { return (_stops != nullptr) ? _stops->TrailingSellOffset : EmptyLevels(LevelType::ASK); }
+    //! Get the order book trailing buy stop reference price
+    PriceValue trailing_buy_reference() const noexcept { return (_stops != nullptr) ? _stops->TrailingBuyReference : std::numeric_limits<PriceValue>::max(); }
+    //! Get the order book trailing sell stop reference price
+    PriceValue trailing_sell_reference() const noexcept { return (_stops != nullptr) ? _stops->TrailingSellReference : 0; }
+
+    template <class TOutputStream, class T>
+    friend TOutputStream& operator<<(TOutputStream& stream, const OrderBookT<T>& order_book);
 
     //! Get the order book bid price level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book bid price level with the given price or nullptr
     */
-    const LevelNode* GetBid(uint64_t price) const noexcept;
+    const LevelNode* GetBid(PriceValue price) const noexcept;
     //! Get the order book ask price level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book ask price level with the given price or nullptr
     */
-    const LevelNode* GetAsk(uint64_t price) const noexcept;
+    const LevelNode* GetAsk(PriceValue price) const noexcept;
 
     //! Get the order book buy stop level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book buy stop level with the given price or nullptr
     */
-    const LevelNode* GetBuyStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetBuyStopLevel(PriceValue price) const noexcept;
     //! Get the order book sell stop level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book sell stop level with the given price or nullptr
     */
-    const LevelNode* GetSellStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetSellStopLevel(PriceValue price) const noexcept;
 
     //! Get the order book trailing buy stop level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book trailing buy stop level with the given price or nullptr
     */
-    const LevelNode* GetTrailingBuyStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetTrailingBuyStopLevel(PriceValue price) const noexcept;
     //! Get the order book trailing sell stop level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book trailing sell stop level with the given price or nullptr
     */
-    const LevelNode* GetTrailingSellStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetTrailingSellStopLevel(PriceValue price) const noexcept;
     
     void dump() const;
 
@@ -134,6 +238,25 @@ private:
     // Order book symbol
     Symbol _symbol;
 
+    // Order book memory arena
+    struct Arena
+    {
+        CppCommon::PoolMemoryManager<CppCommon::DefaultMemoryManager> LevelMemoryManager;
+        CppCommon::PoolAllocator<LevelNode, CppCommon::DefaultMemoryManager> LevelPool;
+        CppCommon::PoolMemoryManager<CppCommon::DefaultMemoryManager> OrderMemoryManager;
+        CppCommon::PoolAllocator<OrderNode, CppCommon::DefaultMemoryManager> OrderPool;
+
+        Arena(CppCommon::DefaultMemoryManager& auxiliary, size_t chunk);
+    };
+    std::unique_ptr<Arena> _arena;
+
+    // Nodes allocation
+    template <typename... Args>
+    LevelNode* CreateLevel(Args&&... args);
+    void ReleaseLevel(LevelNode* level_ptr);
+    OrderNode* CreateOrder(const Order& order);
+    void ReleaseOrder(OrderNode* order_ptr);
+
     // Bid/Ask price levels
     LevelNode* _best_bid;
     LevelNode* _best_ask;
@@ -147,14 +270,58 @@ private:
 
     // Orders management
     LevelUpdate AddOrder(OrderNode* order_ptr);
-    LevelUpdate ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
+    LevelUpdate ReduceOrder(OrderNode* order_ptr, QuantityValue quantity, QuantityValue hidden, QuantityValue visible);
     LevelUpdate DeleteOrder(OrderNode* order_ptr);
-
-    // Buy/Sell stop orders levels
-    LevelNode* _best_buy_stop;
-    LevelNode* _best_sell_stop;
-    Levels _buy_stop;
-    Levels _sell_stop;
+    void ReplenishOrder(OrderNode* order_ptr);
+
+    // Orders queue management
+    QueuePosition GetQueuePosition(OrderNode* order_ptr);
+    void RebuildQueue(LevelNode* level_ptr);
+
+    // Stop book with stop and trailing stop orders
+    struct StopBook
+    {
+        // Buy/Sell stop orders levels
+        LevelNode* BestBuyStop;
+        LevelNode* BestSellStop;
+        Levels BuyStop;
+        Levels SellStop;
+
+        // Buy/Sell trailing stop orders levels
+        LevelNode* BestTrailingBuyStop;
+        LevelNode* BestTrailingSellStop;
+        Levels TrailingBuyStop;
+        Levels TrailingSellStop;
+
+        // Buy/Sell trailing stop orders levels tracking the trailing reference price
+        LevelNode* BestTrailingBuyOffset;
+        LevelNode* BestTrailingSellOffset;
+        Levels TrailingBuyOffset;
+        Levels TrailingSellOffset;
+        PriceValue TrailingBuyReference;
+        PriceValue TrailingSellReference;
+
+        // Market matching and trailing prices
+        PriceValue MatchingBidPrice;
+        PriceValue MatchingAskPrice;
+        PriceValue TrailingBidPrice;
+        PriceValue TrailingAskPrice;
+
+        StopBook(size_t size, uint64_t tick);
+
+        size_t size() const noexcept { return BuyStop.size() + SellStop.size() + TrailingBuyStop.size() + TrailingSellStop.size() + TrailingBuyOffset.size() + TrailingSellOffset.size(); }
+    };
+
+    // Price level containers size and price tick
+    size_t _levels_size;
+    uint64_t _levels_tick;
+
+    // Stop book allocated on the first stop order
+    std::unique_ptr<StopBook> _stops;
+
+    // Stop book management
+    StopBook& GetStopBook();
+    static const Levels& EmptyLevels(LevelType type);
 
     // Stop orders price level management
     LevelNode* GetNextStopLevel(LevelNode* level) noexcept;
@@ -163,15 +330,9 @@ private:
 
     // Stop orders management
     void AddStopOrder(OrderNode* order_ptr);
-    void ReduceStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
+    void ReduceStopOrder(OrderNode* order_ptr, QuantityValue quantity, QuantityValue hidden, QuantityValue visible);
     void DeleteStopOrder(OrderNode* order_ptr);
 
-    // Buy/Sell trailing stop orders levels
-    LevelNode* _best_trailing_buy_stop;
-    LevelNode* _best_trailing_sell_stop;
-    Levels _trailing_buy_stop;
-    Levels _trailing_sell_stop;
-
     // Trailing stop orders price level management
     LevelNode* GetNextTrailingStopLevel(LevelNode* level) noexcept;
     LevelNode* AddTrailingStopLevel(OrderNode* order_ptr);
@@ -179,30 +340,55 @@ private:
 
     // Trailing stop orders management
     void AddTrailingStopOrder(OrderNode* order_ptr);
-    void ReduceTrailingStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
+    void ReduceTrailingStopOrder(OrderNode* order_ptr, QuantityValue quantity, QuantityValue hidden, QuantityValue visible);
     void DeleteTrailingStopOrder(OrderNode* order_ptr);
 
+    // Trailing stop orders tracking the trailing reference price management
+    LevelNode* GetNextTrailingOffsetLevel(LevelNode* level) noexcept;
+    bool IsTrailingOffsetOrder(const OrderNode* order_ptr) const noexcept;
+    PriceValue GetTrailingOffsetStopPrice(const LevelNode* level) const noexcept;
+    void UpdateTrailingOffsetStopPrice(OrderNode* order_ptr) const noexcept;
+    bool UpdateTrailingReferencePrice(LevelType type, PriceValue price) noexcept;
+
     // Trailing stop price calculation
-    uint64_t CalculateTrailingStopPrice(const Order& order) const noexcept;
+    PriceValue CalculateTrailingStopPrice(const Order& order) const noexcept;
 
-    // Market last and trailing prices
-    uint64_t _last_bid_price;
-    uint64_t _last_ask_price;
-    uint64_t _matching_bid_price;
-    uint64_t _matching_ask_price;
-    uint64_t _trailing_bid_price;
-    uint64_t _trailing_ask_price;
+    // Market last prices
+    PriceValue _last_bid_price;
+    PriceValue _last_ask_price;
+    PriceValue _last_price;
 
     // Update market last prices
-    uint64_t GetMarketPriceBid() const noexcept;
-    uint64_t GetMarketPriceAsk() const noexcept;
-    uint64_t GetMarketTrailingStopPriceBid() const noexcept;
-    uint64_t GetMarketTrailingStopPriceAsk() const noexcept;
-    void UpdateLastPrice(const Order& order, uint64_t price) noexcept;
-    void UpdateMatchingPrice(const Order& order, uint64_t price) noexcept;
+    PriceValue GetMarketPriceBid() const noexcept;
+    PriceValue GetMarketPriceAsk() const noexcept;
+    PriceValue GetMarketTrailingStopPriceBid() const noexcept;
+    PriceValue GetMarketTrailingStopPriceAsk() const noexcept;
+    void UpdateLastPrice(const Order& order, PriceValue price) noexcept;
+    void UpdateMatchingPrice(const Order& order, PriceValue price) noexcept;
     void ResetMatchingPrice() noexcept;
+
+    // Top of the book depth caches
+    LevelDepth _bid_depth;
+    LevelDepth _ask_depth;
+
+    // Depth caches management
+    void ResetDepth(size_t depth);
+    void UpdateDepth(UpdateType update, const Level& level);
+
+    // Allocation policy of matched price levels
+    AllocationType _allocation;
+
+    // Top of the book published for concurrent readers
+    std::unique_ptr<TopOfBook> _top_of_book;
+
+    // Top of the book management
+    void ResetTopOfBook(bool publish);
+    void PublishTopOfBook() const noexcept;
 };
 
+//! Order book with the default price level container
+typedef OrderBookT<LevelLadder> OrderBook;
+
 } // namespace Matching
 } // namespace CppTrader
 
@@ -10,56 +10,78 @@ namespace CppTrader {
 namespace Matching {
 
 template <class TOutputStream>
-inline TOutputStream& operator<<(TOutputStream& stream, const OrderBook& order_book)
+inline TOutputStream& operator<<(TOutputStream& stream, AllocationType allocation)
+{
+    switch (allocation)
+    {
+        case AllocationType::FIFO:
+            stream << "FIFO";
+            break;
+        case AllocationType::PRO_RATA:
+            stream << "PRO_RATA";
+            break;
+        case AllocationType::TOP_ORDER_PRO_RATA:
+            stream << "TOP_ORDER_PRO_RATA";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+template <class TOutputStream, class TLevels>
+inline TOutputStream& operator<<(TOutputStream& stream, const OrderBookT<TLevels>& order_book)
 {
     stream << "OrderBook(Symbol=" << order_book._symbol
         << "; Bids=" << order_book._bids.size()
         << "; Asks=" << order_book._asks.size()
-        << "; BuyStop=" << order_book._buy_stop.size()
-        << "; SellStop=" << order_book._sell_stop.size()
-        << "; TrailingBuyStop=" << order_book._trailing_buy_stop.size()
-        << "; TrailingSellStop=" << order_book._trailing_sell_stop.size()
+        << "; BuyStop=" << order_book.buy_stop().size()
+        << "; SellStop=" << order_book.sell_stop().size()
+        << "; TrailingBuyStop=" << order_book.trailing_buy_stop().size()
+        << "; TrailingSellStop=" << order_book.trailing_sell_stop().size()
         << ")";
     return stream;
 }
 
-inline const LevelNode* OrderBook::GetBid(uint64_t price) const noexcept
+template <class TLevels>
+inline const LevelNode* OrderBookT<TLevels>::GetBid(PriceValue price) const noexcept
 {
-    auto it = _bids.find(LevelNode(LevelType::BID, price));
-    return (it != _bids.end()) ? it.operator->() : nullptr;
+    return _bids.find(price);
 }
 
-inline const LevelNode* OrderBook::GetAsk(uint64_t price) const noexcept
+template <class TLevels>
+inline const LevelNode* OrderBookT<TLevels>::GetAsk(PriceValue price) const noexcept
 {
-    auto it = _asks.find(LevelNode(LevelType::ASK, price));
-    return (it != _asks.end()) ? it.operator->() : nullptr;
+    return _asks.find(price);
 }
 
-inline const LevelNode* OrderBook::GetBuyStopLevel(uint64_t price) const noexcept
+template <class TLevels>
+inline const LevelNode* OrderBookT<TLevels>::GetBuyStopLevel(PriceValue price) const noexcept
 {
-    auto it = _buy_stop.find(LevelNode(LevelType::ASK, price));
-    return (it != _buy_stop.end()) ? it.operator->() : nullptr;
+    return (_stops != nullptr) ? _stops->BuyStop.find(price) : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetSellStopLevel(uint64_t price) const noexcept
+template <class TLevels>
+inline const LevelNode* OrderBookT<TLevels>::GetSellStopLevel(PriceValue price) const noexcept
 {
-    auto it = _sell_stop.find(LevelNode(LevelType::BID, price));
-    return (it != _sell_stop.end()) ? it.operator->() : nullptr;
+    return (_stops != nullptr) ? _stops->SellStop.find(price) : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetTrailingBuyStopLevel(uint64_t price) const noexcept
+template <class TLevels>
+inline const LevelNode* OrderBookT<TLevels>::GetTrailingBuyStopLevel(PriceValue price) const noexcept
 {
-    auto it = _trailing_buy_stop.find(LevelNode(LevelType::ASK, price));
-    return (it != _trailing_buy_stop.end()) ? it.operator->() : nullptr;
+    return (_stops != nullptr) ? _stops->TrailingBuyStop.find(price) : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetTrailingSellStopLevel(uint64_t price) const noexcept
+template <class TLevels>
+inline const LevelNode* OrderBookT<TLevels>::GetTrailingSellStopLevel(PriceValue price) const noexcept
 {
-    auto it = _trailing_sell_stop.find(LevelNode(LevelType::BID, price));
-    return (it != _trailing_sell_stop.end()) ? it.operator->() : nullptr;
+    return (_stops != nullptr) ? _stops->TrailingSellStop.find(price) : nullptr;
 }
 
-inline void OrderBook::dump() const
+template <class TLevels>
+inline void OrderBookT<TLevels>::dump() const
 {
     std::cout << "Ask: ";
     for (const auto &ask : _asks)
@@ -71,102 +93,199 @@ inline void OrderBook::dump() const
     std::cout << std::endl;
 }
 
-inline LevelNode* OrderBook::GetNextLevel(LevelNode* level) noexcept
+template <class TLevels>
+template <typename... Args>
+inline LevelNode* OrderBookT<TLevels>::CreateLevel(Args&&... args)
+{
+    if (_arena != nullptr)
+        return _arena->LevelPool.Create(std::forward<Args>(args)...);
+    else
+        return _manager._level_pool.Create(std::forward<Args>(args)...);
+}
+
+template <class TLevels>
+inline void OrderBookT<TLevels>::ReleaseLevel(LevelNode* level_ptr)
+{
+    if (_arena != nullptr)
+        _arena->LevelPool.Release(level_ptr);
+    else
+        _manager._level_pool.Release(level_ptr);
+}
+
+template <class TLevels>
+inline OrderNode* OrderBookT<TLevels>::CreateOrder(const Order& order)
+{
+    if (_arena != nullptr)
+        return _arena->OrderPool.Create(order);
+    else
+        return _manager._order_pool.Create(order);
+}
+
+template <class TLevels>
+inline void OrderBookT<TLevels>::ReleaseOrder(OrderNode* order_ptr)
+{
+    if (_arena != nullptr)
+        _arena->OrderPool.Release(order_ptr);
+    else
+        _manager._order_pool.Release(order_ptr);
+}
+
+template <class TLevels>
+inline LevelNode* OrderBookT<TLevels>::GetNextLevel(LevelNode* level) noexcept
 {
     if (level->IsBid())
-    {
-        Levels::reverse_iterator it(&_bids, level);
-        ++it;
-        return it.operator->();
-    }
+        return _bids.lower(level);
     else
-    {
-        Levels::iterator it(&_asks, level);
-        ++it;
-        return it.operator->();
-    }
+        return _asks.higher(level);
 }
 
-inline LevelNode* OrderBook::GetNextStopLevel(LevelNode* level) noexcept
+template <class TLevels>
+inline LevelNode* OrderBookT<TLevels>::GetNextStopLevel(LevelNode* level) noexcept
 {
     if (level->IsBid())
-    {
-        Levels::reverse_iterator it(&_sell_stop, level);
-        ++it;
-        return it.operator->();
-    }
+        return _stops->SellStop.lower(level);
     else
-    {
-        Levels::iterator it(&_buy_stop, level);
-        ++it;
-        return it.operator->();
-    }
+        return _stops->BuyStop.higher(level);
+}
+
+template <class TLevels>
+inline LevelNode* OrderBookT<TLevels>::GetNextTrailingStopLevel(LevelNode* level) noexcept
+{
+    if (level->IsBid())
+        return _stops->TrailingSellStop.lower(level);
+    else
+        return _stops->TrailingBuyStop.higher(level);
 }
 
-inline LevelNode* OrderBook::GetNextTrailingStopLevel(LevelNode* level) noexcept
+template <class TLevels>
+inline LevelNode* OrderBookT<TLevels>::GetNextTrailingOffsetLevel(LevelNode* level) noexcept
 {
+    if (level->IsBid())
+        return _stops->TrailingSellOffset.higher(level);
+    else
+        return _stops->TrailingBuyOffset.higher(level);
+}
+
+template <class TLevels>
+inline PriceValue OrderBookT<TLevels>::GetTrailingOffsetStopPrice(const LevelNode* level) const noexcept
+{
+    PriceValue distance = level->Price;
     if (level->IsBid())
     {
-        Levels::reverse_iterator it(&_trailing_sell_stop, level);
-        ++it;
-        return it.operator->();
+        PriceValue reference = _stops->TrailingSellReference;
+        return (reference > distance) ? (reference - distance) : 0;
     }
     else
     {
-        Levels::iterator it(&_trailing_buy_stop, level);
-        ++it;
-        return it.operator->();
+        PriceValue reference = _stops->TrailingBuyReference;
+        return (reference < (std::numeric_limits<PriceValue>::max() - distance)) ? (reference + distance) : std::numeric_limits<PriceValue>::max();
+    }
+}
+
+template <class TLevels>
+inline void OrderBookT<TLevels>::UpdateTrailingOffsetStopPrice(OrderNode* order_ptr) const noexcept
+{
+    if (!order_ptr->Tracking)
+        return;
+
+    // Update the stop price of the tracking trailing stop order with the current trailing reference price
+    PriceValue stop_price = GetTrailingOffsetStopPrice(order_ptr->Level);
+    if (order_ptr->IsTrailingStopLimit())
+    {
+        int64_t diff = order_ptr->Price - order_ptr->StopPrice;
+        order_ptr->Price = stop_price + diff;
     }
+    order_ptr->StopPrice = stop_price;
+}
+
+template <class TLevels>
+inline bool OrderBookT<TLevels>::UpdateTrailingReferencePrice(LevelType type, PriceValue price) noexcept
+{
+    // Trailing reference price moves only in the favorable direction
+    PriceValue& reference = (type == LevelType::ASK) ? _stops->TrailingBuyReference : _stops->TrailingSellReference;
+    if ((type == LevelType::ASK) ? (price >= reference) : (price <= reference))
+        return false;
+
+    reference = price;
+    return true;
 }
 
-inline uint64_t OrderBook::GetMarketPriceBid() const noexcept
+template <class TLevels>
+inline PriceValue OrderBookT<TLevels>::GetMarketPriceBid() const noexcept
 {
-    uint64_t matching_price = _matching_bid_price;
-    uint64_t best_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
+    PriceValue matching_price = (_stops != nullptr) ? _stops->MatchingBidPrice : 0;
+    PriceValue best_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
     return std::max(matching_price, best_price);
 }
 
-inline uint64_t OrderBook::GetMarketPriceAsk() const noexcept
+template <class TLevels>
+inline PriceValue OrderBookT<TLevels>::GetMarketPriceAsk() const noexcept
 {
-    uint64_t matching_price = _matching_ask_price;
-    uint64_t best_price = (_best_ask != nullptr) ? _best_ask->Price : std::numeric_limits<uint64_t>::max();
+    PriceValue matching_price = (_stops != nullptr) ? _stops->MatchingAskPrice : std::numeric_limits<PriceValue>::max();
+    PriceValue best_price = (_best_ask != nullptr) ? _best_ask->Price : std::numeric_limits<PriceValue>::max();
     return std::min(matching_price, best_price);
 }
 
-inline uint64_t OrderBook::GetMarketTrailingStopPriceBid() const noexcept
+template <class TLevels>
+inline PriceValue OrderBookT<TLevels>::GetMarketTrailingStopPriceBid() const noexcept
 {
-    uint64_t last_price = _last_bid_price;
-    uint64_t best_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
+    PriceValue last_price = _last_bid_price;
+    PriceValue best_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
     return std::min(last_price, best_price);
 }
 
-inline uint64_t OrderBook::GetMarketTrailingStopPriceAsk() const noexcept
+template <class TLevels>
+inline PriceValue OrderBookT<TLevels>::GetMarketTrailingStopPriceAsk() const noexcept
 {
-    uint64_t last_price = _last_ask_price;
-    uint64_t best_price = (_best_ask != nullptr) ? _best_ask->Price : std::numeric_limits<uint64_t>::max();
+    PriceValue last_price = _last_ask_price;
+    PriceValue best_price = (_best_ask != nullptr) ? _best_ask->Price : std::numeric_limits<PriceValue>::max();
     return std::max(last_price, best_price);
 }
 
-inline void OrderBook::UpdateLastPrice(const Order& order, uint64_t price) noexcept
+template <class TLevels>
+inline void OrderBookT<TLevels>::UpdateLastPrice(const Order& order, PriceValue price) noexcept
 {
     if (order.IsBuy())
         _last_bid_price = price;
     else
         _last_ask_price = price;
+    _last_price = price;
 }
 
-inline void OrderBook::UpdateMatchingPrice(const Order& order, uint64_t price) noexcept
+template <class TLevels>
+inline void OrderBookT<TLevels>::UpdateMatchingPrice(const Order& order, PriceValue price) noexcept
 {
+    // Matching prices are tracked only for stop orders activation
+    if (_stops == nullptr)
+        return;
+
     if (order.IsBuy())
-        _matching_bid_price = price;
+        _stops->MatchingBidPrice = price;
     else
-        _matching_ask_price = price;
+        _stops->MatchingAskPrice = price;
 }
 
-inline void OrderBook::ResetMatchingPrice() noexcept
+template <class TLevels>
+inline void OrderBookT<TLevels>::ResetMatchingPrice() noexcept
 {
-    _matching_bid_price = 0;
-    _matching_ask_price = std::numeric_limits<uint64_t>::max();
+    if (_stops == nullptr)
+        return;
+
+    _stops->MatchingBidPrice = 0;
+    _stops->MatchingAskPrice = std::numeric_limits<PriceValue>::max();
+}
+
+template <class TLevels>
+inline void OrderBookT<TLevels>::PublishTopOfBook() const noexcept
+{
+    if (_top_of_book == nullptr)
+        return;
+
+    PriceValue bid_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
+    VolumeValue bid_volume = (_best_bid != nullptr) ? _best_bid->VisibleVolume : 0;
+    PriceValue ask_price = (_best_ask != nullptr) ? _best_ask->Price : 0;
+    VolumeValue ask_volume = (_best_ask != nullptr) ? _best_ask->VisibleVolume : 0;
+    _top_of_book->Publish(bid_price, bid_volume, ask_price, ask_volume, _last_price);
 }
 
 } // namespace Matching
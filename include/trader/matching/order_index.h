@@ -0,0 +1,208 @@
+/*!
+    \file order_index.h
+    \brief Order index definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_ORDER_INDEX_H
+#define CPPTRADER_MATCHING_ORDER_INDEX_H
+
+#include "fast_hash.h"
+#include "order.h"
+
+#include "containers/hashmap.h"
+
+#include <cassert>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+class OrderIndex;
+
+//! Order index iterator
+/*!
+    Iterates dense orders in ascending Id order and then sparse orders
+    in the hash order.
+*/
+class OrderIndexIterator
+{
+    friend class OrderIndex;
+
+public:
+    //! Sparse orders container
+    typedef CppCommon::HashMap<OrderIdValue, OrderNode*, FastHash> Sparse;
+
+    // Standard iterator type definitions
+    typedef std::ptrdiff_t difference_type;
+    typedef std::pair<OrderIdValue, OrderNode*> value_type;
+    typedef const value_type& reference;
+    typedef const value_type* pointer;
+    typedef std::forward_iterator_tag iterator_category;
+
+    OrderIndexIterator() noexcept : _index(nullptr), _page(0), _slot(0), _value(0, nullptr) {}
+    OrderIndexIterator(const OrderIndexIterator&) noexcept = default;
+    OrderIndexIterator(OrderIndexIterator&&) noexcept = default;
+    ~OrderIndexIterator() noexcept = default;
+
+    OrderIndexIterator& operator=(const OrderIndexIterator&) noexcept = default;
+    OrderIndexIterator& operator=(OrderIndexIterator&&) noexcept = default;
+
+    friend bool operator==(const OrderIndexIterator& it1, const OrderIndexIterator& it2) noexcept
+    { return (it1._page == it2._page) && (it1._slot == it2._slot) && (it1._sparse == it2._sparse); }
+    friend bool operator!=(const OrderIndexIterator& it1, const OrderIndexIterator& it2) noexcept
+    { return !(it1 == it2); }
+
+    OrderIndexIterator& operator++() noexcept;
+    OrderIndexIterator operator++(int) noexcept;
+
+    reference operator*() const noexcept { return _value; }
+    pointer operator->() const noexcept { return &_value; }
+
+private:
+    const OrderIndex* _index;
+    size_t _page;
+    size_t _slot;
+    Sparse::const_iterator _sparse;
+    value_type _value;
+
+    OrderIndexIterator(const OrderIndex* index, size_t page, size_t slot, Sparse::const_iterator sparse) noexcept;
+
+    void Seek() noexcept;
+    void Update() noexcept;
+};
+
+//! Order index
+/*!
+    Order index maps order Ids to order nodes. Order Ids of market data feeds
+    (e.g. NASDAQ ITCH order reference numbers) are near-monotonic, so orders
+    are kept in the dense directory of direct-mapped pages indexed by the order
+    Id. Lookup is a directory load and a page load without hashing.
+
+    Pages are allocated lazily when the first order with the corresponding Id
+    is inserted and released once all their orders are erased. Released pages
+    at the beginning of the directory are trimmed, so the directory follows the
+    window of live order Ids. Order Ids far ahead of the directory or behind it
+    are kept in the sparse hash map. The directory without dense orders is
+    restarted from the page of the next inserted order Id.
+
+    Not thread-safe.
+*/
+class OrderIndex
+{
+    friend class OrderIndexIterator;
+
+public:
+    //! Sparse orders container
+    typedef OrderIndexIterator::Sparse Sparse;
+
+    // Standard container type definitions
+    typedef OrderIdValue key_type;
+    typedef OrderNode* mapped_type;
+    typedef std::pair<OrderIdValue, OrderNode*> value_type;
+    typedef OrderIndexIterator iterator;
+    typedef OrderIndexIterator const_iterator;
+
+    //! Page size in bits of the order Id
+    static constexpr size_t PAGE_BITS = 12;
+    //! Page size in orders
+    static constexpr size_t PAGE_SIZE = (size_t)1 << PAGE_BITS;
+    //! Maximal count of pages to grow the directory by a single insert
+    static constexpr size_t PAGE_GAP = 16;
+
+    //! Initialize the order index
+    /*!
+        \param capacity - Sparse hash map capacity (default is 16384)
+    */
+    explicit OrderIndex(size_t capacity = 16384);
+    OrderIndex(const OrderIndex&) = delete;
+    OrderIndex(OrderIndex&&) = delete;
+    ~OrderIndex() { clear(); }
+
+    OrderIndex& operator=(const OrderIndex&) = delete;
+    OrderIndex& operator=(OrderIndex&&) = delete;
+
+    //! Check if the order index is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Is the order index empty?
+    bool empty() const noexcept { return size() == 0; }
+
+    //! Get the order index size
+    size_t size() const noexcept { return _size + _sparse.size(); }
+    //! Get the count of orders in the sparse hash map
+    size_t sparse() const noexcept { return _sparse.size(); }
+    //! Get the count of allocated pages
+    size_t pages() const noexcept { return _allocated; }
+
+    //! Get the begin order index iterator
+    iterator begin() const noexcept;
+    //! Get the end order index iterator
+    iterator end() const noexcept;
+
+    //! Find the order with the given Id
+    /*!
+        \param id - Order Id
+        \return Order index iterator to the found order or end iterator
+    */
+    iterator find(OrderIdValue id) const noexcept;
+
+    //! Insert a new order into the order index
+    /*!
+        \param value - Order Id and order node pair to insert
+        \return Pair of the order index iterator and the insertion flag
+    */
+    std::pair<iterator, bool> insert(const value_type& value);
+    //! Erase the order from the order index
+    /*!
+        Erase invalidates all order index iterators.
+
+        \param it - Order index iterator to erase
+    */
+    void erase(const iterator& it);
+    //! Erase the order with the given Id from the order index
+    /*!
+        Erase invalidates all order index iterators.
+
+        \param id - Order Id to erase
+        \return Count of erased orders
+    */
+    size_t erase(OrderIdValue id);
+
+    //! Clear the order index
+    void clear();
+
+private:
+    //! Direct-mapped orders page
+    struct Page
+    {
+        size_t Count;
+        OrderNode* Orders[PAGE_SIZE];
+    };
+
+    // Dense orders
+    uint64_t _base;
+    size_t _size;
+    size_t _allocated;
+    std::vector<Page*> _pages;
+
+    // Sparse orders
+    Sparse _sparse;
+
+    // Dense directory helpers
+    static uint64_t GetPage(OrderIdValue id) noexcept { return (uint64_t)id >> PAGE_BITS; }
+    static size_t GetSlot(OrderIdValue id) noexcept { return (size_t)((uint64_t)id & (PAGE_SIZE - 1)); }
+    Page* CreatePage(OrderIdValue id);
+    void ReleasePage(size_t index);
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "order_index.inl"
+
+#endif // CPPTRADER_MATCHING_ORDER_INDEX_H
@@ -0,0 +1,123 @@
+/*!
+    \file order_index.inl
+    \brief Order index inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline OrderIndexIterator::OrderIndexIterator(const OrderIndex* index, size_t page, size_t slot, Sparse::const_iterator sparse) noexcept
+    : _index(index), _page(page), _slot(slot), _sparse(sparse), _value(0, nullptr)
+{
+    Update();
+}
+
+inline OrderIndexIterator& OrderIndexIterator::operator++() noexcept
+{
+    if (_page < _index->_pages.size())
+    {
+        // Move to the next dense slot
+        if (++_slot == OrderIndex::PAGE_SIZE)
+        {
+            ++_page;
+            _slot = 0;
+        }
+        Seek();
+    }
+    else
+    {
+        // Move to the next sparse order
+        ++_sparse;
+        Update();
+    }
+    return *this;
+}
+
+inline OrderIndexIterator OrderIndexIterator::operator++(int) noexcept
+{
+    OrderIndexIterator result(*this);
+    operator++();
+    return result;
+}
+
+inline void OrderIndexIterator::Seek() noexcept
+{
+    // Find the first occupied dense slot starting from the current one
+    while (_page < _index->_pages.size())
+    {
+        const OrderIndex::Page* page_ptr = _index->_pages[_page];
+        if ((page_ptr != nullptr) && (page_ptr->Count > 0))
+        {
+            for (; _slot < OrderIndex::PAGE_SIZE; ++_slot)
+            {
+                if (page_ptr->Orders[_slot] != nullptr)
+                {
+                    Update();
+                    return;
+                }
+            }
+        }
+        ++_page;
+        _slot = 0;
+    }
+
+    // Continue with sparse orders
+    _sparse = _index->_sparse.begin();
+    Update();
+}
+
+inline void OrderIndexIterator::Update() noexcept
+{
+    if (_page < _index->_pages.size())
+    {
+        uint64_t page = _index->_base + _page;
+        _value.first = (OrderIdValue)((page << OrderIndex::PAGE_BITS) | _slot);
+        _value.second = _index->_pages[_page]->Orders[_slot];
+    }
+    else if (_sparse != _index->_sparse.end())
+    {
+        _value.first = _sparse->first;
+        _value.second = _sparse->second;
+    }
+    else
+    {
+        _value.first = 0;
+        _value.second = nullptr;
+    }
+}
+
+inline OrderIndex::iterator OrderIndex::begin() const noexcept
+{
+    iterator result(this, 0, 0, _sparse.end());
+    result.Seek();
+    return result;
+}
+
+inline OrderIndex::iterator OrderIndex::end() const noexcept
+{
+    return iterator(this, _pages.size(), 0, _sparse.end());
+}
+
+inline OrderIndex::iterator OrderIndex::find(OrderIdValue id) const noexcept
+{
+    // Find the order in the dense directory
+    uint64_t page = GetPage(id);
+    if ((page >= _base) && ((page - _base) < _pages.size()))
+    {
+        size_t index = (size_t)(page - _base);
+        const Page* page_ptr = _pages[index];
+        if ((page_ptr != nullptr) && (page_ptr->Orders[GetSlot(id)] != nullptr))
+            return iterator(this, index, GetSlot(id), _sparse.end());
+    }
+
+    // Find the order in the sparse hash map
+    if (_sparse.empty())
+        return end();
+    return iterator(this, _pages.size(), 0, _sparse.find(id));
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,119 @@
+/*!
+    \file top_of_book.h
+    \brief Top of the order book definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_TOP_OF_BOOK_H
+#define CPPTRADER_MATCHING_TOP_OF_BOOK_H
+
+#include "types.h"
+
+#include <atomic>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Top of the order book snapshot
+struct TopOfBookSnapshot
+{
+    //! Best bid price
+    PriceValue BidPrice;
+    //! Best bid visible volume
+    VolumeValue BidVolume;
+    //! Best ask price
+    PriceValue AskPrice;
+    //! Best ask visible volume
+    VolumeValue AskVolume;
+    //! Last trade price
+    PriceValue LastPrice;
+    //! Snapshot version
+    uint64_t Version;
+
+    TopOfBookSnapshot() noexcept : BidPrice(0), BidVolume(0), AskPrice(0), AskVolume(0), LastPrice(0), Version(0) {}
+    TopOfBookSnapshot(const TopOfBookSnapshot&) noexcept = default;
+    TopOfBookSnapshot(TopOfBookSnapshot&&) noexcept = default;
+    ~TopOfBookSnapshot() noexcept = default;
+
+    TopOfBookSnapshot& operator=(const TopOfBookSnapshot&) noexcept = default;
+    TopOfBookSnapshot& operator=(TopOfBookSnapshot&&) noexcept = default;
+
+    template <class TOutputStream>
+    friend TOutputStream& operator<<(TOutputStream& stream, const TopOfBookSnapshot& snapshot);
+};
+
+//! Top of the order book
+/*!
+    Top of the order book keeps the best bid and ask prices, their visible
+    volumes and the last trade price of the order book in one cache line
+    protected by a sequence lock. Market manager publishes it after each
+    price level update of the order book, skipping updates which do not
+    change the top of the order book.
+
+    Readers take consistent snapshots without locks. The reader retries when
+    the market manager publishes the top of the order book concurrently, so
+    the market manager is never blocked by readers. Prices of empty order
+    book sides are zero.
+
+    Thread-safe for any number of readers and one writer.
+*/
+class alignas(64) TopOfBook
+{
+public:
+    TopOfBook() noexcept;
+    TopOfBook(const TopOfBook&) = delete;
+    TopOfBook(TopOfBook&&) = delete;
+    ~TopOfBook() noexcept = default;
+
+    TopOfBook& operator=(const TopOfBook&) = delete;
+    TopOfBook& operator=(TopOfBook&&) = delete;
+
+    //! Get the top of the order book version
+    uint64_t version() const noexcept { return _sequence.load(std::memory_order_acquire) / 2; }
+
+    //! Take the consistent top of the order book snapshot
+    /*!
+        Spins while the top of the order book is published concurrently.
+
+        \return Top of the order book snapshot
+    */
+    TopOfBookSnapshot Read() const noexcept;
+    //! Try to take the consistent top of the order book snapshot
+    /*!
+        \param snapshot - Top of the order book snapshot
+        \return 'true' if the snapshot is consistent, 'false' if the top of the order book was published concurrently
+    */
+    bool TryRead(TopOfBookSnapshot& snapshot) const noexcept;
+
+    //! Publish the top of the order book
+    /*!
+        Must be called only from the market manager thread.
+
+        \param bid_price - Best bid price
+        \param bid_volume - Best bid visible volume
+        \param ask_price - Best ask price
+        \param ask_volume - Best ask visible volume
+        \param last_price - Last trade price
+    */
+    void Publish(PriceValue bid_price, VolumeValue bid_volume, PriceValue ask_price, VolumeValue ask_volume, PriceValue last_price) noexcept;
+
+private:
+    static_assert(sizeof(PriceValue) <= sizeof(uint64_t), "Price value must fit into 64-bit atomic!");
+    static_assert(sizeof(VolumeValue) <= sizeof(uint64_t), "Volume value must fit into 64-bit atomic!");
+
+    std::atomic<uint64_t> _sequence;
+    std::atomic<uint64_t> _bid_price;
+    std::atomic<uint64_t> _bid_volume;
+    std::atomic<uint64_t> _ask_price;
+    std::atomic<uint64_t> _ask_volume;
+    std::atomic<uint64_t> _last_price;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "top_of_book.inl"
+
+#endif // CPPTRADER_MATCHING_TOP_OF_BOOK_H
@@ -0,0 +1,86 @@
+/*!
+    \file top_of_book.inl
+    \brief Top of the order book inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, const TopOfBookSnapshot& snapshot)
+{
+    stream << "TopOfBook(BidPrice=" << snapshot.BidPrice
+        << "; BidVolume=" << snapshot.BidVolume
+        << "; AskPrice=" << snapshot.AskPrice
+        << "; AskVolume=" << snapshot.AskVolume
+        << "; LastPrice=" << snapshot.LastPrice
+        << "; Version=" << snapshot.Version
+        << ")";
+    return stream;
+}
+
+inline TopOfBook::TopOfBook() noexcept
+    : _sequence(0),
+      _bid_price(0),
+      _bid_volume(0),
+      _ask_price(0),
+      _ask_volume(0),
+      _last_price(0)
+{
+}
+
+inline TopOfBookSnapshot TopOfBook::Read() const noexcept
+{
+    TopOfBookSnapshot snapshot;
+    while (!TryRead(snapshot))
+        continue;
+    return snapshot;
+}
+
+inline bool TopOfBook::TryRead(TopOfBookSnapshot& snapshot) const noexcept
+{
+    // Odd sequence means the top of the order book is being published
+    uint64_t sequence = _sequence.load(std::memory_order_acquire);
+    if ((sequence & 1) != 0)
+        return false;
+
+    snapshot.BidPrice = (PriceValue)_bid_price.load(std::memory_order_relaxed);
+    snapshot.BidVolume = (VolumeValue)_bid_volume.load(std::memory_order_relaxed);
+    snapshot.AskPrice = (PriceValue)_ask_price.load(std::memory_order_relaxed);
+    snapshot.AskVolume = (VolumeValue)_ask_volume.load(std::memory_order_relaxed);
+    snapshot.LastPrice = (PriceValue)_last_price.load(std::memory_order_relaxed);
+    snapshot.Version = sequence / 2;
+
+    // Check that the top of the order book was not published while reading
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return (_sequence.load(std::memory_order_relaxed) == sequence);
+}
+
+inline void TopOfBook::Publish(PriceValue bid_price, VolumeValue bid_volume, PriceValue ask_price, VolumeValue ask_volume, PriceValue last_price) noexcept
+{
+    // Skip publishing of the unchanged top of the order book, so readers do not retry
+    if ((_bid_price.load(std::memory_order_relaxed) == (uint64_t)bid_price) &&
+        (_bid_volume.load(std::memory_order_relaxed) == (uint64_t)bid_volume) &&
+        (_ask_price.load(std::memory_order_relaxed) == (uint64_t)ask_price) &&
+        (_ask_volume.load(std::memory_order_relaxed) == (uint64_t)ask_volume) &&
+        (_last_price.load(std::memory_order_relaxed) == (uint64_t)last_price))
+        return;
+
+    uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _bid_price.store((uint64_t)bid_price, std::memory_order_relaxed);
+    _bid_volume.store((uint64_t)bid_volume, std::memory_order_relaxed);
+    _ask_price.store((uint64_t)ask_price, std::memory_order_relaxed);
+    _ask_volume.store((uint64_t)ask_volume, std::memory_order_relaxed);
+    _last_price.store((uint64_t)last_price, std::memory_order_relaxed);
+
+    _sequence.store(sequence + 2, std::memory_order_release);
+}
+
+} // namespace Matching
+} // namespace CppTrader
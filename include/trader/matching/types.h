@@ -0,0 +1,75 @@
+/*!
+    \file types.h
+    \brief Matching engine numeric types definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_TYPES_H
+#define CPPTRADER_MATCHING_TYPES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/*!
+    Matching engine numeric types could be narrowed for feeds with small
+    values (e.g. 32-bit prices and quantities of NASDAQ ITCH) by defining
+    the following macros for the library and all its users:
+    \li CPPTRADER_MATCHING_ORDER_ID_TYPE - Order Id type (default is uint64_t)
+    \li CPPTRADER_MATCHING_PRICE_TYPE - Price type (default is uint64_t)
+    \li CPPTRADER_MATCHING_QUANTITY_TYPE - Order quantity type (default is uint64_t)
+    \li CPPTRADER_MATCHING_VOLUME_TYPE - Price level volume type (default is uint64_t)
+    \li CPPTRADER_MATCHING_COUNT_TYPE - Price level orders count type (default is size_t)
+*/
+#if !defined(CPPTRADER_MATCHING_ORDER_ID_TYPE)
+#define CPPTRADER_MATCHING_ORDER_ID_TYPE uint64_t
+#endif
+#if !defined(CPPTRADER_MATCHING_PRICE_TYPE)
+#define CPPTRADER_MATCHING_PRICE_TYPE uint64_t
+#endif
+#if !defined(CPPTRADER_MATCHING_QUANTITY_TYPE)
+#define CPPTRADER_MATCHING_QUANTITY_TYPE uint64_t
+#endif
+#if !defined(CPPTRADER_MATCHING_VOLUME_TYPE)
+#define CPPTRADER_MATCHING_VOLUME_TYPE uint64_t
+#endif
+#if !defined(CPPTRADER_MATCHING_COUNT_TYPE)
+#define CPPTRADER_MATCHING_COUNT_TYPE size_t
+#endif
+
+namespace CppTrader {
+namespace Matching {
+
+//! Order Id value type
+typedef CPPTRADER_MATCHING_ORDER_ID_TYPE OrderIdValue;
+//! Price value type
+typedef CPPTRADER_MATCHING_PRICE_TYPE PriceValue;
+//! Order quantity value type
+typedef CPPTRADER_MATCHING_QUANTITY_TYPE QuantityValue;
+//! Price level volume value type
+typedef CPPTRADER_MATCHING_VOLUME_TYPE VolumeValue;
+//! Price level orders count value type
+typedef CPPTRADER_MATCHING_COUNT_TYPE CountValue;
+
+static_assert(!std::numeric_limits<OrderIdValue>::is_signed, "Order Id type must be unsigned!");
+static_assert(!std::numeric_limits<PriceValue>::is_signed, "Price type must be unsigned!");
+static_assert(!std::numeric_limits<QuantityValue>::is_signed, "Quantity type must be unsigned!");
+static_assert(std::numeric_limits<VolumeValue>::max() >= std::numeric_limits<QuantityValue>::max(), "Volume type must be not narrower than quantity type!");
+
+//! Check if the given value fits into the given numeric type
+/*!
+    \param value - Value to check
+    \return 'true' if the value fits into the given numeric type, 'false' otherwise
+*/
+template <typename T>
+constexpr bool IsRepresentable(uint64_t value) noexcept
+{
+    return value <= (uint64_t)std::numeric_limits<T>::max();
+}
+
+} // namespace Matching
+} // namespace CppTrader
+
+#endif // CPPTRADER_MATCHING_TYPES_H
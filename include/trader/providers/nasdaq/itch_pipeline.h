@@ -0,0 +1,203 @@
+/*!
+    \file itch_pipeline.h
+    \brief NASDAQ ITCH pipeline definition
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_ITCH_PIPELINE_H
+#define CPPTRADER_ITCH_PIPELINE_H
+
+#include "itch_handler.h"
+
+#include "trader/matching/market_manager.h"
+
+#include "threads/thread.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <thread>
+
+namespace CppTrader {
+namespace ITCH {
+
+//! NASDAQ ITCH pipeline class
+/*!
+    NASDAQ ITCH pipeline splits market data processing into two stages which
+    run on separate CPU cores. The first stage runs in the caller thread and
+    decodes NASDAQ ITCH messages into compact fixed-size commands stored in
+    a ring buffer. The second stage runs in the worker thread and applies
+    decoded commands to the market manager in batches.
+
+    Both stages exchange ring buffer positions once per batch. The decoder
+    waits for the worker thread while the ring buffer is full, so the memory
+    used by the pipeline is bounded. Flush() method is the drain barrier: it
+    returns when all decoded commands are applied to the market manager.
+
+    Market handler of the market manager is called in the worker thread. The
+    market manager must not be accessed from other threads while the pipeline
+    is started.
+
+    Not thread-safe, all methods must be called from the same thread.
+*/
+template <class TLevels>
+class ITCHPipelineT : public ITCHHandler
+{
+public:
+    //! Market manager
+    typedef Matching::MarketManagerT<TLevels> MarketManager;
+
+    //! Initialize the ITCH pipeline
+    /*!
+        \param market - Market manager to apply decoded commands
+        \param capacity - Commands ring buffer capacity, must be a power of two (default is 65536)
+        \param batch - Maximal count of commands exchanged between pipeline stages at once (default is 256)
+    */
+    explicit ITCHPipelineT(MarketManager& market, size_t capacity = 65536, size_t batch = 256);
+    ITCHPipelineT(const ITCHPipelineT&) = delete;
+    ITCHPipelineT(ITCHPipelineT&&) = delete;
+    ~ITCHPipelineT();
+
+    ITCHPipelineT& operator=(const ITCHPipelineT&) = delete;
+    ITCHPipelineT& operator=(ITCHPipelineT&&) = delete;
+
+    //! Get the market manager
+    MarketManager& market() noexcept { return _market; }
+
+    //! Get the commands ring buffer capacity
+    size_t capacity() const noexcept { return _ring.size(); }
+    //! Get the commands batch size
+    size_t batch() const noexcept { return _batch; }
+
+    //! Get the count of processed ITCH messages
+    size_t messages() const noexcept { return _messages; }
+    //! Get the count of unknown ITCH messages
+    size_t errors() const noexcept { return _errors; }
+    //! Get the count of decoded commands
+    uint64_t decoded() const noexcept { return _decoded; }
+    //! Get the count of applied commands
+    uint64_t applied() const noexcept { return _applied.load(std::memory_order_acquire); }
+
+    //! Is the ITCH pipeline started?
+    bool IsStarted() const noexcept { return _started; }
+
+    //! Start the worker thread
+    /*!
+        \param pin - Pin the worker thread to the CPU core 1, if there are several CPU cores (default is false)
+        \return 'true' if the worker thread was successfully started, 'false' if it is already started
+    */
+    bool Start(bool pin = false);
+    //! Flush and stop the worker thread
+    /*!
+        \return 'true' if the worker thread was successfully stopped, 'false' if it is already stopped
+    */
+    bool Stop();
+
+    //! Process all messages from the given buffer in ITCH format and pass decoded commands to the worker thread
+    /*!
+        \param buffer - Buffer to process
+        \param size - Buffer size
+        \return 'true' if the given buffer was successfully processed, 'false' if the given buffer process was failed
+    */
+    bool Process(void* buffer, size_t size);
+
+    //! Wait for the worker thread to apply all decoded commands
+    void Flush();
+
+protected:
+    // Message handlers
+    bool onMessage(const SystemEventMessage& message) override { ++_messages; return true; }
+    bool onMessage(const StockDirectoryMessage& message) override;
+    bool onMessage(const StockTradingActionMessage& message) override { ++_messages; return true; }
+    bool onMessage(const RegSHOMessage& message) override { ++_messages; return true; }
+    bool onMessage(const MarketParticipantPositionMessage& message) override { ++_messages; return true; }
+    bool onMessage(const MWCBDeclineMessage& message) override { ++_messages; return true; }
+    bool onMessage(const MWCBStatusMessage& message) override { ++_messages; return true; }
+    bool onMessage(const IPOQuotingMessage& message) override { ++_messages; return true; }
+    bool onMessage(const AddOrderMessage& message) override;
+    bool onMessage(const AddOrderMPIDMessage& message) override;
+    bool onMessage(const OrderExecutedMessage& message) override;
+    bool onMessage(const OrderExecutedWithPriceMessage& message) override;
+    bool onMessage(const OrderCancelMessage& message) override;
+    bool onMessage(const OrderDeleteMessage& message) override;
+    bool onMessage(const OrderReplaceMessage& message) override;
+    bool onMessage(const TradeMessage& message) override { ++_messages; return true; }
+    bool onMessage(const CrossTradeMessage& message) override { ++_messages; return true; }
+    bool onMessage(const BrokenTradeMessage& message) override { ++_messages; return true; }
+    bool onMessage(const NOIIMessage& message) override { ++_messages; return true; }
+    bool onMessage(const RPIIMessage& message) override { ++_messages; return true; }
+    bool onMessage(const LULDAuctionCollarMessage& message) override { ++_messages; return true; }
+    bool onMessage(const UnknownMessage& message) override { ++_errors; return true; }
+
+private:
+    enum class CommandType : uint8_t
+    {
+        ADD_SYMBOL,
+        ADD_ORDER,
+        REDUCE_ORDER,
+        DELETE_ORDER,
+        REPLACE_ORDER,
+        EXECUTE_ORDER,
+        EXECUTE_ORDER_PRICE
+    };
+
+    // Command fits into the half of the cache line
+    struct Command
+    {
+        uint64_t Id;
+        union
+        {
+            uint64_t NewId;
+            char Name[8];
+        };
+        uint32_t Price;
+        uint32_t Quantity;
+        uint16_t SymbolId;
+        CommandType Type;
+        Matching::OrderSide Side;
+    };
+
+    static_assert(sizeof(Command) == 32, "ITCH pipeline command must be 32 bytes!");
+
+    MarketManager& _market;
+
+    // Commands ring buffer
+    std::vector<Command> _ring;
+    size_t _mask;
+    size_t _batch;
+
+    // Decoder position published to the worker thread
+    alignas(64) std::atomic<uint64_t> _published;
+    // Worker thread position published to the decoder
+    alignas(64) std::atomic<uint64_t> _applied;
+
+    // Decoder state
+    alignas(64) uint64_t _decoded;
+    uint64_t _available;
+    size_t _messages;
+    size_t _errors;
+
+    // Worker thread
+    std::thread _thread;
+    std::atomic<bool> _running;
+    bool _started;
+
+    Command& Prepare();
+    void Submit();
+    void Publish() noexcept;
+
+    void Run(int cpu);
+    void Apply(const Command& command);
+};
+
+//! NASDAQ ITCH pipeline with the default price level container
+typedef ITCHPipelineT<Matching::LevelLadder> ITCHPipeline;
+
+} // namespace ITCH
+} // namespace CppTrader
+
+#include "itch_pipeline.inl"
+
+#endif // CPPTRADER_ITCH_PIPELINE_H
@@ -0,0 +1,147 @@
+/*!
+    \file itch_pipeline.inl
+    \brief NASDAQ ITCH pipeline inline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace ITCH {
+
+template <class TLevels>
+inline typename ITCHPipelineT<TLevels>::Command& ITCHPipelineT<TLevels>::Prepare()
+{
+    assert(IsStarted() && "ITCH pipeline must be started before processing messages!");
+
+    // Wait for the worker thread while the commands ring buffer is full
+    if (_decoded == _available)
+    {
+        Publish();
+        while ((_available = _applied.load(std::memory_order_acquire) + _ring.size()) == _decoded)
+            CppCommon::Thread::Yield();
+    }
+
+    return _ring[_decoded & _mask];
+}
+
+template <class TLevels>
+inline void ITCHPipelineT<TLevels>::Submit()
+{
+    // Publish decoded commands once per batch
+    if ((++_decoded - _published.load(std::memory_order_relaxed)) >= _batch)
+        Publish();
+}
+
+template <class TLevels>
+inline void ITCHPipelineT<TLevels>::Publish() noexcept
+{
+    _published.store(_decoded, std::memory_order_release);
+}
+
+template <class TLevels>
+inline bool ITCHPipelineT<TLevels>::onMessage(const StockDirectoryMessage& message)
+{
+    ++_messages;
+    Command& command = Prepare();
+    command.Type = CommandType::ADD_SYMBOL;
+    command.SymbolId = message.StockLocate;
+    std::memcpy(command.Name, message.Stock, sizeof(command.Name));
+    Submit();
+    return true;
+}
+
+template <class TLevels>
+inline bool ITCHPipelineT<TLevels>::onMessage(const AddOrderMessage& message)
+{
+    ++_messages;
+    Command& command = Prepare();
+    command.Type = CommandType::ADD_ORDER;
+    command.Id = message.OrderReferenceNumber;
+    command.SymbolId = message.StockLocate;
+    command.Side = (message.BuySellIndicator == 'B') ? Matching::OrderSide::BUY : Matching::OrderSide::SELL;
+    command.Price = message.Price;
+    command.Quantity = message.Shares;
+    Submit();
+    return true;
+}
+
+template <class TLevels>
+inline bool ITCHPipelineT<TLevels>::onMessage(const AddOrderMPIDMessage& message)
+{
+    ++_messages;
+    Command& command = Prepare();
+    command.Type = CommandType::ADD_ORDER;
+    command.Id = message.OrderReferenceNumber;
+    command.SymbolId = message.StockLocate;
+    command.Side = (message.BuySellIndicator == 'B') ? Matching::OrderSide::BUY : Matching::OrderSide::SELL;
+    command.Price = message.Price;
+    command.Quantity = message.Shares;
+    Submit();
+    return true;
+}
+
+template <class TLevels>
+inline bool ITCHPipelineT<TLevels>::onMessage(const OrderExecutedMessage& message)
+{
+    ++_messages;
+    Command& command = Prepare();
+    command.Type = CommandType::EXECUTE_ORDER;
+    command.Id = message.OrderReferenceNumber;
+    command.Quantity = message.ExecutedShares;
+    Submit();
+    return true;
+}
+
+template <class TLevels>
+inline bool ITCHPipelineT<TLevels>::onMessage(const OrderExecutedWithPriceMessage& message)
+{
+    ++_messages;
+    Command& command = Prepare();
+    command.Type = CommandType::EXECUTE_ORDER_PRICE;
+    command.Id = message.OrderReferenceNumber;
+    command.Price = message.ExecutionPrice;
+    command.Quantity = message.ExecutedShares;
+    Submit();
+    return true;
+}
+
+template <class TLevels>
+inline bool ITCHPipelineT<TLevels>::onMessage(const OrderCancelMessage& message)
+{
+    ++_messages;
+    Command& command = Prepare();
+    command.Type = CommandType::REDUCE_ORDER;
+    command.Id = message.OrderReferenceNumber;
+    command.Quantity = message.CanceledShares;
+    Submit();
+    return true;
+}
+
+template <class TLevels>
+inline bool ITCHPipelineT<TLevels>::onMessage(const OrderDeleteMessage& message)
+{
+    ++_messages;
+    Command& command = Prepare();
+    command.Type = CommandType::DELETE_ORDER;
+    command.Id = message.OrderReferenceNumber;
+    Submit();
+    return true;
+}
+
+template <class TLevels>
+inline bool ITCHPipelineT<TLevels>::onMessage(const OrderReplaceMessage& message)
+{
+    ++_messages;
+    Command& command = Prepare();
+    command.Type = CommandType::REPLACE_ORDER;
+    command.Id = message.OriginalOrderReferenceNumber;
+    command.NewId = message.NewOrderReferenceNumber;
+    command.Price = message.Price;
+    command.Quantity = message.Shares;
+    Submit();
+    return true;
+}
+
+} // namespace ITCH
+} // namespace CppTrader
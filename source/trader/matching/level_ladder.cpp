@@ -0,0 +1,148 @@
+/*!
+    \file level_ladder.cpp
+    \brief Price level ladder implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/level_ladder.h"
+
+namespace CppTrader {
+namespace Matching {
+
+LevelLadder::LevelLadder(LevelType type, size_t size, uint64_t tick)
+    : _type(type),
+      _size(0),
+      _best(nullptr),
+      _tick((tick > 0) ? tick : 1),
+      _base(0),
+      _count(0),
+      _slots(size, nullptr),
+      _bitmap(size)
+{
+}
+
+void LevelLadder::insert(LevelNode& level)
+{
+    assert((find(level.Price) == nullptr) && "Price level with the same price already exists!");
+
+    // Insert the price level into the ladder slot or into the overflow tree
+    if (IsSlot(level.Price))
+    {
+        size_t slot = GetSlot(level.Price);
+        _slots[slot] = &level;
+        _bitmap.set(slot);
+        ++_count;
+    }
+    else
+        _overflow.insert(level);
+    ++_size;
+
+    // Update the best price level by the ladder type
+    if ((_best == nullptr) || ((_type == LevelType::BID) ? (level.Price > _best->Price) : (level.Price < _best->Price)))
+    {
+        _best = &level;
+
+        // Recentre the ladder window on the new best price
+        if (!IsCentered(_best->Price))
+            recenter(_best->Price);
+    }
+}
+
+void LevelLadder::erase(LevelNode& level)
+{
+    // Update the best price level by the ladder type
+    if (&level == _best)
+        _best = (_type == LevelType::BID) ? lower(&level) : higher(&level);
+
+    // Erase the price level from the ladder slot or from the overflow tree
+    if (IsSlot(level.Price))
+    {
+        size_t slot = GetSlot(level.Price);
+        assert((_slots[slot] == &level) && "Price level is not found in the ladder!");
+        _slots[slot] = nullptr;
+        _bitmap.reset(slot);
+        --_count;
+    }
+    else
+        _overflow.erase(Overflow::iterator(&_overflow, &level));
+    --_size;
+
+    // Recentre the ladder window on the new best price
+    if ((_best != nullptr) && !IsCentered(_best->Price))
+        recenter(_best->Price);
+}
+
+void LevelLadder::recenter(PriceValue price)
+{
+    if (_slots.empty())
+        return;
+
+    // Calculate a new ladder window base
+    uint64_t tick = price / _tick;
+    uint64_t half = _slots.size() / 2;
+    uint64_t limit = std::numeric_limits<PriceValue>::max() / _tick - _slots.size();
+    uint64_t base = std::min((tick > half) ? (tick - half) : 0, limit);
+    if (base == _base)
+        return;
+
+    std::vector<LevelNode*> slots(_slots.size(), nullptr);
+
+    // Move price levels from the old window into the new window or into the overflow tree
+    for (auto level_ptr : _slots)
+    {
+        if (level_ptr == nullptr)
+            continue;
+
+        uint64_t level_tick = level_ptr->Price / _tick;
+        if ((level_tick >= base) && ((level_tick - base) < slots.size()))
+            slots[level_tick - base] = level_ptr;
+        else
+        {
+            _overflow.insert(*level_ptr);
+            --_count;
+        }
+    }
+
+    // Move overflow price levels which fit into the new window
+    auto it = _overflow.lower_bound(LevelNode(_type, base * _tick));
+    while (it != _overflow.end())
+    {
+        LevelNode* level_ptr = it.operator->();
+        uint64_t level_tick = level_ptr->Price / _tick;
+        if ((level_tick - base) >= slots.size())
+            break;
+
+        if ((level_ptr->Price % _tick) == 0)
+        {
+            slots[level_tick - base] = level_ptr;
+            it = _overflow.erase(it);
+            ++_count;
+        }
+        else
+            ++it;
+    }
+
+    _slots.swap(slots);
+    _base = base;
+
+    // Rebuild the occupied slots bitmap
+    _bitmap.clear();
+    for (size_t slot = 0; slot < _slots.size(); ++slot)
+        if (_slots[slot] != nullptr)
+            _bitmap.set(slot);
+}
+
+void LevelLadder::clear() noexcept
+{
+    std::fill(_slots.begin(), _slots.end(), nullptr);
+    _bitmap.clear();
+    _overflow.clear();
+    _size = 0;
+    _count = 0;
+    _best = nullptr;
+}
+
+} // namespace Matching
+} // namespace CppTrader
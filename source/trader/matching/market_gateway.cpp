@@ -0,0 +1,134 @@
+/*!
+    \file market_gateway.cpp
+    \brief Market gateway implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_gateway.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TLevels>
+MarketGatewayT<TLevels>::MarketGatewayT(MarketManager& market, size_t capacity, size_t batch)
+    : _market(market),
+      _ring(new Slot[capacity]),
+      _mask(capacity - 1),
+      _batch(std::max(batch, (size_t)1)),
+      _tail(0),
+      _head(0)
+{
+    assert((capacity > 1) && ((capacity & (capacity - 1)) == 0) && "Commands ring capacity must be a power of two!");
+
+    // Each slot is free for the command of its own index
+    for (size_t i = 0; i < capacity; ++i)
+        _ring[i].Turn.store(i, std::memory_order_relaxed);
+}
+
+template <class TLevels>
+ErrorCode MarketGatewayT<TLevels>::AddOrder(const Order& order, MarketCompletion* completion)
+{
+    // Validate order parameters
+    ErrorCode result = order.Validate();
+    if (result != ErrorCode::OK)
+        return result;
+
+    Command command;
+    command.Type = CommandType::ADD_ORDER;
+    command.Id = order.Id;
+    command.OrderData = order;
+    command.Completion = completion;
+    Submit(command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode MarketGatewayT<TLevels>::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity, MarketCompletion* completion)
+{
+    Command command;
+    command.Type = CommandType::MODIFY_ORDER;
+    command.Id = id;
+    command.Price = new_price;
+    command.Quantity = new_quantity;
+    command.Completion = completion;
+    Submit(command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode MarketGatewayT<TLevels>::DeleteOrder(uint64_t id, MarketCompletion* completion)
+{
+    Command command;
+    command.Type = CommandType::DELETE_ORDER;
+    command.Id = id;
+    command.Completion = completion;
+    Submit(command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+size_t MarketGatewayT<TLevels>::Process()
+{
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    uint64_t last = head + _batch;
+
+    size_t applied = 0;
+    for (; head < last; ++head)
+    {
+        // Stop on the first slot which is not submitted yet
+        Slot& slot = _ring[head & _mask];
+        if (slot.Turn.load(std::memory_order_acquire) != (head + 1))
+            break;
+
+        const Command& command = slot.Data;
+        MarketCompletion* completion = command.Completion;
+        ErrorCode result = Apply(command);
+
+        // Report the command result and the order state after the command
+        if (completion != nullptr)
+        {
+            const Order* order_ptr = _market.GetOrder(command.Id);
+            completion->Result = result;
+            completion->Active = (order_ptr != nullptr);
+            if (order_ptr != nullptr)
+                completion->State = *order_ptr;
+            completion->_done.store(true, std::memory_order_release);
+        }
+
+        // Release the slot for session threads
+        slot.Turn.store(head + capacity(), std::memory_order_release);
+        ++applied;
+    }
+
+    _head.store(head, std::memory_order_release);
+    return applied;
+}
+
+template <class TLevels>
+ErrorCode MarketGatewayT<TLevels>::Apply(const Command& command)
+{
+    switch (command.Type)
+    {
+        case CommandType::ADD_ORDER:
+            return _market.AddOrder(command.OrderData);
+        case CommandType::MODIFY_ORDER:
+            return _market.ModifyOrder(command.Id, command.Price, command.Quantity);
+        case CommandType::DELETE_ORDER:
+            return _market.DeleteOrder(command.Id);
+        default:
+            return ErrorCode::OK;
+    }
+}
+
+// Explicit instantiation of the market gateway for the supported price level containers
+template class MarketGatewayT<LevelTree>;
+template class MarketGatewayT<LevelVector>;
+template class MarketGatewayT<LevelLadder>;
+
+} // namespace Matching
+} // namespace CppTrader
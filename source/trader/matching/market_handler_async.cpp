@@ -0,0 +1,401 @@
+/*!
+    \file market_handler_async.cpp
+    \brief Asynchronous market handler implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_handler_async.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TLevels>
+AsyncMarketHandlerT<TLevels>::AsyncMarketHandlerT(size_t capacity, AsyncPolicy policy)
+    : _policy(policy),
+      _ring(new Slot[capacity]),
+      _mask(capacity - 1),
+      _tail(0),
+      _lost(0),
+      _dropped(0),
+      _head(0),
+      _consumed(0),
+      _running(false),
+      _started(false)
+{
+    assert((capacity > 1) && ((capacity & (capacity - 1)) == 0) && "Events ring capacity must be a power of two!");
+
+    // Each slot is free for the event of its own index
+    for (size_t i = 0; i < capacity; ++i)
+        _ring[i].Turn.store(i, std::memory_order_relaxed);
+
+    // Reserve conflated updates to avoid allocations on the first overload
+    if (_policy == AsyncPolicy::CONFLATE)
+        _conflated.reserve(std::min(capacity, (size_t)1024));
+}
+
+template <class TLevels>
+AsyncMarketHandlerT<TLevels>::~AsyncMarketHandlerT()
+{
+    Stop();
+}
+
+template <class TLevels>
+bool AsyncMarketHandlerT<TLevels>::Start(size_t consumers)
+{
+    if (IsStarted())
+        return false;
+
+    _running = true;
+    for (size_t i = 0; i < std::max(consumers, (size_t)1); ++i)
+        _threads.emplace_back(CppCommon::Thread::Start([this]() { Run(); }));
+
+    _started = true;
+    return true;
+}
+
+template <class TLevels>
+bool AsyncMarketHandlerT<TLevels>::Stop()
+{
+    if (!IsStarted())
+        return false;
+
+    // Handle all published events before stopping
+    Flush();
+
+    _running = false;
+    for (auto& thread : _threads)
+        thread.join();
+    _threads.clear();
+
+    _started = false;
+    return true;
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::Flush()
+{
+    if (!IsStarted())
+        return;
+
+    while (!TryPublishConflated())
+        CppCommon::Thread::Yield();
+
+    // Dropped events will never be consumed
+    while ((_consumed.load(std::memory_order_acquire) + _dropped) < _tail.load(std::memory_order_relaxed))
+        CppCommon::Thread::Yield();
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::Publish(const MarketEvent& event)
+{
+    // Conflated updates must be published before any later event
+    if (!TryPublishConflated())
+    {
+        if (event.IsConflatable())
+        {
+            Conflate(event);
+            return;
+        }
+
+        while (!TryPublishConflated())
+            CppCommon::Thread::Yield();
+    }
+
+    if (TryPublish(event))
+        return;
+
+    // Events ring is full
+    switch (_policy)
+    {
+        case AsyncPolicy::DROP_OLDEST:
+        {
+            for (;;)
+            {
+                if (TryPublish(event))
+                    return;
+
+                // Claim the oldest event before consumers and replace it with the new one
+                uint64_t tail = _tail.load(std::memory_order_relaxed);
+                uint64_t oldest = tail - capacity();
+                if (_head.compare_exchange_strong(oldest, oldest + 1, std::memory_order_acq_rel))
+                {
+                    Slot& slot = _ring[tail & _mask];
+                    slot.Event = event;
+                    slot.Turn.store(tail + 1, std::memory_order_release);
+                    _tail.store(tail + 1, std::memory_order_release);
+                    ++_dropped;
+                    Lose();
+                    return;
+                }
+
+                CppCommon::Thread::Yield();
+            }
+        }
+        case AsyncPolicy::CONFLATE:
+            if (event.IsConflatable())
+            {
+                Conflate(event);
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Wait for consumers
+    while (!TryPublish(event))
+        CppCommon::Thread::Yield();
+}
+
+template <class TLevels>
+bool AsyncMarketHandlerT<TLevels>::TryPublishConflated()
+{
+    if (_conflated.empty())
+        return true;
+
+    size_t count = 0;
+    while ((count < _conflated.size()) && TryPublish(_conflated[count]))
+        ++count;
+    _conflated.erase(_conflated.begin(), _conflated.begin() + count);
+
+    return _conflated.empty();
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::Conflate(const MarketEvent& event)
+{
+    // Replace the earlier update of the same order book or price level
+    for (auto& conflated : _conflated)
+    {
+        if (conflated.IsConflatable(event))
+        {
+            bool top = conflated.Top || event.Top;
+            conflated = event;
+            conflated.Top = top;
+            Lose();
+            return;
+        }
+    }
+
+    _conflated.push_back(event);
+}
+
+template <class TLevels>
+bool AsyncMarketHandlerT<TLevels>::TryConsume(uint64_t& sequence, MarketEvent& event) noexcept
+{
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Slot& slot = _ring[head & _mask];
+        int64_t diff = (int64_t)(slot.Turn.load(std::memory_order_acquire) - (head + 1));
+        if (diff == 0)
+        {
+            // Claim the event and release its slot for the market manager thread
+            if (_head.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                event = slot.Event;
+                sequence = head;
+                slot.Turn.store(head + capacity(), std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Events ring is empty
+            return false;
+        }
+        else
+        {
+            // Event was claimed by another consumer or dropped
+            head = _head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::Run()
+{
+    uint64_t sequence;
+    MarketEvent event;
+    for (;;)
+    {
+        if (TryConsume(sequence, event))
+        {
+            onMarketEvent(sequence, event);
+            _consumed.fetch_add(1, std::memory_order_release);
+            continue;
+        }
+
+        // Stop only when all published events are handled
+        if (!_running.load(std::memory_order_acquire))
+            break;
+
+        CppCommon::Thread::Yield();
+    }
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::PublishOrderBook(MarketEventType type, const OrderBook& order_book, bool top)
+{
+    MarketEvent event;
+    event.Type = type;
+    event.Top = top;
+    event.SymbolId = order_book.symbol().Id;
+    event.OrderBookData.BidPrice = (order_book.best_bid() != nullptr) ? order_book.best_bid()->Price : 0;
+    event.OrderBookData.BidVolume = (order_book.best_bid() != nullptr) ? order_book.best_bid()->VisibleVolume : 0;
+    event.OrderBookData.AskPrice = (order_book.best_ask() != nullptr) ? order_book.best_ask()->Price : 0;
+    event.OrderBookData.AskVolume = (order_book.best_ask() != nullptr) ? order_book.best_ask()->VisibleVolume : 0;
+    Publish(event);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::PublishLevel(MarketEventType type, const OrderBook& order_book, const Level& level, bool top)
+{
+    MarketEvent event;
+    event.Type = type;
+    event.Top = top;
+    event.SymbolId = order_book.symbol().Id;
+    event.LevelData.Price = level.Price;
+    event.LevelData.TotalVolume = level.TotalVolume;
+    event.LevelData.HiddenVolume = level.HiddenVolume;
+    event.LevelData.VisibleVolume = level.VisibleVolume;
+    event.LevelData.Orders = level.Orders;
+    event.LevelData.Type = level.Type;
+    Publish(event);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::PublishOrder(MarketEventType type, const Order& order)
+{
+    MarketEvent event;
+    event.Type = type;
+    event.SymbolId = order.SymbolId;
+    event.OrderData.Id = order.Id;
+    event.OrderData.Price = order.Price;
+    event.OrderData.Quantity = order.Quantity;
+    event.OrderData.ExecutedQuantity = order.ExecutedQuantity;
+    event.OrderData.LeavesQuantity = order.LeavesQuantity;
+    event.OrderData.Type = order.Type;
+    event.OrderData.Side = order.Side;
+    Publish(event);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onAddSymbol(const Symbol& symbol)
+{
+    MarketEvent event;
+    event.Type = MarketEventType::ADD_SYMBOL;
+    event.SymbolId = symbol.Id;
+    std::memcpy(event.SymbolName, symbol.Name, sizeof(event.SymbolName));
+    Publish(event);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onDeleteSymbol(const Symbol& symbol)
+{
+    MarketEvent event;
+    event.Type = MarketEventType::DELETE_SYMBOL;
+    event.SymbolId = symbol.Id;
+    std::memcpy(event.SymbolName, symbol.Name, sizeof(event.SymbolName));
+    Publish(event);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onAddOrderBook(const OrderBook& order_book)
+{
+    PublishOrderBook(MarketEventType::ADD_ORDER_BOOK, order_book, false);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onUpdateOrderBook(const OrderBook& order_book, bool top, int symbol_id)
+{
+    PublishOrderBook(MarketEventType::UPDATE_ORDER_BOOK, order_book, top);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onDeleteOrderBook(const OrderBook& order_book)
+{
+    PublishOrderBook(MarketEventType::DELETE_ORDER_BOOK, order_book, false);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onAddLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    PublishLevel(MarketEventType::ADD_LEVEL, order_book, level, top);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onUpdateLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    PublishLevel(MarketEventType::UPDATE_LEVEL, order_book, level, top);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onDeleteLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    PublishLevel(MarketEventType::DELETE_LEVEL, order_book, level, top);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onAddOrder(const Order& order)
+{
+    PublishOrder(MarketEventType::ADD_ORDER, order);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onUpdateOrder(const Order& order)
+{
+    PublishOrder(MarketEventType::UPDATE_ORDER, order);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onDeleteOrder(const Order& order)
+{
+    PublishOrder(MarketEventType::DELETE_ORDER, order);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity)
+{
+    MarketEvent event;
+    event.Type = MarketEventType::EXECUTE_ORDER;
+    event.SymbolId = order.SymbolId;
+    event.ExecutionData.Id = order.Id;
+    event.ExecutionData.Price = (PriceValue)price;
+    event.ExecutionData.Quantity = (QuantityValue)quantity;
+    event.ExecutionData.LeavesQuantity = order.LeavesQuantity;
+    event.ExecutionData.AggressorId = 0;
+    Publish(event);
+}
+
+template <class TLevels>
+void AsyncMarketHandlerT<TLevels>::onExecuteSweep(const Order& order, const Fill* fills, size_t count)
+{
+    // Sweep is published as executions of resting orders
+    MarketEvent event;
+    event.Type = MarketEventType::EXECUTE_ORDER;
+    event.SymbolId = order.SymbolId;
+    event.ExecutionData.LeavesQuantity = 0;
+    event.ExecutionData.AggressorId = order.Id;
+    for (size_t i = 0; i < count; ++i)
+    {
+        event.ExecutionData.Id = fills[i].Id;
+        event.ExecutionData.Price = fills[i].Price;
+        event.ExecutionData.Quantity = fills[i].Quantity;
+        Publish(event);
+    }
+}
+
+// Explicit instantiation of the asynchronous market handler for the supported price level containers
+template class AsyncMarketHandlerT<LevelTree>;
+template class AsyncMarketHandlerT<LevelVector>;
+template class AsyncMarketHandlerT<LevelLadder>;
+
+} // namespace Matching
+} // namespace CppTrader
@@ -11,13 +11,22 @@
 namespace CppTrader {
 namespace Matching {
 
-MarketHandler MarketManager::_default;
+template <class TLevels>
+typename MarketManagerT<TLevels>::MarketHandler MarketManagerT<TLevels>::_default;
 
-MarketManager::~MarketManager()
+template <class TLevels>
+MarketManagerT<TLevels>::~MarketManagerT()
 {
     // Release orders
     for (const auto& order : _orders)
-        _order_pool.Release(order.second);
+    {
+        OrderNode* order_ptr = order.second;
+
+        // Orders allocated in order book memory arenas are released together with order books
+        OrderBook* order_book_ptr = (order_ptr->SymbolId < _order_books.size()) ? _order_books[order_ptr->SymbolId] : nullptr;
+        if ((order_book_ptr == nullptr) || !order_book_ptr->has_arena())
+            _order_pool.Release(order_ptr);
+    }
     _orders.clear();
 
     // Release order books
@@ -33,7 +42,35 @@ MarketManager::~MarketManager()
     _symbols.clear();
 }
 
-ErrorCode MarketManager::AddSymbol(const Symbol& symbol)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::GetQueuePosition(uint64_t id, QueuePosition& position)
+{
+    // Validate parameters
+    assert((id > 0) && "Order Id must be greater than zero!");
+    if ((id == 0) || !IsRepresentable<OrderIdValue>(id))
+        return ErrorCode::ORDER_ID_INVALID;
+
+    // Get the order to locate
+    auto order_it = _orders.find((OrderIdValue)id);
+    if (order_it == _orders.end())
+        return ErrorCode::ORDER_NOT_FOUND;
+    OrderNode* order_ptr = (OrderNode*)order_it->second;
+
+    // Only limit orders are queued in the order book
+    if (!order_ptr->IsLimit())
+        return ErrorCode::ORDER_TYPE_INVALID;
+
+    // Get the valid order book for the order
+    OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
+    if (order_book_ptr == nullptr)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    position = order_book_ptr->GetQueuePosition(order_ptr);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddSymbol(const Symbol& symbol)
 {
     // Resize the symbol container
     if (_symbols.size() <= symbol.Id)
@@ -58,7 +95,8 @@ ErrorCode MarketManager::AddSymbol(const Symbol& symbol)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::DeleteSymbol(uint32_t id)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::DeleteSymbol(uint32_t id)
 {
     assert(((id < _symbols.size()) && (_symbols[id] != nullptr)) && "Symbol not found!");
     if ((_symbols.size() <= id) || (_symbols[id] == nullptr))
@@ -79,7 +117,8 @@ ErrorCode MarketManager::DeleteSymbol(uint32_t id)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::AddOrderBook(const Symbol& symbol)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddOrderBook(const Symbol& symbol, size_t size, uint64_t tick)
 {
     assert(((symbol.Id < _symbols.size()) && (_symbols[symbol.Id] != nullptr)) && "Symbol not found!");
     if ((_symbols.size() <= symbol.Id) || (_symbols[symbol.Id] == nullptr))
@@ -93,7 +132,7 @@ ErrorCode MarketManager::AddOrderBook(const Symbol& symbol)
         _order_books.resize(symbol.Id + 1, nullptr);
 
     // Create a new order book
-    OrderBook* order_book_ptr = _order_book_pool.Create(*this, *symbol_ptr);
+    OrderBook* order_book_ptr = _order_book_pool.Create(*this, *symbol_ptr, size, tick, _arena_chunk);
 
     // Insert the order book
     assert((_order_books[symbol.Id] == nullptr) && "Duplicate order book detected!");
@@ -111,7 +150,8 @@ ErrorCode MarketManager::AddOrderBook(const Symbol& symbol)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::DeleteOrderBook(uint32_t id)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::DeleteOrderBook(uint32_t id)
 {
     assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
     if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
@@ -126,14 +166,101 @@ ErrorCode MarketManager::DeleteOrderBook(uint32_t id)
     // Erase the order book
     _order_books[id] = nullptr;
 
+    // Erase and release orders of the order book
+    EraseOrders(order_book_ptr, order_book_ptr->bids());
+    EraseOrders(order_book_ptr, order_book_ptr->asks());
+    EraseOrders(order_book_ptr, order_book_ptr->buy_stop());
+    EraseOrders(order_book_ptr, order_book_ptr->sell_stop());
+    EraseOrders(order_book_ptr, order_book_ptr->trailing_buy_stop());
+    EraseOrders(order_book_ptr, order_book_ptr->trailing_sell_stop());
+    EraseOrders(order_book_ptr, order_book_ptr->trailing_buy_offset());
+    EraseOrders(order_book_ptr, order_book_ptr->trailing_sell_offset());
+
     // Release the order book
     _order_book_pool.Release(order_book_ptr);
 
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::AddOrder(const Order& order)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::SetOrderBookDepth(uint32_t id, size_t depth)
+{
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Reset the order book depth caches
+    _order_books[id]->ResetDepth(depth);
+
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::SetOrderBookAllocation(uint32_t id, AllocationType allocation)
+{
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Set the order book allocation policy
+    _order_books[id]->_allocation = allocation;
+
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::SetOrderBookTopOfBook(uint32_t id, bool publish)
+{
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Reset the order book top of the book
+    _order_books[id]->ResetTopOfBook(publish);
+
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::GetAuctionPrice(uint32_t id, uint64_t& price, uint64_t& volume) const
+{
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Calculate the order book equilibrium price
+    PriceValue equilibrium_price = 0;
+    volume = CalculateAuction(_order_books[id], equilibrium_price);
+    price = equilibrium_price;
+
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::UncrossOrderBook(uint32_t id)
+{
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Uncross the order book at its equilibrium price
+    Uncross(_order_books[id]);
+
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddOrder(const Order& order)
+{
+    OrderNode* order_ptr;
+    return AddOrder(order, order_ptr);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddOrder(const Order& order, OrderNode*& node_ptr)
 {
+    node_ptr = nullptr;
+
     // Validate order parameters
     ErrorCode result = order.Validate();
     if (result != ErrorCode::OK)
@@ -143,22 +270,38 @@ ErrorCode MarketManager::AddOrder(const Order& order)
     switch (order.Type)
     {
         case OrderType::MARKET:
-            return AddMarketOrder(order, false);
+            return AddMarketOrder(order, false, node_ptr);
         case OrderType::LIMIT:
-            return AddLimitOrder(order, false);
+            return AddLimitOrder(order, false, node_ptr);
         case OrderType::STOP:
         case OrderType::TRAILING_STOP:
-            return AddStopOrder(order, false);
+            return AddStopOrder(order, false, node_ptr);
         case OrderType::STOP_LIMIT:
         case OrderType::TRAILING_STOP_LIMIT:
-            return AddStopLimitOrder(order, false);
+            return AddStopLimitOrder(order, false, node_ptr);
         default:
             return ErrorCode::ORDER_TYPE_INVALID;
     }
 }
 
-ErrorCode MarketManager::AddMarketOrder(const Order& order, bool recursive)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddOrder(const Order& order, OrderHandle& handle)
+{
+    // Add the order and track its order node until it is released
+    ErrorCode result = AddOrder(order, _handle_order);
+
+    // Get the handle of the order resting in the order book
+    handle = OrderHandle(_handle_order);
+    _handle_order = nullptr;
+
+    return result;
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddMarketOrder(const Order& order, bool recursive, OrderNode*& node_ptr)
 {
+    node_ptr = nullptr;
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order.SymbolId);
     if (order_book_ptr == nullptr)
@@ -186,8 +329,11 @@ ErrorCode MarketManager::AddMarketOrder(const Order& order, bool recursive)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::AddLimitOrder(const Order& order, bool recursive)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddLimitOrder(const Order& order, bool recursive, OrderNode*& node_ptr)
 {
+    node_ptr = nullptr;
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order.SymbolId);
     if (order_book_ptr == nullptr)
@@ -206,7 +352,7 @@ ErrorCode MarketManager::AddLimitOrder(const Order& order, bool recursive)
     if ((new_order.LeavesQuantity > 0) && !new_order.IsIOC() && !new_order.IsFOK())
     {
         // Create a new order
-        OrderNode* order_ptr = _order_pool.Create(new_order);
+        OrderNode* order_ptr = order_book_ptr->CreateOrder(new_order);
 
         // Insert the order
         if (!_orders.insert(std::make_pair(order_ptr->Id, order_ptr)).second)
@@ -215,11 +361,13 @@ ErrorCode MarketManager::AddLimitOrder(const Order& order, bool recursive)
             _market_handler.onDeleteOrder(*order_ptr);
 
             // Release the order
-            _order_pool.Release(order_ptr);
+            ReleaseOrder(order_book_ptr, order_ptr);
 
             return ErrorCode::ORDER_DUPLICATE;
         }
 
+        node_ptr = order_ptr;
+
         // Add the new limit order into the order book
         UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr), order.SymbolId);
     }
@@ -239,8 +387,11 @@ ErrorCode MarketManager::AddLimitOrder(const Order& order, bool recursive)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddStopOrder(const Order& order, bool recursive, OrderNode*& node_ptr)
 {
+    node_ptr = nullptr;
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order.SymbolId);
     if (order_book_ptr == nullptr)
@@ -259,7 +410,7 @@ ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
     if (_matching && !recursive)
     {
         // Find the price to match the stop order
-        uint64_t stop_price = new_order.IsBuy() ? order_book_ptr->GetMarketPriceAsk() : order_book_ptr->GetMarketPriceBid();
+        PriceValue stop_price = new_order.IsBuy() ? order_book_ptr->GetMarketPriceAsk() : order_book_ptr->GetMarketPriceBid();
 
         // Check the arbitrage bid/ask prices
         bool arbitrage = new_order.IsBuy() ? (new_order.StopPrice <= stop_price) : (new_order.StopPrice >= stop_price);
@@ -295,7 +446,7 @@ ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
     if (new_order.LeavesQuantity > 0)
     {
         // Create a new order
-        OrderNode* order_ptr = _order_pool.Create(new_order);
+        OrderNode* order_ptr = order_book_ptr->CreateOrder(new_order);
 
         // Insert the order
         if (!_orders.insert(std::make_pair(order_ptr->Id, order_ptr)).second)
@@ -304,11 +455,13 @@ ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
             _market_handler.onDeleteOrder(*order_ptr);
 
             // Release the order
-            _order_pool.Release(order_ptr);
+            ReleaseOrder(order_book_ptr, order_ptr);
 
             return ErrorCode::ORDER_DUPLICATE;
         }
 
+        node_ptr = order_ptr;
+
         // Add the new stop order into the order book
         if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
             order_book_ptr->AddTrailingStopOrder(order_ptr);
@@ -331,8 +484,11 @@ ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::AddStopLimitOrder(const Order& order, bool recursive, OrderNode*& node_ptr)
 {
+    node_ptr = nullptr;
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order.SymbolId);
     if (order_book_ptr == nullptr)
@@ -355,7 +511,7 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
     if (_matching && !recursive)
     {
         // Find the price to match the stop-limit order
-        uint64_t stop_price = new_order.IsBuy() ? order_book_ptr->GetMarketPriceAsk() : order_book_ptr->GetMarketPriceBid();
+        PriceValue stop_price = new_order.IsBuy() ? order_book_ptr->GetMarketPriceAsk() : order_book_ptr->GetMarketPriceBid();
 
         // Check the arbitrage bid/ask prices
         bool arbitrage = new_order.IsBuy() ? (new_order.StopPrice <= stop_price) : (new_order.StopPrice >= stop_price);
@@ -375,7 +531,7 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
             if ((new_order.LeavesQuantity > 0) && !new_order.IsIOC() && !new_order.IsFOK())
             {
                 // Create a new order
-                OrderNode* order_ptr = _order_pool.Create(new_order);
+                OrderNode* order_ptr = order_book_ptr->CreateOrder(new_order);
 
                 // Insert the order
                 if (!_orders.insert(std::make_pair(order_ptr->Id, order_ptr)).second)
@@ -384,11 +540,13 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
                     _market_handler.onDeleteOrder(*order_ptr);
 
                     // Release the order
-                    _order_pool.Release(order_ptr);
+                    ReleaseOrder(order_book_ptr, order_ptr);
 
                     return ErrorCode::ORDER_DUPLICATE;
                 }
 
+                node_ptr = order_ptr;
+
                 // Add the new limit order into the order book
                 UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr));
             }
@@ -413,7 +571,7 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
     if (new_order.LeavesQuantity > 0)
     {
         // Create a new order
-        OrderNode* order_ptr = _order_pool.Create(new_order);
+        OrderNode* order_ptr = order_book_ptr->CreateOrder(new_order);
 
         // Insert the order
         if (!_orders.insert(std::make_pair(order_ptr->Id, order_ptr)).second)
@@ -422,11 +580,13 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
             _market_handler.onDeleteOrder(*order_ptr);
 
             // Release the order
-            _order_pool.Release(order_ptr);
+            ReleaseOrder(order_book_ptr, order_ptr);
 
             return ErrorCode::ORDER_DUPLICATE;
         }
 
+        node_ptr = order_ptr;
+
         // Add the new stop order into the order book
         if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
             order_book_ptr->AddTrailingStopOrder(order_ptr);
@@ -449,42 +609,66 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ReduceOrder(uint64_t id, uint64_t quantity)
+{
+    // Validate parameters range
+    if (!IsRepresentable<QuantityValue>(quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Get the order to reduce
+    OrderNode* order_ptr;
+    ErrorCode result = FindOrder(id, order_ptr);
+    if (result != ErrorCode::OK)
+        return result;
+
+    return ReduceOrder(order_ptr, (QuantityValue)quantity, false, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ReduceOrder(OrderHandle handle, uint64_t quantity)
 {
-    return ReduceOrder(id, quantity, false);
+    // Validate parameters range
+    if (!IsRepresentable<QuantityValue>(quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Validate the order handle
+    assert(handle && "Order handle must be valid!");
+    if (!handle)
+        return ErrorCode::ORDER_NOT_FOUND;
+
+    return ReduceOrder(handle._order, (QuantityValue)quantity, false, false);
 }
 
-ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recursive)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ReduceOrder(OrderNode* order_ptr, QuantityValue quantity, bool executed, bool recursive)
 {
     // Validate parameters
-    assert((id > 0) && "Order Id must be greater than zero!");
-    if (id == 0)
-        return ErrorCode::ORDER_ID_INVALID;
     assert((quantity > 0) && "Order quantity must be greater than zero!");
     if (quantity == 0)
         return ErrorCode::ORDER_QUANTITY_INVALID;
 
-    // Get the order to reduce
-    auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
-    if (order_it == _orders.end())
-        return ErrorCode::ORDER_NOT_FOUND;
-    OrderNode* order_ptr = (OrderNode*)order_it->second;
-
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
+    // Update the stop price of the tracking trailing stop order
+    order_book_ptr->UpdateTrailingOffsetStopPrice(order_ptr);
+
     // Calculate the minimal possible order quantity to reduce
     quantity = std::min(quantity, order_ptr->LeavesQuantity);
 
-    uint64_t hidden = order_ptr->HiddenQuantity();
-    uint64_t visible = order_ptr->VisibleQuantity();
+    QuantityValue hidden = order_ptr->HiddenQuantity();
+    QuantityValue visible = order_ptr->VisibleQuantity();
 
     // Reduce the order leaves quantity
     order_ptr->LeavesQuantity -= quantity;
 
+    // Execute the displayed slice of the 'iceberg' order
+    if (executed)
+        ExecuteSlice(order_ptr, quantity);
+
     hidden -= order_ptr->HiddenQuantity();
     visible -= order_ptr->VisibleQuantity();
 
@@ -492,7 +676,7 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
     if (order_ptr->LeavesQuantity > 0)
     {
         // Call the corresponding handler
-        _market_handler.onUpdateOrder(*order_ptr);
+        UpdateRestingOrder(*order_ptr, UpdateType::UPDATE);
 
         // Reduce the order in the order book
         switch (order_ptr->Type)
@@ -516,7 +700,7 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
     else
     {
         // Call the corresponding handler
-        _market_handler.onDeleteOrder(*order_ptr);
+        UpdateRestingOrder(*order_ptr, UpdateType::DELETE);
 
         // Reduce the order in the order book
         switch (order_ptr->Type)
@@ -538,10 +722,10 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
         }
 
         // Erase the order
-        _orders.erase(order_it);
+        _orders.erase(order_ptr->Id);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_book_ptr, order_ptr);
     }
 
     // Automatic order matching
@@ -554,38 +738,92 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
+{
+    // Validate parameters range
+    if (!IsRepresentable<PriceValue>(new_price))
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+    if (!IsRepresentable<QuantityValue>(new_quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Get the order to modify
+    OrderNode* order_ptr;
+    ErrorCode result = FindOrder(id, order_ptr);
+    if (result != ErrorCode::OK)
+        return result;
+
+    return ModifyOrder(order_ptr, (PriceValue)new_price, (QuantityValue)new_quantity, false, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ModifyOrder(OrderHandle handle, uint64_t new_price, uint64_t new_quantity)
+{
+    // Validate parameters range
+    if (!IsRepresentable<PriceValue>(new_price))
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+    if (!IsRepresentable<QuantityValue>(new_quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Validate the order handle
+    assert(handle && "Order handle must be valid!");
+    if (!handle)
+        return ErrorCode::ORDER_NOT_FOUND;
+
+    return ModifyOrder(handle._order, (PriceValue)new_price, (QuantityValue)new_quantity, false, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
 {
-    return ModifyOrder(id, new_price, new_quantity, false, false);
+    // Validate parameters range
+    if (!IsRepresentable<PriceValue>(new_price))
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+    if (!IsRepresentable<QuantityValue>(new_quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Get the order to mitigate
+    OrderNode* order_ptr;
+    ErrorCode result = FindOrder(id, order_ptr);
+    if (result != ErrorCode::OK)
+        return result;
+
+    return ModifyOrder(order_ptr, (PriceValue)new_price, (QuantityValue)new_quantity, true, false);
 }
 
-ErrorCode MarketManager::MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::MitigateOrder(OrderHandle handle, uint64_t new_price, uint64_t new_quantity)
 {
-    return ModifyOrder(id, new_price, new_quantity, true, false);
+    // Validate parameters range
+    if (!IsRepresentable<PriceValue>(new_price))
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+    if (!IsRepresentable<QuantityValue>(new_quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Validate the order handle
+    assert(handle && "Order handle must be valid!");
+    if (!handle)
+        return ErrorCode::ORDER_NOT_FOUND;
+
+    return ModifyOrder(handle._order, (PriceValue)new_price, (QuantityValue)new_quantity, true, false);
 }
 
-ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity, bool mitigate, bool recursive)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ModifyOrder(OrderNode* order_ptr, PriceValue new_price, QuantityValue new_quantity, bool mitigate, bool recursive)
 {
     // Validate parameters
-    assert((id > 0) && "Order Id must be greater than zero!");
-    if (id == 0)
-        return ErrorCode::ORDER_ID_INVALID;
     assert((new_quantity > 0) && "Order quantity must be greater than zero!");
     if (new_quantity == 0)
         return ErrorCode::ORDER_QUANTITY_INVALID;
 
-    // Get the order to modify
-    auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
-    if (order_it == _orders.end())
-        return ErrorCode::ORDER_NOT_FOUND;
-    OrderNode* order_ptr = (OrderNode*)order_it->second;
-
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
+    // Update the stop price of the tracking trailing stop order
+    order_book_ptr->UpdateTrailingOffsetStopPrice(order_ptr);
+
     // Delete the order from the order book
     switch (order_ptr->Type)
     {
@@ -609,6 +847,7 @@ ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t n
     order_ptr->Price = new_price;
     order_ptr->Quantity = new_quantity;
     order_ptr->LeavesQuantity = new_quantity;
+    order_ptr->SliceExecutedQuantity = 0;
 
     // In-Flight Mitigation (IFM)
     if (mitigate)
@@ -661,10 +900,10 @@ ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t n
         _market_handler.onDeleteOrder(*order_ptr);
 
         // Erase the order
-        _orders.erase(order_it);
+        _orders.erase(order_ptr->Id);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_book_ptr, order_ptr);
     }
 
     // Automatic order matching
@@ -677,30 +916,63 @@ ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t n
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity)
 {
-    return ReplaceOrder(id, new_id, new_price, new_quantity, false);
+    // Validate parameters range
+    if (!IsRepresentable<OrderIdValue>(new_id))
+        return ErrorCode::ORDER_ID_INVALID;
+    if (!IsRepresentable<PriceValue>(new_price))
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+    if (!IsRepresentable<QuantityValue>(new_quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Get the order to replace
+    OrderNode* order_ptr;
+    ErrorCode result = FindOrder(id, order_ptr);
+    if (result != ErrorCode::OK)
+        return result;
+
+    return ReplaceOrder(order_ptr, (OrderIdValue)new_id, (PriceValue)new_price, (QuantityValue)new_quantity, false);
 }
 
-ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity, bool recursive)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ReplaceOrder(OrderHandle& handle, uint64_t new_id, uint64_t new_price, uint64_t new_quantity)
 {
-    // Validate parameters
-    assert((id > 0) && "Order Id must be greater than zero!");
-    if (id == 0)
+    // Validate parameters range
+    if (!IsRepresentable<OrderIdValue>(new_id))
         return ErrorCode::ORDER_ID_INVALID;
+    if (!IsRepresentable<PriceValue>(new_price))
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+    if (!IsRepresentable<QuantityValue>(new_quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Validate the order handle
+    assert(handle && "Order handle must be valid!");
+    if (!handle)
+        return ErrorCode::ORDER_NOT_FOUND;
+
+    // Replace the order and track its order node until it is released
+    _handle_order = handle._order;
+    ErrorCode result = ReplaceOrder(handle._order, (OrderIdValue)new_id, (PriceValue)new_price, (QuantityValue)new_quantity, false);
+
+    // Get the handle of the order resting in the order book
+    handle = OrderHandle(_handle_order);
+    _handle_order = nullptr;
+
+    return result;
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ReplaceOrder(OrderNode* order_ptr, OrderIdValue new_id, PriceValue new_price, QuantityValue new_quantity, bool recursive)
+{
+    // Validate parameters
     assert((new_id > 0) && "New order Id must be greater than zero!");
     if (new_id == 0)
         return ErrorCode::ORDER_ID_INVALID;
     assert((new_quantity > 0) && "Order quantity must be greater than zero!");
     if (new_quantity == 0)
         return ErrorCode::ORDER_QUANTITY_INVALID;
-
-    // Get the order to replace
-    auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
-    if (order_it == _orders.end())
-        return ErrorCode::ORDER_NOT_FOUND;
-    OrderNode* order_ptr = (OrderNode*)order_it->second;
     assert(order_ptr->IsLimit() && "Replace order operation is valid only for limit orders!");
     if (!order_ptr->IsLimit())
         return ErrorCode::ORDER_TYPE_INVALID;
@@ -733,7 +1005,7 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new
     _market_handler.onDeleteOrder(*order_ptr);
 
     // Erase the order
-    _orders.erase(order_it);
+    _orders.erase(order_ptr->Id);
 
     // Replace the order
     order_ptr->Id = new_id;
@@ -741,6 +1013,7 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new
     order_ptr->Quantity = new_quantity;
     order_ptr->ExecutedQuantity = 0;
     order_ptr->LeavesQuantity = new_quantity;
+    order_ptr->SliceExecutedQuantity = 0;
 
     // Call the corresponding handler
     _market_handler.onAddOrder(*order_ptr);
@@ -758,7 +1031,7 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new
             _market_handler.onDeleteOrder(*order_ptr);
 
             // Release the order
-            _order_pool.Release(order_ptr);
+            ReleaseOrder(order_book_ptr, order_ptr);
 
             return ErrorCode::ORDER_DUPLICATE;
         }
@@ -788,7 +1061,7 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new
         _market_handler.onDeleteOrder(*order_ptr);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_book_ptr, order_ptr);
     }
 
     // Automatic order matching
@@ -801,7 +1074,8 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::ReplaceOrder(uint64_t id, const Order& new_order)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ReplaceOrder(uint64_t id, const Order& new_order)
 {
     // Delete the previous order by Id
     ErrorCode result = DeleteOrder(id);
@@ -812,30 +1086,52 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, const Order& new_order)
     return AddOrder(new_order);
 }
 
-ErrorCode MarketManager::DeleteOrder(uint64_t id)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ReplaceOrder(OrderHandle& handle, const Order& new_order)
 {
-    return DeleteOrder(id, false);
+    // Delete the previous order by handle
+    ErrorCode result = DeleteOrder(handle);
+    if (result != ErrorCode::OK)
+        return result;
+
+    // Add the new order
+    return AddOrder(new_order, handle);
 }
 
-ErrorCode MarketManager::DeleteOrder(uint64_t id, bool recursive)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::DeleteOrder(uint64_t id)
 {
-    // Validate parameters
-    assert((id > 0) && "Order Id must be greater than zero!");
-    if (id == 0)
-        return ErrorCode::ORDER_ID_INVALID;
-
     // Get the order to delete
-    auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
-    if (order_it == _orders.end())
+    OrderNode* order_ptr;
+    ErrorCode result = FindOrder(id, order_ptr);
+    if (result != ErrorCode::OK)
+        return result;
+
+    return DeleteOrder(order_ptr, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::DeleteOrder(OrderHandle handle)
+{
+    // Validate the order handle
+    assert(handle && "Order handle must be valid!");
+    if (!handle)
         return ErrorCode::ORDER_NOT_FOUND;
-    OrderNode* order_ptr = (OrderNode*)order_it->second;
 
+    return DeleteOrder(handle._order, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::DeleteOrder(OrderNode* order_ptr, bool recursive)
+{
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
+    // Update the stop price of the tracking trailing stop order
+    order_book_ptr->UpdateTrailingOffsetStopPrice(order_ptr);
+
     // Delete the order from the order book
     switch (order_ptr->Type)
     {
@@ -856,13 +1152,13 @@ ErrorCode MarketManager::DeleteOrder(uint64_t id, bool recursive)
     }
 
     // Call the corresponding handler
-    _market_handler.onDeleteOrder(*order_ptr);
+    UpdateRestingOrder(*order_ptr, UpdateType::DELETE);
 
     // Erase the order
-    _orders.erase(order_it);
+    _orders.erase(order_ptr->Id);
 
     // Relase the order
-    _order_pool.Release(order_ptr);
+    ReleaseOrder(order_book_ptr, order_ptr);
 
     // Automatic order matching
     if (_matching && !recursive)
@@ -874,40 +1170,100 @@ ErrorCode MarketManager::DeleteOrder(uint64_t id, bool recursive)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ExecuteOrder(uint64_t id, uint64_t quantity)
 {
-    // Validate parameters
-    assert((id > 0) && "Order Id must be greater than zero!");
-    if (id == 0)
-        return ErrorCode::ORDER_ID_INVALID;
-    assert((quantity > 0) && "Order quantity must be greater than zero!");
-    if (quantity == 0)
+    // Validate parameters range
+    if (!IsRepresentable<QuantityValue>(quantity))
         return ErrorCode::ORDER_QUANTITY_INVALID;
 
     // Get the order to execute
-    auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
-    if (order_it == _orders.end())
+    OrderNode* order_ptr;
+    ErrorCode result = FindOrder(id, order_ptr);
+    if (result != ErrorCode::OK)
+        return result;
+
+    return ExecuteOrder(order_ptr, order_ptr->Price, (QuantityValue)quantity, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity)
+{
+    // Validate parameters range
+    if (!IsRepresentable<PriceValue>(price))
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+    if (!IsRepresentable<QuantityValue>(quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Get the order to execute
+    OrderNode* order_ptr;
+    ErrorCode result = FindOrder(id, order_ptr);
+    if (result != ErrorCode::OK)
+        return result;
+
+    return ExecuteOrder(order_ptr, (PriceValue)price, (QuantityValue)quantity, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ExecuteOrder(OrderHandle handle, uint64_t quantity)
+{
+    // Validate parameters range
+    if (!IsRepresentable<QuantityValue>(quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Validate the order handle
+    assert(handle && "Order handle must be valid!");
+    if (!handle)
         return ErrorCode::ORDER_NOT_FOUND;
-    OrderNode* order_ptr = (OrderNode*)order_it->second;
+
+    return ExecuteOrder(handle._order, handle._order->Price, (QuantityValue)quantity, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ExecuteOrder(OrderHandle handle, uint64_t price, uint64_t quantity)
+{
+    // Validate parameters range
+    if (!IsRepresentable<PriceValue>(price))
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+    if (!IsRepresentable<QuantityValue>(quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+
+    // Validate the order handle
+    assert(handle && "Order handle must be valid!");
+    if (!handle)
+        return ErrorCode::ORDER_NOT_FOUND;
+
+    return ExecuteOrder(handle._order, (PriceValue)price, (QuantityValue)quantity, false);
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::ExecuteOrder(OrderNode* order_ptr, PriceValue price, QuantityValue quantity, bool recursive)
+{
+    // Validate parameters
+    assert((quantity > 0) && "Order quantity must be greater than zero!");
+    if (quantity == 0)
+        return ErrorCode::ORDER_QUANTITY_INVALID;
 
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
+    // Update the stop price of the tracking trailing stop order
+    order_book_ptr->UpdateTrailingOffsetStopPrice(order_ptr);
+
     // Calculate the minimal possible order quantity to execute
     quantity = std::min(quantity, order_ptr->LeavesQuantity);
 
     // Call the corresponding handler
-    _market_handler.onExecuteOrder(*order_ptr, order_ptr->Price, quantity);
+    _market_handler.onExecuteOrder(*order_ptr, price, quantity);
 
     // Update the corresponding market price
-    order_book_ptr->UpdateLastPrice(*order_ptr, order_ptr->Price);
-    order_book_ptr->UpdateMatchingPrice(*order_ptr, order_ptr->Price);
+    order_book_ptr->UpdateLastPrice(*order_ptr, price);
+    order_book_ptr->UpdateMatchingPrice(*order_ptr, price);
 
-    uint64_t hidden = order_ptr->HiddenQuantity();
-    uint64_t visible = order_ptr->VisibleQuantity();
+    QuantityValue hidden = order_ptr->HiddenQuantity();
+    QuantityValue visible = order_ptr->VisibleQuantity();
 
     // Increase the order executed quantity
     order_ptr->ExecutedQuantity += quantity;
@@ -915,6 +1271,9 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
     // Reduce the order leaves quantity
     order_ptr->LeavesQuantity -= quantity;
 
+    // Execute the displayed slice of the 'iceberg' order
+    ExecuteSlice(order_ptr, quantity);
+
     hidden -= order_ptr->HiddenQuantity();
     visible -= order_ptr->VisibleQuantity();
 
@@ -949,14 +1308,14 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
         _market_handler.onDeleteOrder(*order_ptr);
 
         // Erase the order
-        _orders.erase(order_it);
+        _orders.erase(order_ptr->Id);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_book_ptr, order_ptr);
     }
 
     // Automatic order matching
-    if (_matching)
+    if (_matching && !recursive)
         Match(order_book_ptr);
 
     // Reset matching price
@@ -965,105 +1324,44 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
     return ErrorCode::OK;
 }
 
-ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity)
+template <class TLevels>
+void MarketManagerT<TLevels>::ExecuteSlice(OrderNode* order_ptr, QuantityValue quantity) noexcept
 {
-    // Validate parameters
-    assert((id > 0) && "Order Id must be greater than zero!");
-    if (id == 0)
-        return ErrorCode::ORDER_ID_INVALID;
-    assert((quantity > 0) && "Order quantity must be greater than zero!");
-    if (quantity == 0)
-        return ErrorCode::ORDER_QUANTITY_INVALID;
+    // Only 'iceberg' limit orders display slices
+    if (!order_ptr->IsLimit() || !order_ptr->IsIceberg() || order_ptr->IsHidden())
+        return;
 
-    // Get the order to execute
-    auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
-    if (order_it == _orders.end())
-        return ErrorCode::ORDER_NOT_FOUND;
-    OrderNode* order_ptr = (OrderNode*)order_it->second;
+    // Matching fills are limited by the displayed slice, external executions
+    // beyond the displayed slice consume the hidden quantity
+    QuantityValue slice = order_ptr->MaxVisibleQuantity - order_ptr->SliceExecutedQuantity;
+    order_ptr->SliceExecutedQuantity += std::min(quantity, slice);
+}
 
-    // Get the valid order book for the order
-    OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
-    if (order_book_ptr == nullptr)
-        return ErrorCode::ORDER_BOOK_NOT_FOUND;
-
-    // Calculate the minimal possible order quantity to execute
-    quantity = std::min(quantity, order_ptr->LeavesQuantity);
-
-    // Call the corresponding handler
-    _market_handler.onExecuteOrder(*order_ptr, price, quantity);
-
-    // Update the corresponding market price
-    order_book_ptr->UpdateLastPrice(*order_ptr, price);
-    order_book_ptr->UpdateMatchingPrice(*order_ptr, price);
-
-    uint64_t hidden = order_ptr->HiddenQuantity();
-    uint64_t visible = order_ptr->VisibleQuantity();
-
-    // Increase the order executed quantity
-    order_ptr->ExecutedQuantity += quantity;
-
-    // Reduce the order leaves quantity
-    order_ptr->LeavesQuantity -= quantity;
-
-    hidden -= order_ptr->HiddenQuantity();
-    visible -= order_ptr->VisibleQuantity();
-
-    // Reduce the order in the order book
-    switch (order_ptr->Type)
-    {
-        case OrderType::LIMIT:
-            UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
-            break;
-        case OrderType::STOP:
-        case OrderType::STOP_LIMIT:
-            order_book_ptr->ReduceStopOrder(order_ptr, quantity, hidden, visible);
-            break;
-        case OrderType::TRAILING_STOP:
-        case OrderType::TRAILING_STOP_LIMIT:
-            order_book_ptr->ReduceTrailingStopOrder(order_ptr, quantity, hidden, visible);
-            break;
-        default:
-            assert(false && "Unsupported order type!");
-            break;
-    }
-
-    // Update the order or delete the empty order
-    if (order_ptr->LeavesQuantity > 0)
-    {
-        // Call the corresponding handler
-        _market_handler.onUpdateOrder(*order_ptr);
-    }
-    else
-    {
-        // Call the corresponding handler
-        _market_handler.onDeleteOrder(*order_ptr);
-
-        // Erase the order
-        _orders.erase(order_it);
-
-        // Relase the order
-        _order_pool.Release(order_ptr);
-    }
-
-    // Automatic order matching
-    if (_matching)
-        Match(order_book_ptr);
+template <class TLevels>
+OrderNode* MarketManagerT<TLevels>::NextExecutingOrder(OrderNode* order_ptr, OrderNode* next_order_ptr, QuantityValue quantity) noexcept
+{
+    // Executed order is deleted from the price level
+    if (quantity == order_ptr->LeavesQuantity)
+        return next_order_ptr;
 
-    // Reset matching price
-    order_book_ptr->ResetMatchingPrice();
+    // Partially executed order keeps its place in the price level
+    if (quantity < order_ptr->ExecutableQuantity())
+        return order_ptr;
 
-    return ErrorCode::OK;
+    // Replenished 'iceberg' order is moved behind all displayed orders of the price level
+    return ((next_order_ptr == nullptr) || next_order_ptr->IsHidden()) ? order_ptr : next_order_ptr;
 }
 
-void MarketManager::Match()
+template <class TLevels>
+void MarketManagerT<TLevels>::Match()
 {
     for (auto order_book_ptr : _order_books)
         if (order_book_ptr != nullptr)
             Match(order_book_ptr);
 }
 
-void MarketManager::Match(OrderBook* order_book_ptr)
+template <class TLevels>
+void MarketManagerT<TLevels>::Match(OrderBook* order_book_ptr)
 {
     // Matching loop
     for (;;)
@@ -1078,15 +1376,15 @@ void MarketManager::Match(OrderBook* order_book_ptr)
             LevelNode* ask_level_ptr = order_book_ptr->_best_ask;
 
             // Find the first order to execute and the first order to reduce
-            OrderNode* bid_order_ptr = bid_level_ptr->OrderList.front();
-            OrderNode* ask_order_ptr = ask_level_ptr->OrderList.front();
+            OrderNode* bid_order_ptr = bid_level_ptr->FrontOrder();
+            OrderNode* ask_order_ptr = ask_level_ptr->FrontOrder();
 
             // Execute crossed orders
             while ((bid_order_ptr != nullptr) && (ask_order_ptr != nullptr))
             {
                 // Find the next orders pair
-                OrderNode* next_bid_order_ptr = bid_order_ptr->next;
-                OrderNode* next_ask_order_ptr = ask_order_ptr->next;
+                OrderNode* next_bid_order_ptr = bid_level_ptr->NextOrder(bid_order_ptr);
+                OrderNode* next_ask_order_ptr = ask_level_ptr->NextOrder(ask_order_ptr);
 
                 // Special case for 'All-Or-None' orders
                 if (bid_order_ptr->IsAON() || ask_order_ptr->IsAON())
@@ -1101,15 +1399,15 @@ void MarketManager::Match(OrderBook* order_book_ptr)
                     // Execute orders in the matching chain
                     if (bid_order_ptr->IsAON())
                     {
-                        uint64_t price = bid_order_ptr->Price;
-                        ExecuteMatchingChain(order_book_ptr, bid_level_ptr, price, chain);
-                        ExecuteMatchingChain(order_book_ptr, ask_level_ptr, price, chain);
+                        PriceValue price = bid_order_ptr->Price;
+                        ExecuteMatchingChain(order_book_ptr, bid_level_ptr, nullptr, price, chain);
+                        ExecuteMatchingChain(order_book_ptr, ask_level_ptr, nullptr, price, chain);
                     }
                     else
                     {
-                        uint64_t price = ask_order_ptr->Price;
-                        ExecuteMatchingChain(order_book_ptr, ask_level_ptr, price, chain);
-                        ExecuteMatchingChain(order_book_ptr, bid_level_ptr, price, chain);
+                        PriceValue price = ask_order_ptr->Price;
+                        ExecuteMatchingChain(order_book_ptr, ask_level_ptr, nullptr, price, chain);
+                        ExecuteMatchingChain(order_book_ptr, bid_level_ptr, nullptr, price, chain);
                     }
 
                     break;
@@ -1121,11 +1419,15 @@ void MarketManager::Match(OrderBook* order_book_ptr)
                 if (executing_order_ptr->LeavesQuantity > reducing_order_ptr->LeavesQuantity)
                     std::swap(executing_order_ptr, reducing_order_ptr);
 
-                // Get the execution quantity
-                uint64_t quantity = executing_order_ptr->LeavesQuantity;
+                // Get the execution quantity limited by displayed slices of 'iceberg' orders
+                QuantityValue quantity = std::min(executing_order_ptr->ExecutableQuantity(), reducing_order_ptr->ExecutableQuantity());
 
                 // Get the execution price
-                uint64_t price = executing_order_ptr->Price;
+                PriceValue price = executing_order_ptr->Price;
+
+                // Find the next orders pair, replenished 'iceberg' orders are executed after displayed orders behind them
+                next_bid_order_ptr = NextExecutingOrder(bid_order_ptr, next_bid_order_ptr, quantity);
+                next_ask_order_ptr = NextExecutingOrder(ask_order_ptr, next_ask_order_ptr, quantity);
 
                 // Call the corresponding handler
                 _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
@@ -1137,8 +1439,8 @@ void MarketManager::Match(OrderBook* order_book_ptr)
                 // Increase the order executed quantity
                 executing_order_ptr->ExecutedQuantity += quantity;
 
-                // Delete the executing order from the order book
-                DeleteOrder(executing_order_ptr->Id, true);
+                // Reduce the executing order in the order book
+                ReduceOrder(executing_order_ptr, quantity, true, true);
 
                 // Call the corresponding handler
                 _market_handler.onExecuteOrder(*reducing_order_ptr, price, quantity);
@@ -1151,7 +1453,7 @@ void MarketManager::Match(OrderBook* order_book_ptr)
                 reducing_order_ptr->ExecutedQuantity += quantity;
 
                 // Reduce the remaining order in the order book
-                ReduceOrder(reducing_order_ptr->Id, quantity, true);
+                ReduceOrder(reducing_order_ptr, quantity, true, true);
 
                 // Move to the next orders pair at the same price level
                 bid_order_ptr = next_bid_order_ptr;
@@ -1159,8 +1461,11 @@ void MarketManager::Match(OrderBook* order_book_ptr)
             }
 
             // Activate stop orders only if the current price level changed
-            ActivateStopOrders(order_book_ptr, (LevelNode*)order_book_ptr->best_buy_stop(), order_book_ptr->GetMarketPriceAsk());
-            ActivateStopOrders(order_book_ptr, (LevelNode*)order_book_ptr->best_sell_stop(), order_book_ptr->GetMarketPriceBid());
+            if (order_book_ptr->_stops != nullptr)
+            {
+                ActivateStopOrders(order_book_ptr, order_book_ptr->_stops->BestBuyStop, nullptr, nullptr, order_book_ptr->GetMarketPriceAsk());
+                ActivateStopOrders(order_book_ptr, order_book_ptr->_stops->BestSellStop, nullptr, nullptr, order_book_ptr->GetMarketPriceBid());
+            }
         }
 
         // Activate stop orders until there is something to activate
@@ -1169,7 +1474,8 @@ void MarketManager::Match(OrderBook* order_book_ptr)
     }
 }
 
-void MarketManager::MatchMarket(OrderBook* order_book_ptr, Order* order_ptr)
+template <class TLevels>
+void MarketManagerT<TLevels>::MatchMarket(OrderBook* order_book_ptr, Order* order_ptr)
 {
     // Calculate acceptable marker order price with optional slippage value
     if (order_ptr->IsBuy())
@@ -1179,8 +1485,8 @@ void MarketManager::MatchMarket(OrderBook* order_book_ptr, Order* order_ptr)
             return;
 
         order_ptr->Price = order_book_ptr->best_ask()->Price;
-        if (order_ptr->Price > (std::numeric_limits<uint64_t>::max() - order_ptr->Slippage))
-            order_ptr->Price = std::numeric_limits<uint64_t>::max();
+        if (order_ptr->Price > (std::numeric_limits<PriceValue>::max() - order_ptr->Slippage))
+            order_ptr->Price = std::numeric_limits<PriceValue>::max();
         else
             order_ptr->Price += order_ptr->Slippage;
     }
@@ -1191,8 +1497,8 @@ void MarketManager::MatchMarket(OrderBook* order_book_ptr, Order* order_ptr)
             return;
 
         order_ptr->Price = order_book_ptr->best_bid()->Price;
-        if (order_ptr->Price < (std::numeric_limits<uint64_t>::min() + order_ptr->Slippage))
-            order_ptr->Price = std::numeric_limits<uint64_t>::min();
+        if (order_ptr->Price < (std::numeric_limits<PriceValue>::min() + order_ptr->Slippage))
+            order_ptr->Price = std::numeric_limits<PriceValue>::min();
         else
             order_ptr->Price -= order_ptr->Slippage;
     }
@@ -1201,14 +1507,28 @@ void MarketManager::MatchMarket(OrderBook* order_book_ptr, Order* order_ptr)
     MatchOrder(order_book_ptr, order_ptr);
 }
 
-void MarketManager::MatchLimit(OrderBook* order_book_ptr, Order* order_ptr)
+template <class TLevels>
+void MarketManagerT<TLevels>::MatchLimit(OrderBook* order_book_ptr, Order* order_ptr)
 {
     // Match the limit order
     MatchOrder(order_book_ptr, order_ptr);
 }
 
-void MarketManager::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
+template <class TLevels>
+void MarketManagerT<TLevels>::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
 {
+    // Batch executions of the order sweep
+    if (_sweeps && !_sweeping)
+    {
+        _sweeping = true;
+        MatchOrder(order_book_ptr, order_ptr);
+        _sweeping = false;
+
+        // Notify about the completed sweep
+        UpdateSweep(*order_book_ptr, *order_ptr);
+        return;
+    }
+
     // Start the matching from the top of the book
     LevelNode* level_ptr;
     while ((level_ptr = order_ptr->IsBuy() ? order_book_ptr->_best_ask : order_book_ptr->_best_bid) != nullptr)
@@ -1222,17 +1542,30 @@ void MarketManager::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
         if (order_ptr->IsFOK() || order_ptr->IsAON())
         {
             // Calculate the matching chain
-            uint64_t chain = CalculateMatchingChain(order_book_ptr, level_ptr, order_ptr->Price, order_ptr->LeavesQuantity);
+            OrderNode* self_trade_order_ptr;
+            uint64_t chain = CalculateMatchingChain(order_book_ptr, level_ptr, order_ptr, order_ptr->Price, order_ptr->LeavesQuantity, self_trade_order_ptr);
+
+            // Prevent the self-trade with the resting order of the same owner reached before the matching chain is completed
+            if (self_trade_order_ptr != nullptr)
+            {
+                PreventSelfTrade(self_trade_order_ptr, order_ptr);
+                return;
+            }
 
             // Matching is not avaliable
             if (chain == 0)
                 return;
 
             // Execute orders in the matching chain
-            ExecuteMatchingChain(order_book_ptr, level_ptr, order_ptr->Price, chain);
+            ExecuteMatchingChain(order_book_ptr, level_ptr, order_ptr, order_ptr->Price, chain);
+
+            // Order was decremented entirely by the self-trade prevention
+            if (order_ptr->LeavesQuantity == 0)
+                return;
 
             // Call the corresponding handler
-            _market_handler.onExecuteOrder(*order_ptr, order_ptr->Price, order_ptr->LeavesQuantity);
+            if (!_sweeping)
+                _market_handler.onExecuteOrder(*order_ptr, order_ptr->Price, order_ptr->LeavesQuantity);
 
             // Update the corresponding market price
             order_book_ptr->UpdateLastPrice(*order_ptr, order_ptr->Price);
@@ -1247,27 +1580,47 @@ void MarketManager::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
             return;
         }
 
+        // Check the price level for resting orders of the order owner
+        bool self_trade = IsSelfTradeLevel(level_ptr, order_ptr);
+
+        // Allocate the order among orders of other owners of the price level
+        if (ExecuteAllocation(order_book_ptr, level_ptr, order_ptr, self_trade ? order_ptr->OwnerId : 0, level_ptr->Price, order_ptr->LeavesQuantity))
+            return;
+
         // Find the first order to execute
-        OrderNode* executing_order_ptr = level_ptr->OrderList.front();
+        OrderNode* executing_order_ptr = level_ptr->FrontOrder();
 
         // Execute crossed orders
         while (executing_order_ptr != nullptr)
         {
             // Find the next order to execute
-            OrderNode* next_executing_order_ptr = executing_order_ptr->next;
+            OrderNode* next_executing_order_ptr = level_ptr->NextOrder(executing_order_ptr);
 
-            // Get the execution quantity
-            uint64_t quantity = std::min(executing_order_ptr->LeavesQuantity, order_ptr->LeavesQuantity);
+            // Prevent the self-trade with the resting order of the same owner
+            if (self_trade && (executing_order_ptr->OwnerId == order_ptr->OwnerId))
+            {
+                if (!PreventSelfTrade(executing_order_ptr, order_ptr))
+                    return;
+
+                executing_order_ptr = next_executing_order_ptr;
+                continue;
+            }
+
+            // Get the execution quantity limited by the displayed slice of the 'iceberg' order
+            QuantityValue quantity = std::min(executing_order_ptr->ExecutableQuantity(), order_ptr->LeavesQuantity);
 
             // Special case for 'All-Or-None' orders
             if (executing_order_ptr->IsAON() && (executing_order_ptr->LeavesQuantity > order_ptr->LeavesQuantity))
                 return;
 
             // Get the execution price
-            uint64_t price = executing_order_ptr->Price;
+            PriceValue price = executing_order_ptr->Price;
+
+            // Replenished 'iceberg' order is executed after displayed orders behind it
+            next_executing_order_ptr = NextExecutingOrder(executing_order_ptr, next_executing_order_ptr, quantity);
 
             // Call the corresponding handler
-            _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
+            ExecuteRestingOrder(*executing_order_ptr, price, quantity);
 
             // Update the corresponding market price
             order_book_ptr->UpdateLastPrice(*executing_order_ptr, price);
@@ -1277,10 +1630,11 @@ void MarketManager::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
             executing_order_ptr->ExecutedQuantity += quantity;
 
             // Reduce the executing order in the order book
-            ReduceOrder(executing_order_ptr->Id, quantity, true);
+            ReduceOrder(executing_order_ptr, quantity, true, true);
 
             // Call the corresponding handler
-            _market_handler.onExecuteOrder(*order_ptr, price, quantity);
+            if (!_sweeping)
+                _market_handler.onExecuteOrder(*order_ptr, price, quantity);
 
             // Update the corresponding market price
             order_book_ptr->UpdateLastPrice(*order_ptr, price);
@@ -1300,18 +1654,24 @@ void MarketManager::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
     }
 }
 
-bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr)
+template <class TLevels>
+bool MarketManagerT<TLevels>::ActivateStopOrders(OrderBook* order_book_ptr)
 {
+    // Skip stop orders activation for the order book without the stop book
+    if (order_book_ptr->_stops == nullptr)
+        return false;
+
     bool result = false;
     bool stop = false;
 
+    // Each pass activates all stop orders crossed by the current market price,
+    // so the next pass is required only if activated orders moved the market
     while (!stop)
     {
         stop = true;
 
         // Try to activate buy stop orders
-        if (ActivateStopOrders(order_book_ptr, (LevelNode*)order_book_ptr->best_buy_stop(), order_book_ptr->GetMarketPriceAsk()) ||
-            ActivateStopOrders(order_book_ptr, (LevelNode*)order_book_ptr->best_trailing_buy_stop(), order_book_ptr->GetMarketPriceAsk()))
+        if (ActivateStopOrders(order_book_ptr, order_book_ptr->_stops->BestBuyStop, order_book_ptr->_stops->BestTrailingBuyStop, order_book_ptr->_stops->BestTrailingBuyOffset, order_book_ptr->GetMarketPriceAsk()))
         {
             result = true;
             stop = false;
@@ -1321,8 +1681,7 @@ bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr)
         RecalculateTrailingStopPrice(order_book_ptr, order_book_ptr->_best_ask);
 
         // Try to activate sell stop orders
-        if (ActivateStopOrders(order_book_ptr, (LevelNode*)order_book_ptr->best_sell_stop(), order_book_ptr->GetMarketPriceBid()) ||
-            ActivateStopOrders(order_book_ptr, (LevelNode*)order_book_ptr->best_trailing_sell_stop(), order_book_ptr->GetMarketPriceBid()))
+        if (ActivateStopOrders(order_book_ptr, order_book_ptr->_stops->BestSellStop, order_book_ptr->_stops->BestTrailingSellStop, order_book_ptr->_stops->BestTrailingSellOffset, order_book_ptr->GetMarketPriceBid()))
         {
             result = true;
             stop = false;
@@ -1335,52 +1694,96 @@ bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr)
     return result;
 }
 
-bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t stop_price)
+template <class TLevels>
+bool MarketManagerT<TLevels>::ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* stop_level_ptr, LevelNode* trailing_level_ptr, LevelNode* offset_level_ptr, PriceValue stop_price)
 {
-    bool result = false;
+    size_t first = _activating_orders.size();
 
-    if (level_ptr != nullptr)
+    // Gather stop orders of all crossed stop, trailing stop and tracking
+    // trailing stop price levels from the best price level. Stop orders are
+    // gathered before trailing stop orders with the same stop price and in
+    // the queue order within the price level.
+    LevelNode* levels[3] = { stop_level_ptr, trailing_level_ptr, offset_level_ptr };
+    for (;;)
     {
-        // Check the arbitrage bid/ask prices
-        bool arbitrage = level_ptr->IsBid() ? (stop_price <= level_ptr->Price) : (stop_price >= level_ptr->Price);
-        if (!arbitrage)
-            return result;
-
-        // Find the stop order to activate
-        OrderNode* activating_order_ptr = level_ptr->OrderList.front();
-
-        // Activate all stop orders
-        while (activating_order_ptr != nullptr)
+        // Choose the best crossed price level
+        size_t best = 3;
+        PriceValue best_price = 0;
+        for (size_t i = 0; i < 3; ++i)
         {
-            // Find the next order to activate
-            OrderNode* next_activating_order_ptr = activating_order_ptr->next;
+            LevelNode* level_ptr = levels[i];
+            if (level_ptr == nullptr)
+                continue;
 
-            // Activate the stop order
-            switch (activating_order_ptr->Type)
+            // Tracking trailing stop price levels are keyed by the trailing distance
+            PriceValue price = (i == 2) ? order_book_ptr->GetTrailingOffsetStopPrice(level_ptr) : level_ptr->Price;
+
+            // Check the arbitrage bid/ask prices
+            bool arbitrage = level_ptr->IsBid() ? (stop_price <= price) : (stop_price >= price);
+            if (!arbitrage)
             {
-                case OrderType::STOP:
-                case OrderType::TRAILING_STOP:
-                    result = ActivateStopOrder(order_book_ptr, activating_order_ptr);
-                    break;
-                case OrderType::STOP_LIMIT:
-                case OrderType::TRAILING_STOP_LIMIT:
-                    result = ActivateStopLimitOrder(order_book_ptr, activating_order_ptr);
-                    break;
-                default:
-                    assert(false && "Unsupported order type!");
-                    break;
+                levels[i] = nullptr;
+                continue;
+            }
 
+            if ((best == 3) || (level_ptr->IsBid() ? (price > best_price) : (price < best_price)))
+            {
+                best = i;
+                best_price = price;
             }
+        }
+        if (best == 3)
+            break;
+
+        for (OrderNode* order_ptr = levels[best]->OrderList.front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+            _activating_orders.push_back(order_ptr);
+
+        // Switch to the next price level
+        switch (best)
+        {
+            case 0:
+                levels[best] = order_book_ptr->GetNextStopLevel(levels[best]);
+                break;
+            case 1:
+                levels[best] = order_book_ptr->GetNextTrailingStopLevel(levels[best]);
+                break;
+            default:
+                levels[best] = order_book_ptr->GetNextTrailingOffsetLevel(levels[best]);
+                break;
+        }
+    }
 
-            // Move to the next order to activate at the same price level
-            activating_order_ptr = next_activating_order_ptr;
+    bool result = (_activating_orders.size() > first);
+
+    // Activate all gathered stop orders in a single pass
+    for (size_t i = first; i < _activating_orders.size(); ++i)
+    {
+        OrderNode* activating_order_ptr = _activating_orders[i];
+
+        // Activate the stop order
+        switch (activating_order_ptr->Type)
+        {
+            case OrderType::STOP:
+            case OrderType::TRAILING_STOP:
+                ActivateStopOrder(order_book_ptr, activating_order_ptr);
+                break;
+            case OrderType::STOP_LIMIT:
+            case OrderType::TRAILING_STOP_LIMIT:
+                ActivateStopLimitOrder(order_book_ptr, activating_order_ptr);
+                break;
+            default:
+                assert(false && "Unsupported order type!");
+                break;
         }
     }
 
+    _activating_orders.resize(first);
+
     return result;
 }
 
-bool MarketManager::ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* order_ptr)
+template <class TLevels>
+bool MarketManagerT<TLevels>::ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* order_ptr)
 {
     // Delete the stop order from the order book
     if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
@@ -1404,15 +1807,16 @@ bool MarketManager::ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* orde
     _market_handler.onDeleteOrder(*order_ptr);
 
     // Erase the order
-    _orders.erase(_orders.find(order_ptr->Id));
+    _orders.erase(order_ptr->Id);
 
     // Relase the order
-    _order_pool.Release(order_ptr);
+    ReleaseOrder(order_book_ptr, order_ptr);
 
     return true;
 }
 
-bool MarketManager::ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode* order_ptr)
+template <class TLevels>
+bool MarketManagerT<TLevels>::ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode* order_ptr)
 {
     // Delete the stop order from the order book
     if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
@@ -1442,18 +1846,34 @@ bool MarketManager::ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode*
         _market_handler.onDeleteOrder(*order_ptr);
 
         // Erase the order
-        _orders.erase(_orders.find(order_ptr->Id));
+        _orders.erase(order_ptr->Id);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_book_ptr, order_ptr);
     }
 
     return true;
 }
 
-uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume)
+template <class TLevels>
+uint64_t MarketManagerT<TLevels>::CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, const Order* order_ptr, PriceValue price, uint64_t volume, OrderNode*& self_trade_order_ptr)
 {
-    OrderNode* order_ptr = level_ptr->OrderList.front();
+    self_trade_order_ptr = nullptr;
+
+    // Check the total volume of arbitrage price levels without walking orders
+    uint64_t total = 0;
+    for (LevelNode* current_ptr = level_ptr; (total < volume) && (current_ptr != nullptr); current_ptr = order_book_ptr->GetNextLevel(current_ptr))
+    {
+        bool arbitrage = current_ptr->IsBid() ? (price <= current_ptr->Price) : (price >= current_ptr->Price);
+        if (!arbitrage)
+            break;
+        total += current_ptr->TotalVolume;
+    }
+
+    // Matching is not possible
+    if (total < volume)
+        return 0;
+
     uint64_t available = 0;
 
     // Travel through price levels
@@ -1464,44 +1884,58 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
         if (!arbitrage)
             return 0;
 
-        // Travel through orders at current price levels
-        while (order_ptr != nullptr)
+        // Check the price level for resting orders of the order owner
+        bool self_trade = IsSelfTradeLevel(level_ptr, order_ptr);
+
+        // Take the price level without 'All-Or-None' orders and orders of the order owner by its aggregated volume
+        if ((level_ptr->AONOrders == 0) && !self_trade)
         {
             uint64_t need = volume - available;
-            uint64_t quantity = order_ptr->IsAON() ? order_ptr->LeavesQuantity : std::min(order_ptr->LeavesQuantity, need);
-            available += quantity;
+            available += std::min<uint64_t>(level_ptr->TotalVolume, need);
+        }
+        // Take the rest of the matching chain allocated among displayed orders of other owners
+        else if ((order_book_ptr->_allocation != AllocationType::FIFO) && (level_ptr->AONOrders == 0) && ((volume - available) < CalculateAllocationVolume(level_ptr, order_ptr->OwnerId)))
+            available = volume;
+        else
+        {
+            uint64_t reserve = 0;
 
-            // Matching is possible, return the chain size
-            if (volume == available)
-                return available;
+            // Take displayed orders, hidden quantity of 'iceberg' orders and hidden orders in the execution order
+            if (TakeMatchingOrders(level_ptr->OrderList.front(), order_ptr, self_trade, volume, available, reserve, self_trade_order_ptr))
+            {
+                available += std::min<uint64_t>(reserve, volume - available);
+                if (available < volume)
+                    TakeMatchingOrders(level_ptr->HiddenOrderList.front(), order_ptr, self_trade, volume, available, reserve, self_trade_order_ptr);
+            }
+
+            // Order is cancelled by the self-trade prevention
+            if (self_trade_order_ptr != nullptr)
+                return 0;
 
             // Matching is not possible
             if (volume < available)
                 return 0;
-
-            // Take the next order
-            order_ptr = order_ptr->next;
         }
 
+        // Matching is possible, return the chain size
+        if (volume == available)
+            return available;
+
         // Switch to the next price level
-        if (order_ptr == nullptr)
-        {
-            level_ptr = order_book_ptr->GetNextLevel(level_ptr);
-            if (level_ptr != nullptr)
-                order_ptr = level_ptr->OrderList.front();
-        }
+        level_ptr = order_book_ptr->GetNextLevel(level_ptr);
     }
 
     // Matching is not available
     return 0;
 }
 
-uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* bid_level_ptr, LevelNode* ask_level_ptr)
+template <class TLevels>
+uint64_t MarketManagerT<TLevels>::CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* bid_level_ptr, LevelNode* ask_level_ptr)
 {
     LevelNode* longest_level_ptr = bid_level_ptr;
     LevelNode* shortest_level_ptr = ask_level_ptr;
-    OrderNode* longest_order_ptr = bid_level_ptr->OrderList.front();
-    OrderNode* shortest_order_ptr = ask_level_ptr->OrderList.front();
+    OrderNode* longest_order_ptr = bid_level_ptr->FrontOrder();
+    OrderNode* shortest_order_ptr = ask_level_ptr->FrontOrder();
     uint64_t required = longest_order_ptr->LeavesQuantity;
     uint64_t available = 0;
 
@@ -1532,7 +1966,19 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
         while ((longest_order_ptr != nullptr) && (shortest_order_ptr != nullptr))
         {
             uint64_t need = required - available;
-            uint64_t quantity = shortest_order_ptr->IsAON() ? shortest_order_ptr->LeavesQuantity : std::min(shortest_order_ptr->LeavesQuantity, need);
+
+            // Take the whole shortest price level without 'All-Or-None' orders by its aggregated volume
+            if ((shortest_level_ptr->AONOrders == 0) && (shortest_order_ptr == shortest_level_ptr->FrontOrder()))
+            {
+                // Matching is possible, return the chain size
+                if (shortest_level_ptr->TotalVolume >= need)
+                    return required;
+
+                available += shortest_level_ptr->TotalVolume;
+                shortest_order_ptr = nullptr;
+                break;
+            }
+            uint64_t quantity = shortest_order_ptr->IsAON() ? shortest_order_ptr->LeavesQuantity : std::min<uint64_t>(shortest_order_ptr->LeavesQuantity, need);
             available += quantity;
 
             // Matching is possible, return the chain size
@@ -1542,7 +1988,7 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
             // Swap longest and shortest chains
             if (required < available)
             {
-                OrderNode* next = longest_order_ptr->next;
+                OrderNode* next = longest_order_ptr->Level->NextOrder(longest_order_ptr);
                 longest_order_ptr = shortest_order_ptr;
                 shortest_order_ptr = next;
                 std::swap(required, available);
@@ -1550,7 +1996,7 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
             }
 
             // Take the next order
-            shortest_order_ptr = shortest_order_ptr->next;
+            shortest_order_ptr = shortest_order_ptr->Level->NextOrder(shortest_order_ptr);
         }
 
         // Switch to the next longest price level
@@ -1558,7 +2004,7 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
         {
             longest_level_ptr = order_book_ptr->GetNextLevel(longest_level_ptr);
             if (longest_level_ptr != nullptr)
-                longest_order_ptr = longest_level_ptr->OrderList.front();
+                longest_order_ptr = longest_level_ptr->FrontOrder();
         }
 
         // Switch to the next shortest price level
@@ -1566,7 +2012,7 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
         {
             shortest_level_ptr = order_book_ptr->GetNextLevel(shortest_level_ptr);
             if (shortest_level_ptr != nullptr)
-                shortest_order_ptr = shortest_level_ptr->OrderList.front();
+                shortest_order_ptr = shortest_level_ptr->FrontOrder();
         }
     }
 
@@ -1574,7 +2020,53 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
     return 0;
 }
 
-void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume)
+template <class TLevels>
+bool MarketManagerT<TLevels>::TakeMatchingOrders(OrderNode* resting_order_ptr, const Order* order_ptr, bool self_trade, uint64_t volume, uint64_t& available, uint64_t& reserve, OrderNode*& self_trade_order_ptr) noexcept
+{
+    // Travel through orders of the price level list
+    for (; resting_order_ptr != nullptr; resting_order_ptr = resting_order_ptr->next)
+    {
+        uint64_t need = volume - available;
+        uint64_t quantity;
+
+        // Apply the self-trade prevention to resting orders of the order owner
+        if (self_trade && (resting_order_ptr->OwnerId == order_ptr->OwnerId))
+        {
+            switch (order_ptr->SelfTradePrevention)
+            {
+                case OrderSelfTradePrevention::CANCEL_RESTING:
+                    // Resting order is cancelled
+                    continue;
+                case OrderSelfTradePrevention::DECREMENT:
+                    // Both orders are decreased by the smaller leaves quantity
+                    quantity = std::min<uint64_t>(resting_order_ptr->LeavesQuantity, need);
+                    break;
+                default:
+                    // Order is cancelled before the matching chain is completed
+                    self_trade_order_ptr = resting_order_ptr;
+                    return false;
+            }
+        }
+        else if (resting_order_ptr->IsAON())
+            quantity = resting_order_ptr->LeavesQuantity;
+        else
+        {
+            // Hidden quantity of the 'iceberg' order is executed after displayed orders behind it
+            quantity = std::min<uint64_t>(resting_order_ptr->ExecutableQuantity(), need);
+            reserve += resting_order_ptr->LeavesQuantity - resting_order_ptr->ExecutableQuantity();
+        }
+        available += quantity;
+
+        // Matching chain is completed or not possible
+        if (available >= volume)
+            return false;
+    }
+
+    return true;
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, Order* order_ptr, PriceValue price, uint64_t volume)
 {
     // Execute all orders in the matching chain
     while ((volume > 0) && (level_ptr != nullptr))
@@ -1582,16 +2074,57 @@ void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* l
         // Get the next prive level to execute
         LevelNode* next_level_ptr = order_book_ptr->GetNextLevel(level_ptr);
 
+        // Check the price level for resting orders of the order owner
+        bool self_trade = IsSelfTradeLevel(level_ptr, order_ptr);
+
+        // Allocate the rest of the matching chain among orders of other owners of the price level
+        if (ExecuteAllocation(order_book_ptr, level_ptr, nullptr, self_trade ? order_ptr->OwnerId : 0, price, volume))
+            return;
+
         // Find the first order to execute
-        OrderNode* executing_order_ptr = level_ptr->OrderList.front();
+        OrderNode* executing_order_ptr = level_ptr->FrontOrder();
 
         // Execute all orders in the current price level
         while ((volume > 0) && (executing_order_ptr != nullptr))
         {
             // Find the next order to execute
-            OrderNode* next_executing_order_ptr = executing_order_ptr->next;
+            OrderNode* next_executing_order_ptr = level_ptr->NextOrder(executing_order_ptr);
 
-            uint64_t quantity;
+            // Prevent the self-trade with the resting order of the same owner
+            if (self_trade && (executing_order_ptr->OwnerId == order_ptr->OwnerId))
+            {
+                switch (order_ptr->SelfTradePrevention)
+                {
+                    case OrderSelfTradePrevention::CANCEL_RESTING:
+                        // Cancel the resting order
+                        DeleteOrder(executing_order_ptr, true);
+                        break;
+                    case OrderSelfTradePrevention::DECREMENT:
+                    {
+                        // Decrease both orders by the smaller of the resting order leaves quantity and the rest of the matching chain
+                        QuantityValue quantity = (QuantityValue)std::min<uint64_t>(executing_order_ptr->LeavesQuantity, volume);
+                        ReduceOrder(executing_order_ptr, quantity, false, true);
+                        order_ptr->LeavesQuantity -= quantity;
+                        volume -= quantity;
+                        break;
+                    }
+                    default:
+                        // Matching chain is completed before the order could be cancelled
+                        break;
+                }
+
+                executing_order_ptr = next_executing_order_ptr;
+                continue;
+            }
+
+            // Skip 'All-Or-None' orders moved out of the matching chain by replenished 'iceberg' orders
+            if (executing_order_ptr->IsAON() && (executing_order_ptr->LeavesQuantity > volume))
+            {
+                executing_order_ptr = next_executing_order_ptr;
+                continue;
+            }
+
+            QuantityValue quantity;
 
             // Execute order
             if (executing_order_ptr->IsAON())
@@ -1600,7 +2133,7 @@ void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* l
                 quantity = executing_order_ptr->LeavesQuantity;
 
                 // Call the corresponding handler
-                _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
+                ExecuteRestingOrder(*executing_order_ptr, price, quantity);
 
                 // Update the corresponding market price
                 order_book_ptr->UpdateLastPrice(*executing_order_ptr, price);
@@ -1610,15 +2143,18 @@ void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* l
                 executing_order_ptr->ExecutedQuantity += quantity;
 
                 // Delete the executing order from the order book
-                DeleteOrder(executing_order_ptr->Id, true);
+                DeleteOrder(executing_order_ptr, true);
             }
             else
             {
-                // Get the execution quantity
-                quantity = std::min(executing_order_ptr->LeavesQuantity, volume);
+                // Get the execution quantity limited by the displayed slice of the 'iceberg' order
+                quantity = (QuantityValue)std::min<uint64_t>(executing_order_ptr->ExecutableQuantity(), volume);
+
+                // Replenished 'iceberg' order is executed after displayed orders behind it
+                next_executing_order_ptr = NextExecutingOrder(executing_order_ptr, next_executing_order_ptr, quantity);
 
                 // Call the corresponding handler
-                _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
+                ExecuteRestingOrder(*executing_order_ptr, price, quantity);
 
                 // Update the corresponding market price
                 order_book_ptr->UpdateLastPrice(*executing_order_ptr, price);
@@ -1628,7 +2164,7 @@ void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* l
                 executing_order_ptr->ExecutedQuantity += quantity;
 
                 // Reduce the executing order in the order book
-                ReduceOrder(executing_order_ptr->Id, quantity, true);
+                ReduceOrder(executing_order_ptr, quantity, true, true);
             }
 
             // Reduce the execution chain
@@ -1643,103 +2179,614 @@ void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* l
     }
 }
 
-void MarketManager::RecalculateTrailingStopPrice(OrderBook* order_book_ptr, LevelNode* level_ptr)
+template <class TLevels>
+bool MarketManagerT<TLevels>::IsSelfTradeLevel(LevelNode* level_ptr, const Order* order_ptr) noexcept
+{
+    if ((order_ptr == nullptr) || (order_ptr->SelfTradePrevention == OrderSelfTradePrevention::NONE))
+        return false;
+
+    // Price level owners filter could report false positives, but never misses an owner
+    uint64_t owner_mask = order_ptr->OwnerMask();
+    if ((level_ptr->OwnerMask & owner_mask) == 0)
+        return false;
+
+    // Rebuild the stale price level owners filter only when it reports the order owner
+    if (level_ptr->OwnerMaskStale)
+        level_ptr->RebuildOwnerMask();
+
+    return ((level_ptr->OwnerMask & owner_mask) != 0);
+}
+
+template <class TLevels>
+bool MarketManagerT<TLevels>::PreventSelfTrade(OrderNode* resting_order_ptr, Order* order_ptr)
 {
-    if (level_ptr == nullptr)
+    switch (order_ptr->SelfTradePrevention)
+    {
+        case OrderSelfTradePrevention::CANCEL_RESTING:
+            // Cancel the resting order
+            DeleteOrder(resting_order_ptr, true);
+            break;
+        case OrderSelfTradePrevention::CANCEL_AGGRESSOR:
+            // Cancel the remaining part of the order
+            order_ptr->LeavesQuantity = 0;
+            break;
+        case OrderSelfTradePrevention::CANCEL_BOTH:
+            // Cancel the resting order and the remaining part of the order
+            DeleteOrder(resting_order_ptr, true);
+            order_ptr->LeavesQuantity = 0;
+            break;
+        case OrderSelfTradePrevention::DECREMENT:
+        {
+            // Decrease both orders by the smaller leaves quantity
+            QuantityValue quantity = std::min(resting_order_ptr->LeavesQuantity, order_ptr->LeavesQuantity);
+            ReduceOrder(resting_order_ptr, quantity, false, true);
+            order_ptr->LeavesQuantity -= quantity;
+            break;
+        }
+        default:
+            assert(false && "Unsupported self-trade prevention mode!");
+            break;
+    }
+
+    // Check if the order could be matched further
+    return (order_ptr->LeavesQuantity > 0);
+}
+
+template <class TLevels>
+bool MarketManagerT<TLevels>::ExecuteAllocation(OrderBook* order_book_ptr, LevelNode* level_ptr, Order* order_ptr, uint64_t owner_id, PriceValue price, uint64_t volume)
+{
+    // Price-time priority is executed by the caller
+    AllocationType allocation = order_book_ptr->_allocation;
+    if (allocation == AllocationType::FIFO)
+        return false;
+
+    // Price levels with 'All-Or-None' orders are executed in the price-time priority
+    if (level_ptr->AONOrders > 0)
+        return false;
+
+    // Exclude displayed orders of the given owner, which are handled by the self-trade prevention
+    uint64_t total = CalculateAllocationVolume(level_ptr, owner_id);
+
+    // Price levels which displayed slices are taken entirely are executed in the price-time priority
+    if (volume >= total)
+        return false;
+
+    size_t first = _allocations.size();
+
+    // Allocate the top order first
+    const OrderNode* top_order_ptr = (allocation == AllocationType::TOP_ORDER_PRO_RATA) ? level_ptr->TopOrder : nullptr;
+    if ((top_order_ptr != nullptr) && (owner_id != 0) && (top_order_ptr->OwnerId == owner_id))
+        top_order_ptr = nullptr;
+    uint64_t remaining = volume;
+    uint64_t top = 0;
+    if (top_order_ptr != nullptr)
+    {
+        top = std::min<uint64_t>(top_order_ptr->VisibleQuantity(), remaining);
+        remaining -= top;
+        total -= top_order_ptr->VisibleQuantity();
+    }
+
+    // Allocate the remaining volume proportionally to the displayed orders visible quantity
+    uint64_t allocated = 0;
+    for (OrderNode* resting_order_ptr = level_ptr->OrderList.front(); resting_order_ptr != nullptr; resting_order_ptr = resting_order_ptr->next)
+    {
+        // Skip displayed orders of the given owner
+        if ((owner_id != 0) && (resting_order_ptr->OwnerId == owner_id))
+            continue;
+
+        uint64_t quantity = (resting_order_ptr == top_order_ptr) ? top : CalculateProRata(remaining, resting_order_ptr->VisibleQuantity(), total);
+        _allocations.emplace_back(resting_order_ptr, (QuantityValue)quantity);
+        allocated += quantity;
+    }
+
+    // Allocate the rounding remainder in the time priority
+    uint64_t remainder = volume - allocated;
+    for (size_t i = first; (remainder > 0) && (i < _allocations.size()); ++i)
+    {
+        uint64_t quantity = std::min<uint64_t>(_allocations[i].first->VisibleQuantity() - _allocations[i].second, remainder);
+        _allocations[i].second += (QuantityValue)quantity;
+        remainder -= quantity;
+    }
+
+    // Execute allocated orders, which could be requeued by the 'iceberg' slice replenishment
+    size_t last = _allocations.size();
+    for (size_t i = first; i < last; ++i)
+    {
+        OrderNode* executing_order_ptr = _allocations[i].first;
+
+        // Get the execution quantity
+        QuantityValue quantity = _allocations[i].second;
+        if (quantity > 0)
+        {
+            // Call the corresponding handler
+            ExecuteRestingOrder(*executing_order_ptr, price, quantity);
+
+            // Update the corresponding market price
+            order_book_ptr->UpdateLastPrice(*executing_order_ptr, price);
+            order_book_ptr->UpdateMatchingPrice(*executing_order_ptr, price);
+
+            // Increase the order executed quantity
+            executing_order_ptr->ExecutedQuantity += quantity;
+
+            // Reduce the executing order in the order book
+            ReduceOrder(executing_order_ptr, quantity, true, true);
+
+            // Execute the aggressive order
+            if (order_ptr != nullptr)
+            {
+                // Call the corresponding handler
+                if (!_sweeping)
+                    _market_handler.onExecuteOrder(*order_ptr, price, quantity);
+
+                // Update the corresponding market price
+                order_book_ptr->UpdateLastPrice(*order_ptr, price);
+                order_book_ptr->UpdateMatchingPrice(*order_ptr, price);
+
+                // Increase the order executed quantity
+                order_ptr->ExecutedQuantity += quantity;
+
+                // Reduce the order leaves quantity
+                order_ptr->LeavesQuantity -= quantity;
+            }
+        }
+    }
+
+    _allocations.resize(first);
+
+    return true;
+}
+
+template <class TLevels>
+uint64_t MarketManagerT<TLevels>::CalculateAllocationVolume(const LevelNode* level_ptr, uint64_t owner_id) noexcept
+{
+    uint64_t total = level_ptr->VisibleVolume;
+
+    // Exclude displayed orders of the given owner
+    if (owner_id != 0)
+        for (const OrderNode* resting_order_ptr = level_ptr->OrderList.front(); resting_order_ptr != nullptr; resting_order_ptr = resting_order_ptr->next)
+            if (resting_order_ptr->OwnerId == owner_id)
+                total -= resting_order_ptr->VisibleQuantity();
+
+    return total;
+}
+
+template <class TLevels>
+uint64_t MarketManagerT<TLevels>::CalculateProRata(uint64_t volume, uint64_t quantity, uint64_t total) noexcept
+{
+    assert((volume < total) && "Pro-rata volume must be less than the total volume!");
+    if (volume == 0)
+        return 0;
+
+    // Fast path for the product without overflow
+    if (quantity <= (std::numeric_limits<uint64_t>::max() / volume))
+        return (volume * quantity) / total;
+
+    // Calculate floor(volume * quantity / total) by the binary long multiplication
+    // keeping the invariant volume * prefix(quantity) == result * total + rest
+    uint64_t result = 0;
+    uint64_t rest = 0;
+    for (int bit = 63; bit >= 0; --bit)
+    {
+        result <<= 1;
+        if (rest >= (total - rest))
+        {
+            rest -= (total - rest);
+            ++result;
+        }
+        else
+            rest <<= 1;
+
+        if ((quantity >> bit) & 1)
+        {
+            if (rest >= (total - volume))
+            {
+                rest -= (total - volume);
+                ++result;
+            }
+            else
+                rest += volume;
+        }
+    }
+    return result;
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::RecalculateTrailingStopPrice(OrderBook* order_book_ptr, LevelNode* level_ptr)
+{
+    if ((level_ptr == nullptr) || (order_book_ptr->_stops == nullptr))
         return;
 
-    uint64_t new_trailing_price;
+    PriceValue new_trailing_price;
 
     // Check if we should skip the recalculation because of the market price goes to the wrong direction
     if (level_ptr->Type == LevelType::ASK)
     {
-        uint64_t old_trailing_price = order_book_ptr->_trailing_ask_price;
+        PriceValue old_trailing_price = order_book_ptr->_stops->TrailingAskPrice;
         new_trailing_price = order_book_ptr->GetMarketTrailingStopPriceAsk();
-        order_book_ptr->_trailing_ask_price = new_trailing_price;
+        order_book_ptr->_stops->TrailingAskPrice = new_trailing_price;
+
+        // Move all tracking trailing buy stop orders at once
+        if (order_book_ptr->UpdateTrailingReferencePrice(LevelType::ASK, new_trailing_price))
+            UpdateTrackingStopOrders(order_book_ptr, order_book_ptr->_stops->BestTrailingBuyOffset);
+
         if (new_trailing_price >= old_trailing_price)
             return;
     }
     if (level_ptr->Type == LevelType::BID)
     {
-        uint64_t old_trailing_price = order_book_ptr->_trailing_bid_price;
+        PriceValue old_trailing_price = order_book_ptr->_stops->TrailingBidPrice;
         new_trailing_price = order_book_ptr->GetMarketTrailingStopPriceBid();
-        order_book_ptr->_trailing_bid_price = new_trailing_price;
+        order_book_ptr->_stops->TrailingBidPrice = new_trailing_price;
+
+        // Move all tracking trailing sell stop orders at once
+        if (order_book_ptr->UpdateTrailingReferencePrice(LevelType::BID, new_trailing_price))
+            UpdateTrackingStopOrders(order_book_ptr, order_book_ptr->_stops->BestTrailingSellOffset);
+
         if (new_trailing_price <= old_trailing_price)
             return;
     }
 
-    // Recalculate trailing stop orders
-    LevelNode* previous = nullptr;
-    LevelNode* current = (level_ptr->Type == LevelType::ASK) ? order_book_ptr->_best_trailing_buy_stop : order_book_ptr->_best_trailing_sell_stop;
-    while (current != nullptr)
+    size_t first = _trailing_orders.size();
+
+    // Gather trailing stop orders which stop price must be changed
+    LevelNode* current = (level_ptr->Type == LevelType::ASK) ? order_book_ptr->_stops->BestTrailingBuyStop : order_book_ptr->_stops->BestTrailingSellStop;
+    for (; current != nullptr; current = order_book_ptr->GetNextTrailingStopLevel(current))
+        for (OrderNode* order_ptr = current->OrderList.front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+            if (order_book_ptr->CalculateTrailingStopPrice(*order_ptr) != order_ptr->StopPrice)
+                _trailing_orders.push_back(order_ptr);
+
+    // Recalculate gathered trailing stop orders
+    for (size_t i = first; i < _trailing_orders.size(); ++i)
     {
-        bool recalculated = false;
+        OrderNode* order_ptr = _trailing_orders[i];
 
-        // Find the first order to recalculate
-        OrderNode* order_ptr = current->OrderList.front();
+        PriceValue new_stop_price = order_book_ptr->CalculateTrailingStopPrice(*order_ptr);
+
+        // Delete the order from the order book
+        order_book_ptr->DeleteTrailingStopOrder(order_ptr);
 
-        while (order_ptr != nullptr)
+        // Update the stop order price
+        switch (order_ptr->Type)
         {
-            // Find the next order to recalculate
-            OrderNode* next_order_ptr = order_ptr->next;
+            case OrderType::TRAILING_STOP:
+                order_ptr->StopPrice = new_stop_price;
+                break;
+            case OrderType::TRAILING_STOP_LIMIT:
+            {
+                int64_t diff = order_ptr->Price - order_ptr->StopPrice;
+                order_ptr->StopPrice = new_stop_price;
+                order_ptr->Price = order_ptr->StopPrice + diff;
+                break;
+            }
+            default:
+                assert(false && "Unsupported order type!");
+                break;
 
-            uint64_t old_stop_price = order_ptr->StopPrice;
-            uint64_t new_stop_price = order_book_ptr->CalculateTrailingStopPrice(*order_ptr);
+        }
 
-            // Trailing distance for the order must be changed
-            if (new_stop_price != old_stop_price)
-            {
-                // Delete the order from the order book
-                order_book_ptr->DeleteTrailingStopOrder(order_ptr);
+        // Call the corresponding handler
+        _market_handler.onUpdateOrder(*order_ptr);
 
-                // Update the stop order price
-                switch (order_ptr->Type)
-                {
-                    case OrderType::TRAILING_STOP:
-                        order_ptr->StopPrice = new_stop_price;
-                        break;
-                    case OrderType::TRAILING_STOP_LIMIT:
-                    {
-                        int64_t diff = order_ptr->Price - order_ptr->StopPrice;
-                        order_ptr->StopPrice = new_stop_price;
-                        order_ptr->Price = order_ptr->StopPrice + diff;
-                        break;
-                    }
-                    default:
-                        assert(false && "Unsupported order type!");
-                        break;
+        // Add the new stop order into the order book. Trailing stop order
+        // reached the trailing reference price starts to track it.
+        order_book_ptr->AddTrailingStopOrder(order_ptr);
+    }
 
-                }
+    _trailing_orders.resize(first);
+}
 
-                // Call the corresponding handler
-                _market_handler.onUpdateOrder(*order_ptr);
+template <class TLevels>
+void MarketManagerT<TLevels>::UpdateTrackingStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr)
+{
+    // Tracking trailing stop orders stay in their price levels, only their stop price is updated
+    for (; level_ptr != nullptr; level_ptr = order_book_ptr->GetNextTrailingOffsetLevel(level_ptr))
+    {
+        for (OrderNode* order_ptr = level_ptr->OrderList.front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+        {
+            // Update the stop price of the tracking trailing stop order
+            order_book_ptr->UpdateTrailingOffsetStopPrice(order_ptr);
 
-                // Add the new stop order into the order book
-                order_book_ptr->AddTrailingStopOrder(order_ptr);
+            // Call the corresponding handler
+            _market_handler.onUpdateOrder(*order_ptr);
+        }
+    }
+}
 
-                recalculated = true;
-            }
+template <class TLevels>
+void MarketManagerT<TLevels>::Uncross()
+{
+    for (auto order_book_ptr : _order_books)
+        if (order_book_ptr != nullptr)
+            Uncross(order_book_ptr);
+}
 
-            // Move to the next order to recalculate at the same price level
-            order_ptr = next_order_ptr;
+template <class TLevels>
+void MarketManagerT<TLevels>::Uncross(OrderBook* order_book_ptr)
+{
+    // Calculate the equilibrium price and the executable volume
+    PriceValue price;
+    uint64_t volume = CalculateAuction(order_book_ptr, price);
+    if (volume == 0)
+        return;
+
+    // Execute crossed orders of both sides at the equilibrium price
+    ExecuteAuction(order_book_ptr, order_book_ptr->_best_bid, price, volume);
+    ExecuteAuction(order_book_ptr, order_book_ptr->_best_ask, price, volume);
+
+    // Activate stop orders triggered by the auction price
+    ActivateStopOrders(order_book_ptr);
+}
+
+template <class TLevels>
+uint64_t MarketManagerT<TLevels>::CalculateAuction(OrderBook* order_book_ptr, PriceValue& price) const
+{
+    // Check the arbitrage bid/ask prices
+    LevelNode* best_bid_ptr = order_book_ptr->_best_bid;
+    LevelNode* best_ask_ptr = order_book_ptr->_best_ask;
+    if ((best_bid_ptr == nullptr) || (best_ask_ptr == nullptr) || (best_bid_ptr->Price < best_ask_ptr->Price))
+        return 0;
+
+    // Collect crossed bid price levels from the best one
+    uint64_t demand = 0;
+    _auction_bids.clear();
+    for (LevelNode* level_ptr = best_bid_ptr; (level_ptr != nullptr) && (level_ptr->Price >= best_ask_ptr->Price); level_ptr = order_book_ptr->GetNextLevel(level_ptr))
+    {
+        uint64_t level_volume = CalculateAuctionVolume(level_ptr);
+        _auction_bids.emplace_back(level_ptr->Price, level_volume);
+        demand += level_volume;
+    }
+
+    // Collect crossed ask price levels from the best one
+    _auction_asks.clear();
+    for (LevelNode* level_ptr = best_ask_ptr; (level_ptr != nullptr) && (level_ptr->Price <= best_bid_ptr->Price); level_ptr = order_book_ptr->GetNextLevel(level_ptr))
+        _auction_asks.emplace_back(level_ptr->Price, CalculateAuctionVolume(level_ptr));
+
+    uint64_t result = 0;
+    uint64_t result_imbalance = 0;
+    uint64_t supply = 0;
+
+    // Walk through all candidate prices from the lowest one over cumulative volume curves
+    size_t ask = 0;
+    size_t bid = _auction_bids.size();
+    while ((ask < _auction_asks.size()) || (bid > 0))
+    {
+        PriceValue candidate = std::numeric_limits<PriceValue>::max();
+        if (ask < _auction_asks.size())
+            candidate = std::min(candidate, _auction_asks[ask].first);
+        if (bid > 0)
+            candidate = std::min(candidate, _auction_bids[bid - 1].first);
+
+        // Supply includes all asks with prices not greater than the candidate price
+        while ((ask < _auction_asks.size()) && (_auction_asks[ask].first <= candidate))
+            supply += _auction_asks[ask++].second;
+
+        // Check the executable volume and the imbalance at the candidate price
+        uint64_t volume = std::min(demand, supply);
+        uint64_t imbalance = (demand > supply) ? (demand - supply) : (supply - demand);
+        if ((volume > 0) && ((volume > result) || ((volume == result) && ((imbalance < result_imbalance) || ((imbalance == result_imbalance) && (demand > supply))))))
+        {
+            price = candidate;
+            result = volume;
+            result_imbalance = imbalance;
         }
 
-        if (recalculated)
+        // Demand includes all bids with prices not less than the candidate price
+        while ((bid > 0) && (_auction_bids[bid - 1].first <= candidate))
+            demand -= _auction_bids[--bid].second;
+    }
+
+    return result;
+}
+
+template <class TLevels>
+uint64_t MarketManagerT<TLevels>::CalculateAuctionVolume(const LevelNode* level_ptr) const noexcept
+{
+    // Exclude 'All-Or-None' orders from the call auction
+    return level_ptr->TotalVolume - level_ptr->AONVolume;
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::ExecuteAuction(OrderBook* order_book_ptr, LevelNode* level_ptr, PriceValue price, uint64_t volume)
+{
+    // Execute orders in the price-time priority until the auction volume is exhausted
+    while ((volume > 0) && (level_ptr != nullptr))
+    {
+        // Get the next price level to execute
+        LevelNode* next_level_ptr = order_book_ptr->GetNextLevel(level_ptr);
+
+        // Find the first order to execute
+        OrderNode* executing_order_ptr = level_ptr->FrontOrder();
+
+        // Execute all orders in the current price level
+        while ((volume > 0) && (executing_order_ptr != nullptr))
         {
-            // Back to the previous stop price level
-            current = (previous != nullptr) ? previous : ((level_ptr->Type == LevelType::ASK) ? order_book_ptr->_best_trailing_buy_stop : order_book_ptr->_best_trailing_sell_stop);
+            // Find the next order to execute
+            OrderNode* next_executing_order_ptr = level_ptr->NextOrder(executing_order_ptr);
+
+            // Skip 'All-Or-None' orders
+            if (!executing_order_ptr->IsAON())
+            {
+                // Get the execution quantity
+                QuantityValue quantity = (QuantityValue)std::min<uint64_t>(executing_order_ptr->LeavesQuantity, volume);
+
+                // Call the corresponding handler
+                _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
+
+                // Update the corresponding market price
+                order_book_ptr->UpdateLastPrice(*executing_order_ptr, price);
+
+                // Increase the order executed quantity
+                executing_order_ptr->ExecutedQuantity += quantity;
+
+                // Reduce the executing order in the order book
+                ReduceOrder(executing_order_ptr, quantity, true, true);
+
+                // Reduce the auction volume
+                volume -= quantity;
+            }
+
+            // Move to the next order to execute at the same price level
+            executing_order_ptr = next_executing_order_ptr;
         }
+
+        // Move to the next price level
+        level_ptr = next_level_ptr;
+    }
+}
+
+template <class TLevels>
+ErrorCode MarketManagerT<TLevels>::FindOrder(uint64_t id, OrderNode*& order_ptr)
+{
+    // Validate parameters
+    assert((id > 0) && "Order Id must be greater than zero!");
+    if ((id == 0) || !IsRepresentable<OrderIdValue>(id))
+        return ErrorCode::ORDER_ID_INVALID;
+
+    // Get the order by Id
+    auto order_it = _orders.find((OrderIdValue)id);
+    if (order_it == _orders.end())
+        return ErrorCode::ORDER_NOT_FOUND;
+
+    order_ptr = (OrderNode*)order_it->second;
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::EraseOrders(OrderBook* order_book_ptr, const TLevels& levels)
+{
+    for (const auto& level : levels)
+    {
+        EraseOrders(order_book_ptr, (OrderNode*)level.OrderList.front());
+        EraseOrders(order_book_ptr, (OrderNode*)level.HiddenOrderList.front());
+    }
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::EraseOrders(OrderBook* order_book_ptr, OrderNode* order_ptr)
+{
+    while (order_ptr != nullptr)
+    {
+        // Get the next order before the current one is released
+        OrderNode* next_order_ptr = order_ptr->next;
+
+        // Erase the order
+        _orders.erase(order_ptr->Id);
+
+        // Release the order. Orders of the order book memory arena are released wholesale.
+        if (!order_book_ptr->has_arena())
+            ReleaseOrder(order_book_ptr, order_ptr);
+        else if (order_ptr == _handle_order)
+            _handle_order = nullptr;
+
+        order_ptr = next_order_ptr;
+    }
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::ReleaseOrder(OrderBook* order_book_ptr, OrderNode* order_ptr)
+{
+    // Clear the order node of the order handle in progress
+    if (order_ptr == _handle_order)
+        _handle_order = nullptr;
+
+    // Release the order
+    order_book_ptr->ReleaseOrder(order_ptr);
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::ExecuteRestingOrder(const Order& order, PriceValue price, QuantityValue quantity)
+{
+    // Collect the resting order fill of the sweep
+    if (_sweeping)
+        _sweep_fills.push_back(Fill{ order.Id, price, quantity });
+    else
+        _market_handler.onExecuteOrder(order, price, quantity);
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::UpdateRestingOrder(const Order& order, UpdateType type)
+{
+    // Collect the resting order update of the sweep
+    if (_sweeping)
+        _sweep_orders.emplace_back(type, order);
+    else if (type == UpdateType::DELETE)
+        _market_handler.onDeleteOrder(order);
+    else
+        _market_handler.onUpdateOrder(order);
+}
+
+template <class TLevels>
+void MarketManagerT<TLevels>::UpdateSweep(const OrderBook& order_book, const Order& order)
+{
+    // Publish the top of the book before calling handlers
+    if (!_sweep_levels.empty())
+        order_book.PublishTopOfBook();
+
+    // Call the corresponding handler
+    if (!_sweep_fills.empty())
+        _market_handler.onExecuteSweep(order, _sweep_fills.data(), _sweep_fills.size());
+
+    // Call the corresponding handlers for all updated and deleted resting orders
+    for (const auto& update : _sweep_orders)
+    {
+        if (update.first == UpdateType::DELETE)
+            _market_handler.onDeleteOrder(update.second);
         else
+            _market_handler.onUpdateOrder(update.second);
+    }
+
+    // Call the corresponding handlers for all touched price levels
+    for (const auto& update : _sweep_levels)
+    {
+        switch (update.Type)
         {
-            // Move to the next stop price level
-            previous = current;
-            current = order_book_ptr->GetNextTrailingStopLevel(current);
+            case UpdateType::ADD:
+                _market_handler.onAddLevel(order_book, update.Update, update.Top);
+                break;
+            case UpdateType::UPDATE:
+                _market_handler.onUpdateLevel(order_book, update.Update, update.Top);
+                break;
+            case UpdateType::DELETE:
+                _market_handler.onDeleteLevel(order_book, update.Update, update.Top);
+                break;
+            default:
+                break;
         }
     }
+
+    // Call the corresponding handler
+    if (!_sweep_levels.empty())
+        _market_handler.onUpdateOrderBook(order_book, _sweep_top, 0);
+
+    _sweep_fills.clear();
+    _sweep_orders.clear();
+    _sweep_levels.clear();
+    _sweep_top = false;
 }
 
-void MarketManager::UpdateLevel(const OrderBook& order_book, const LevelUpdate& update, int symbol_id) const
+template <class TLevels>
+void MarketManagerT<TLevels>::UpdateLevel(const OrderBook& order_book, const LevelUpdate& update, int symbol_id)
 {
+    // Consolidate price level updates of the sweep
+    if (_sweeping)
+    {
+        _sweep_top |= update.Top;
+
+        // Merge the update with the previous update of the same price level
+        if (!_sweep_levels.empty() && (_sweep_levels.back().Update.Type == update.Update.Type) && (_sweep_levels.back().Update.Price == update.Update.Price))
+        {
+            LevelUpdate& last = _sweep_levels.back();
+            UpdateType type = ((last.Type == UpdateType::ADD) && (update.Type == UpdateType::UPDATE)) ? UpdateType::ADD : update.Type;
+            last = LevelUpdate(type, update.Update, last.Top || update.Top);
+        }
+        else
+            _sweep_levels.push_back(update);
+        return;
+    }
+
+    // Publish the top of the book before calling handlers
+    order_book.PublishTopOfBook();
+
     switch (update.Type)
     {
         case UpdateType::ADD:
@@ -1758,5 +2805,10 @@ void MarketManager::UpdateLevel(const OrderBook& order_book, const LevelUpdate&
     _market_handler.onUpdateOrderBook(order_book, update.Top, symbol_id);
 }
 
+// Explicit instantiation of the market manager for the supported price level containers
+template class MarketManagerT<LevelTree>;
+template class MarketManagerT<LevelVector>;
+template class MarketManagerT<LevelLadder>;
+
 } // namespace Matching
 } // namespace CppTrader
@@ -0,0 +1,696 @@
+/*!
+    \file market_manager_sharded.cpp
+    \brief Sharded market manager implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_manager_sharded.h"
+
+#include <algorithm>
+#include <bitset>
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TLevels>
+typename ShardedMarketManagerT<TLevels>::MarketHandler ShardedMarketManagerT<TLevels>::_default;
+
+template <class TLevels>
+ShardedMarketManagerT<TLevels>::ShardedMarketManagerT(MarketHandler& market_handler, size_t shards, size_t capacity)
+    : _market_handler(market_handler),
+      _running(false),
+      _started(false),
+      _matching(false),
+      _sequence(0),
+      _directory(capacity, 0)
+{
+    assert((capacity > 1) && ((capacity & (capacity - 1)) == 0) && "Ring queues capacity must be a power of two!");
+
+    // Use one shard per logical CPU core by default
+    if (shards == 0)
+        shards = std::max(CppCommon::CPU::LogicalCores(), 1);
+
+    _shards.reserve(shards);
+    for (size_t i = 0; i < shards; ++i)
+        _shards.emplace_back(new Shard(capacity));
+}
+
+template <class TLevels>
+ShardedMarketManagerT<TLevels>::~ShardedMarketManagerT()
+{
+    Stop();
+}
+
+template <class TLevels>
+bool ShardedMarketManagerT<TLevels>::Start(bool pin)
+{
+    if (IsStarted())
+        return false;
+
+    // Keep the current CPU core for the commands producer
+    int cores = CppCommon::CPU::LogicalCores();
+
+    _running = true;
+    for (size_t i = 0; i < _shards.size(); ++i)
+    {
+        int cpu = (pin && (cores > 1)) ? (int)((i + 1) % (size_t)std::min(cores, 64)) : -1;
+        Shard& shard = *_shards[i];
+        shard.Thread = CppCommon::Thread::Start([this, &shard, cpu]() { Run(shard, cpu); });
+    }
+
+    _started = true;
+    return true;
+}
+
+template <class TLevels>
+bool ShardedMarketManagerT<TLevels>::Stop()
+{
+    if (!IsStarted())
+        return false;
+
+    // Execute all routed commands and dispatch their events before stopping
+    Synchronize();
+
+    _running = false;
+    for (auto& shard : _shards)
+        shard->Thread.join();
+
+    _started = false;
+    return true;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::AddSymbol(const Symbol& symbol)
+{
+    Command command;
+    command.Type = CommandType::ADD_SYMBOL;
+    command.SymbolData = symbol;
+    Route(GetShard(symbol.Id), command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::DeleteSymbol(uint32_t id)
+{
+    Command command;
+    command.Type = CommandType::DELETE_SYMBOL;
+    command.Id = id;
+    Route(GetShard(id), command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::AddOrderBook(const Symbol& symbol, size_t size, uint64_t tick)
+{
+    Command command;
+    command.Type = CommandType::ADD_ORDER_BOOK;
+    command.SymbolData = symbol;
+    command.Size = size;
+    command.Price = tick;
+    Route(GetShard(symbol.Id), command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::DeleteOrderBook(uint32_t id)
+{
+    Command command;
+    command.Type = CommandType::DELETE_ORDER_BOOK;
+    command.Id = id;
+    Route(GetShard(id), command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::AddOrder(const Order& order)
+{
+    // Validate order parameters
+    ErrorCode result = order.Validate();
+    if (result != ErrorCode::OK)
+        return result;
+
+    // Register the order in the order Id directory
+    size_t shard = GetShard(order.SymbolId);
+    if (!_directory.insert(std::make_pair(order.Id, (uint32_t)shard)).second)
+        return ErrorCode::ORDER_DUPLICATE;
+
+    Command command;
+    command.Type = CommandType::ADD_ORDER;
+    command.OrderData = order;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::ReduceOrder(uint64_t id, uint64_t quantity)
+{
+    size_t shard;
+    ErrorCode result = FindShard(id, shard);
+    if (result != ErrorCode::OK)
+        return result;
+
+    Command command;
+    command.Type = CommandType::REDUCE_ORDER;
+    command.Id = id;
+    command.Quantity = quantity;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
+{
+    size_t shard;
+    ErrorCode result = FindShard(id, shard);
+    if (result != ErrorCode::OK)
+        return result;
+
+    Command command;
+    command.Type = CommandType::MODIFY_ORDER;
+    command.Id = id;
+    command.Price = new_price;
+    command.Quantity = new_quantity;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
+{
+    size_t shard;
+    ErrorCode result = FindShard(id, shard);
+    if (result != ErrorCode::OK)
+        return result;
+
+    Command command;
+    command.Type = CommandType::MITIGATE_ORDER;
+    command.Id = id;
+    command.Price = new_price;
+    command.Quantity = new_quantity;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity)
+{
+    size_t shard;
+    ErrorCode result = FindShard(id, shard);
+    if (result != ErrorCode::OK)
+        return result;
+
+    // Validate the new order Id, zero is the blank key of the order Id directory
+    assert((new_id > 0) && "New order Id must be greater than zero!");
+    if (new_id == 0)
+        return ErrorCode::ORDER_ID_INVALID;
+
+    // Register the new order Id in the order Id directory. The old order Id
+    // is released when the delete event of the replaced order is dispatched.
+    if (!_directory.insert(std::make_pair(new_id, (uint32_t)shard)).second)
+        return ErrorCode::ORDER_DUPLICATE;
+
+    Command command;
+    command.Type = CommandType::REPLACE_ORDER;
+    command.Id = id;
+    command.NewId = new_id;
+    command.Price = new_price;
+    command.Quantity = new_quantity;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::ReplaceOrder(uint64_t id, const Order& new_order)
+{
+    size_t shard;
+    ErrorCode result = FindShard(id, shard);
+    if (result != ErrorCode::OK)
+        return result;
+
+    // Validate new order parameters
+    result = new_order.Validate();
+    if (result != ErrorCode::OK)
+        return result;
+
+    // New order must be managed by the same shard
+    assert((GetShard(new_order.SymbolId) == shard) && "New order must have the same symbol shard!");
+    if (GetShard(new_order.SymbolId) != shard)
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+
+    // Register the new order Id in the order Id directory. The old order Id
+    // is released when the delete event of the replaced order is dispatched.
+    if (!_directory.insert(std::make_pair(new_order.Id, (uint32_t)shard)).second)
+        return ErrorCode::ORDER_DUPLICATE;
+
+    Command command;
+    command.Type = CommandType::REPLACE_ORDER_NEW;
+    command.Id = id;
+    command.OrderData = new_order;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::DeleteOrder(uint64_t id)
+{
+    size_t shard;
+    ErrorCode result = FindShard(id, shard);
+    if (result != ErrorCode::OK)
+        return result;
+
+    Command command;
+    command.Type = CommandType::DELETE_ORDER;
+    command.Id = id;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::ExecuteOrder(uint64_t id, uint64_t quantity)
+{
+    size_t shard;
+    ErrorCode result = FindShard(id, shard);
+    if (result != ErrorCode::OK)
+        return result;
+
+    Command command;
+    command.Type = CommandType::EXECUTE_ORDER;
+    command.Id = id;
+    command.Quantity = quantity;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity)
+{
+    size_t shard;
+    ErrorCode result = FindShard(id, shard);
+    if (result != ErrorCode::OK)
+        return result;
+
+    Command command;
+    command.Type = CommandType::EXECUTE_ORDER_PRICE;
+    command.Id = id;
+    command.Price = price;
+    command.Quantity = quantity;
+    Route(shard, command);
+    return ErrorCode::OK;
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::EnableMatching()
+{
+    _matching = true;
+
+    Command command;
+    command.Type = CommandType::ENABLE_MATCHING;
+    Broadcast(command);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::DisableMatching()
+{
+    _matching = false;
+
+    Command command;
+    command.Type = CommandType::DISABLE_MATCHING;
+    Broadcast(command);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::Match()
+{
+    Command command;
+    command.Type = CommandType::MATCH;
+    Broadcast(command);
+}
+
+template <class TLevels>
+size_t ShardedMarketManagerT<TLevels>::Dispatch()
+{
+    // Collect reported events of all shards. Sequence numbers of executed commands
+    // are loaded first, so all events of executed commands are already collected.
+    std::vector<uint64_t> executed(_shards.size());
+    for (size_t i = 0; i < _shards.size(); ++i)
+    {
+        executed[i] = _shards[i]->Executed.load(std::memory_order_acquire);
+        Collect(*_shards[i]);
+    }
+
+    size_t dispatched = 0;
+    for (;;)
+    {
+        // Find the pending event with the lowest command sequence number
+        size_t index = _shards.size();
+        uint64_t sequence = 0;
+        for (size_t i = 0; i < _shards.size(); ++i)
+        {
+            const Shard& shard = *_shards[i];
+            if ((shard.Position < shard.Pending.size()) && ((index == _shards.size()) || (shard.Pending[shard.Position].Sequence < sequence)))
+            {
+                index = i;
+                sequence = shard.Pending[shard.Position].Sequence;
+            }
+        }
+        if (index == _shards.size())
+            break;
+
+        // Shards without pending events must have executed all previous commands
+        bool ready = true;
+        for (size_t i = 0; i < _shards.size(); ++i)
+        {
+            const Shard& shard = *_shards[i];
+            if ((shard.Position == shard.Pending.size()) && (executed[i] < sequence) && (executed[i] < shard.Routed))
+            {
+                ready = false;
+                break;
+            }
+        }
+        if (!ready)
+            break;
+
+        // Dispatch the event to the market handler
+        Shard& shard = *_shards[index];
+        const Event& event = shard.Pending[shard.Position++];
+        switch (event.Type)
+        {
+            case EventType::ADD_SYMBOL:
+                _market_handler.onAddSymbol(event.SymbolData);
+                break;
+            case EventType::DELETE_SYMBOL:
+                _market_handler.onDeleteSymbol(event.SymbolData);
+                break;
+            case EventType::ADD_ORDER:
+                _market_handler.onAddOrder(event.OrderData);
+                break;
+            case EventType::UPDATE_ORDER:
+                _market_handler.onUpdateOrder(event.OrderData);
+                break;
+            case EventType::DELETE_ORDER:
+                _directory.erase(event.OrderData.Id);
+                _market_handler.onDeleteOrder(event.OrderData);
+                break;
+            case EventType::EXECUTE_ORDER:
+                _market_handler.onExecuteOrder(event.OrderData, event.Price, event.Quantity);
+                break;
+            case EventType::REJECT_ORDER:
+                _directory.erase(event.OrderData.Id);
+                continue;
+            default:
+                break;
+        }
+        ++dispatched;
+    }
+
+    // Release dispatched events
+    for (auto& shard : _shards)
+    {
+        if (shard->Position == shard->Pending.size())
+        {
+            shard->Pending.clear();
+            shard->Position = 0;
+        }
+    }
+
+    return dispatched;
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::Synchronize()
+{
+    for (;;)
+    {
+        bool idle = true;
+        for (const auto& shard : _shards)
+            if (shard->Executed.load(std::memory_order_acquire) < shard->Routed)
+                idle = false;
+
+        // Dispatch all events of executed commands
+        if (idle)
+        {
+            Dispatch();
+            return;
+        }
+
+        if (Dispatch() == 0)
+            CppCommon::Thread::Yield();
+    }
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::Route(size_t shard, Command& command)
+{
+    assert(IsStarted() && "Sharded market manager must be started before routing commands!");
+
+    Shard& target = *_shards[shard];
+    command.Sequence = ++_sequence;
+    target.Routed = command.Sequence;
+
+    // Collect reported events while the shard commands ring queue is full
+    while (!target.Commands.Enqueue(command))
+    {
+        for (auto& item : _shards)
+            Collect(*item);
+        CppCommon::Thread::Yield();
+    }
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::Broadcast(Command& command)
+{
+    assert(IsStarted() && "Sharded market manager must be started before routing commands!");
+
+    // Broadcast commands share the same sequence number in all shards
+    command.Sequence = ++_sequence;
+    for (auto& shard : _shards)
+    {
+        shard->Routed = command.Sequence;
+        while (!shard->Commands.Enqueue(command))
+        {
+            for (auto& item : _shards)
+                Collect(*item);
+            CppCommon::Thread::Yield();
+        }
+    }
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::Collect(Shard& shard)
+{
+    Event event;
+    while (shard.Handler.Events.Dequeue(event))
+        shard.Pending.push_back(event);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::Run(Shard& shard, int cpu)
+{
+    // Pin the worker thread to the given CPU core
+    if (cpu >= 0)
+    {
+        std::bitset<64> affinity;
+        affinity.set((size_t)cpu);
+        CppCommon::Thread::SetAffinity(affinity);
+    }
+
+    Command command;
+    for (;;)
+    {
+        if (!shard.Commands.Dequeue(command))
+        {
+            // Stop only when all routed commands are executed
+            if (!_running.load(std::memory_order_acquire) && shard.Commands.empty())
+                break;
+
+            CppCommon::Thread::Yield();
+            continue;
+        }
+
+        shard.Handler.Sequence = command.Sequence;
+        Execute(shard, command);
+        shard.Executed.store(command.Sequence, std::memory_order_release);
+    }
+}
+
+template <class TLevels>
+ErrorCode ShardedMarketManagerT<TLevels>::Execute(Shard& shard, const Command& command)
+{
+    MarketManager& manager = shard.Manager;
+
+    ErrorCode result = ErrorCode::OK;
+    switch (command.Type)
+    {
+        case CommandType::ADD_SYMBOL:
+            return manager.AddSymbol(command.SymbolData);
+        case CommandType::DELETE_SYMBOL:
+            return manager.DeleteSymbol((uint32_t)command.Id);
+        case CommandType::ADD_ORDER_BOOK:
+            return manager.AddOrderBook(command.SymbolData, command.Size, command.Price);
+        case CommandType::DELETE_ORDER_BOOK:
+            // Release order Ids of the deleted order book orders in the order Id directory
+            for (const auto& order : manager.orders())
+                if (order.second->SymbolId == (uint32_t)command.Id)
+                    shard.Handler.Report(EventType::REJECT_ORDER, *order.second);
+            return manager.DeleteOrderBook((uint32_t)command.Id);
+        case CommandType::ADD_ORDER:
+            // Release the order Id of the rejected order in the order Id directory
+            result = manager.AddOrder(command.OrderData);
+            if (result != ErrorCode::OK)
+                shard.Handler.Report(EventType::REJECT_ORDER, command.OrderData);
+            return result;
+        case CommandType::REDUCE_ORDER:
+            return manager.ReduceOrder(command.Id, command.Quantity);
+        case CommandType::MODIFY_ORDER:
+            return manager.ModifyOrder(command.Id, command.Price, command.Quantity);
+        case CommandType::MITIGATE_ORDER:
+            return manager.MitigateOrder(command.Id, command.Price, command.Quantity);
+        case CommandType::REPLACE_ORDER:
+            result = manager.ReplaceOrder(command.Id, command.NewId, command.Price, command.Quantity);
+            if (result != ErrorCode::OK)
+            {
+                Order order{};
+                order.Id = command.NewId;
+                shard.Handler.Report(EventType::REJECT_ORDER, order);
+            }
+            return result;
+        case CommandType::REPLACE_ORDER_NEW:
+            result = manager.ReplaceOrder(command.Id, command.OrderData);
+            if (result != ErrorCode::OK)
+                shard.Handler.Report(EventType::REJECT_ORDER, command.OrderData);
+            return result;
+        case CommandType::DELETE_ORDER:
+            return manager.DeleteOrder(command.Id);
+        case CommandType::EXECUTE_ORDER:
+            return manager.ExecuteOrder(command.Id, command.Quantity);
+        case CommandType::EXECUTE_ORDER_PRICE:
+            return manager.ExecuteOrder(command.Id, command.Price, command.Quantity);
+        case CommandType::ENABLE_MATCHING:
+            manager.EnableMatching();
+            return ErrorCode::OK;
+        case CommandType::DISABLE_MATCHING:
+            manager.DisableMatching();
+            return ErrorCode::OK;
+        case CommandType::MATCH:
+            manager.Match();
+            return ErrorCode::OK;
+        default:
+            return ErrorCode::OK;
+    }
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::Report(EventType type, const Order& order, PriceValue price, QuantityValue quantity)
+{
+    Event event;
+    event.Sequence = Sequence;
+    event.Type = type;
+    event.Price = price;
+    event.Quantity = quantity;
+    event.OrderData = order;
+
+    // Wait for the merged event stream consumer while the events ring queue is full
+    while (!Events.Enqueue(event))
+        CppCommon::Thread::Yield();
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::Report(EventType type, const Symbol& symbol)
+{
+    Event event;
+    event.Sequence = Sequence;
+    event.Type = type;
+    event.SymbolData = symbol;
+
+    // Wait for the merged event stream consumer while the events ring queue is full
+    while (!Events.Enqueue(event))
+        CppCommon::Thread::Yield();
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onAddSymbol(const Symbol& symbol)
+{
+    Handler->onAddSymbol(symbol);
+    Report(EventType::ADD_SYMBOL, symbol);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onDeleteSymbol(const Symbol& symbol)
+{
+    Handler->onDeleteSymbol(symbol);
+    Report(EventType::DELETE_SYMBOL, symbol);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onAddOrderBook(const OrderBook& order_book)
+{
+    Handler->onAddOrderBook(order_book);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onUpdateOrderBook(const OrderBook& order_book, bool top, int symbol_id)
+{
+    Handler->onUpdateOrderBook(order_book, top, symbol_id);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onDeleteOrderBook(const OrderBook& order_book)
+{
+    Handler->onDeleteOrderBook(order_book);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onAddLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    Handler->onAddLevel(order_book, level, top);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onUpdateLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    Handler->onUpdateLevel(order_book, level, top);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onDeleteLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    Handler->onDeleteLevel(order_book, level, top);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onAddOrder(const Order& order)
+{
+    Handler->onAddOrder(order);
+    Report(EventType::ADD_ORDER, order);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onUpdateOrder(const Order& order)
+{
+    Handler->onUpdateOrder(order);
+    Report(EventType::UPDATE_ORDER, order);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onDeleteOrder(const Order& order)
+{
+    Handler->onDeleteOrder(order);
+    Report(EventType::DELETE_ORDER, order);
+}
+
+template <class TLevels>
+void ShardedMarketManagerT<TLevels>::ShardHandler::onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity)
+{
+    Handler->onExecuteOrder(order, price, quantity);
+    Report(EventType::EXECUTE_ORDER, order, (PriceValue)price, (QuantityValue)quantity);
+}
+
+// Explicit instantiation of the sharded market manager for the supported price level containers
+template class ShardedMarketManagerT<LevelTree>;
+template class ShardedMarketManagerT<LevelVector>;
+template class ShardedMarketManagerT<LevelLadder>;
+
+} // namespace Matching
+} // namespace CppTrader
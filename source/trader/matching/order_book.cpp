@@ -12,120 +12,142 @@
 namespace CppTrader {
 namespace Matching {
 
-OrderBook::OrderBook(MarketManager& manager, const Symbol& symbol)
+template <class TLevels>
+OrderBookT<TLevels>::OrderBookT(MarketManager& manager, const Symbol& symbol, size_t size, uint64_t tick, size_t arena)
     : _manager(manager),
       _symbol(symbol),
+      _arena((arena > 0) ? new Arena(manager._auxiliary_memory_manager, arena) : nullptr),
       _best_bid(nullptr),
       _best_ask(nullptr),
-      _best_buy_stop(nullptr),
-      _best_sell_stop(nullptr),
-      _best_trailing_buy_stop(nullptr),
-      _best_trailing_sell_stop(nullptr),
+      _bids(LevelType::BID, size, tick),
+      _asks(LevelType::ASK, size, tick),
+      _levels_size(size),
+      _levels_tick(tick),
       _last_bid_price(0),
-      _last_ask_price(std::numeric_limits<uint64_t>::max()),
-      _matching_bid_price(0),
-      _matching_ask_price(std::numeric_limits<uint64_t>::max()),
-      _trailing_bid_price(0),
-      _trailing_ask_price(std::numeric_limits<uint64_t>::max())
+      _last_ask_price(std::numeric_limits<PriceValue>::max()),
+      _last_price(0),
+      _bid_depth(LevelType::BID),
+      _ask_depth(LevelType::ASK),
+      _allocation(AllocationType::FIFO)
 {
 }
 
-OrderBook::~OrderBook()
+template <class TLevels>
+OrderBookT<TLevels>::~OrderBookT()
 {
-    // Release bid price levels
+    // Collect all price levels before release, because price level
+    // containers navigate through links stored in price levels
+    std::vector<LevelNode*> levels;
+    levels.reserve(size());
     for (auto& bid : _bids)
-        _manager._level_pool.Release(&bid);
-    _bids.clear();
-
-    // Release ask price levels
+        levels.push_back(&bid);
     for (auto& ask : _asks)
-        _manager._level_pool.Release(&ask);
+        levels.push_back(&ask);
+    if (_stops != nullptr)
+    {
+        for (auto& buy_stop : _stops->BuyStop)
+            levels.push_back(&buy_stop);
+        for (auto& sell_stop : _stops->SellStop)
+            levels.push_back(&sell_stop);
+        for (auto& trailing_buy_stop : _stops->TrailingBuyStop)
+            levels.push_back(&trailing_buy_stop);
+        for (auto& trailing_sell_stop : _stops->TrailingSellStop)
+            levels.push_back(&trailing_sell_stop);
+        for (auto& trailing_buy_offset : _stops->TrailingBuyOffset)
+            levels.push_back(&trailing_buy_offset);
+        for (auto& trailing_sell_offset : _stops->TrailingSellOffset)
+            levels.push_back(&trailing_sell_offset);
+    }
+
+    // Clear all price level containers
+    _bids.clear();
     _asks.clear();
+    if (_stops != nullptr)
+    {
+        _stops->BuyStop.clear();
+        _stops->SellStop.clear();
+        _stops->TrailingBuyStop.clear();
+        _stops->TrailingSellStop.clear();
+        _stops->TrailingBuyOffset.clear();
+        _stops->TrailingSellOffset.clear();
+    }
+
+    // Release all price levels
+    for (auto level_ptr : levels)
+        ReleaseLevel(level_ptr);
+}
 
-    // Release buy stop orders levels
-    for (auto& buy_stop : _buy_stop)
-        _manager._level_pool.Release(&buy_stop);
-    _buy_stop.clear();
-
-    // Release sell stop orders levels
-    for (auto& sell_stop : _sell_stop)
-        _manager._level_pool.Release(&sell_stop);
-    _sell_stop.clear();
-
-    // Release trailing buy stop orders levels
-    for (auto& trailing_buy_stop : _trailing_buy_stop)
-        _manager._level_pool.Release(&trailing_buy_stop);
-    _trailing_buy_stop.clear();
-
-    // Release trailing sell stop orders levels
-    for (auto& trailing_sell_stop : _trailing_sell_stop)
-        _manager._level_pool.Release(&trailing_sell_stop);
-    _trailing_sell_stop.clear();
+template <class TLevels>
+OrderBookT<TLevels>::Arena::Arena(CppCommon::DefaultMemoryManager& auxiliary, size_t chunk)
+    : LevelMemoryManager(auxiliary, chunk),
+      LevelPool(LevelMemoryManager),
+      OrderMemoryManager(auxiliary, chunk),
+      OrderPool(OrderMemoryManager)
+{
 }
 
-LevelNode* OrderBook::AddLevel(OrderNode* order_ptr)
+template <class TLevels>
+LevelNode* OrderBookT<TLevels>::AddLevel(OrderNode* order_ptr)
 {
     LevelNode* level_ptr = nullptr;
 
     if (order_ptr->IsBuy())
     {
         // Create a new price level
-        level_ptr = _manager._level_pool.Create(LevelType::BID, order_ptr->Price);
+        level_ptr = CreateLevel(LevelType::BID, order_ptr->Price);
 
         // Insert the price level into the bid collection
         _bids.insert(*level_ptr);
 
         // Update the best bid price level
-        if ((_best_bid == nullptr) || (level_ptr->Price > _best_bid->Price))
-            _best_bid = level_ptr;
+        _best_bid = _bids.best();
     }
     else
     {
         // Create a new price level
-        level_ptr = _manager._level_pool.Create(LevelType::ASK, order_ptr->Price);
+        level_ptr = CreateLevel(LevelType::ASK, order_ptr->Price);
 
         // Insert the price level into the ask collection
         _asks.insert(*level_ptr);
 
         // Update the best ask price level
-        if ((_best_ask == nullptr) || (level_ptr->Price < _best_ask->Price))
-            _best_ask = level_ptr;
+        _best_ask = _asks.best();
     }
 
     return level_ptr;
 }
 
-LevelNode* OrderBook::DeleteLevel(OrderNode* order_ptr)
+template <class TLevels>
+LevelNode* OrderBookT<TLevels>::DeleteLevel(OrderNode* order_ptr)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
     if (order_ptr->IsBuy())
     {
-        // Update the best bid price level
-        if (level_ptr == _best_bid)
-            _best_bid = (_best_bid->left != nullptr) ? _best_bid->left : ((_best_bid->parent != nullptr) ? _best_bid->parent : _best_bid->right);
-
         // Erase the price level from the bid collection
-        _bids.erase(Levels::iterator(&_bids, level_ptr));
+        _bids.erase(*level_ptr);
+
+        // Update the best bid price level
+        _best_bid = _bids.best();
     }
     else
     {
-        // Update the best ask price level
-        if (level_ptr == _best_ask)
-            _best_ask = (_best_ask->right != nullptr) ? _best_ask->right : ((_best_ask->parent != nullptr) ? _best_ask->parent : _best_ask->left);
-
         // Erase the price level from the ask collection
-        _asks.erase(Levels::iterator(&_asks, level_ptr));
+        _asks.erase(*level_ptr);
+
+        // Update the best ask price level
+        _best_ask = _asks.best();
     }
 
     // Release the price level
-    _manager._level_pool.Release(level_ptr);
+    ReleaseLevel(level_ptr);
 
     return nullptr;
 }
 
-LevelUpdate OrderBook::AddOrder(OrderNode* order_ptr)
+template <class TLevels>
+LevelUpdate OrderBookT<TLevels>::AddOrder(OrderNode* order_ptr)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->IsBuy() ? (LevelNode*)GetBid(order_ptr->Price) : (LevelNode*)GetAsk(order_ptr->Price);
@@ -143,18 +165,53 @@ LevelUpdate OrderBook::AddOrder(OrderNode* order_ptr)
     level_ptr->HiddenVolume += order_ptr->HiddenQuantity();
     level_ptr->VisibleVolume += order_ptr->VisibleQuantity();
 
-    // Link the new order to the orders list of the price level
-    level_ptr->OrderList.push_back(*order_ptr);
+    // Update the price level 'All-Or-None' volume
+    if (order_ptr->IsAON())
+    {
+        level_ptr->AONVolume += order_ptr->LeavesQuantity;
+        ++level_ptr->AONOrders;
+    }
+
+    // Link the new order to the hidden or displayed orders list of the price level
+    if (order_ptr->IsHidden())
+    {
+        level_ptr->HiddenOrderList.push_back(*order_ptr);
+        level_ptr->HiddenOrderVolume += order_ptr->LeavesQuantity;
+        ++level_ptr->HiddenOrders;
+    }
+    else
+        level_ptr->OrderList.push_back(*order_ptr);
     ++level_ptr->Orders;
 
+    // Update the price level owners filter
+    level_ptr->OwnerMask |= order_ptr->OwnerMask();
+
     // Cache the price level in the given order
     order_ptr->Level = level_ptr;
 
+    // The displayed order which opened a new best price level becomes its top order
+    if ((update == UpdateType::ADD) && !order_ptr->IsHidden() && (level_ptr == (order_ptr->IsBuy() ? _best_bid : _best_ask)))
+        level_ptr->TopOrder = order_ptr;
+
+    // Push the new order to the active price level queue
+    LevelQueue& queue = order_ptr->IsHidden() ? level_ptr->HiddenQueue : level_ptr->Queue;
+    if (queue.active())
+    {
+        if (queue.full())
+            RebuildQueue(level_ptr);
+        else
+            order_ptr->Sequence = queue.push(order_ptr->VisibleQuantity(), order_ptr->HiddenQuantity());
+    }
+
+    // Update the price level depth cache
+    UpdateDepth(update, *level_ptr);
+
     // Price level was changed. Return top of the book modification flag.
     return LevelUpdate(update, *order_ptr->Level, (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask)));
 }
 
-LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible)
+template <class TLevels>
+LevelUpdate OrderBookT<TLevels>::ReduceOrder(OrderNode* order_ptr, QuantityValue quantity, QuantityValue hidden, QuantityValue visible)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
@@ -164,13 +221,51 @@ LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint
     level_ptr->HiddenVolume -= hidden;
     level_ptr->VisibleVolume -= visible;
 
+    // Update the price level 'All-Or-None' volume
+    if (order_ptr->IsAON())
+    {
+        level_ptr->AONVolume -= quantity;
+        if (order_ptr->LeavesQuantity == 0)
+            --level_ptr->AONOrders;
+    }
+
+    // Update the price level hidden orders volume
+    if (order_ptr->IsHidden())
+    {
+        level_ptr->HiddenOrderVolume -= quantity;
+        if (order_ptr->LeavesQuantity == 0)
+            --level_ptr->HiddenOrders;
+    }
+
+    // Reduce the order in the active price level queue
+    LevelQueue& queue = order_ptr->IsHidden() ? level_ptr->HiddenQueue : level_ptr->Queue;
+    if (queue.active())
+    {
+        if (order_ptr->LeavesQuantity == 0)
+            queue.erase(order_ptr->Sequence, visible, hidden);
+        else
+            queue.reduce(order_ptr->Sequence, visible, hidden);
+    }
+
     // Unlink the empty order from the orders list of the price level
     if (order_ptr->LeavesQuantity == 0)
     {
-        level_ptr->OrderList.pop_current(*order_ptr);
+        (order_ptr->IsHidden() ? level_ptr->HiddenOrderList : level_ptr->OrderList).pop_current(*order_ptr);
         --level_ptr->Orders;
+
+        // Mark the price level owners filter as stale
+        if (order_ptr->OwnerId != 0)
+            level_ptr->OwnerMaskStale = true;
+
+        // Clear the price level top order
+        if (level_ptr->TopOrder == order_ptr)
+            level_ptr->TopOrder = nullptr;
     }
 
+    // Replenish the executed displayed slice of the 'iceberg' order
+    if ((order_ptr->LeavesQuantity > 0) && !order_ptr->IsHidden() && (order_ptr->VisibleQuantity() == 0))
+        ReplenishOrder(order_ptr);
+
     Level level(*level_ptr);
 
     // Delete the empty price level
@@ -182,11 +277,15 @@ LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint
         update = UpdateType::DELETE;
     }
 
+    // Update the price level depth cache
+    UpdateDepth(update, level);
+
     // Price level was changed. Return top of the book modification flag.
     return LevelUpdate(update, level, ((order_ptr->Level == nullptr) || (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask))));
 }
 
-LevelUpdate OrderBook::DeleteOrder(OrderNode* order_ptr)
+template <class TLevels>
+LevelUpdate OrderBookT<TLevels>::DeleteOrder(OrderNode* order_ptr)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
@@ -196,10 +295,37 @@ LevelUpdate OrderBook::DeleteOrder(OrderNode* order_ptr)
     level_ptr->HiddenVolume -= order_ptr->HiddenQuantity();
     level_ptr->VisibleVolume -= order_ptr->VisibleQuantity();
 
+    // Update the price level 'All-Or-None' volume
+    if (order_ptr->IsAON())
+    {
+        level_ptr->AONVolume -= order_ptr->LeavesQuantity;
+        --level_ptr->AONOrders;
+    }
+
+    // Update the price level hidden orders volume
+    if (order_ptr->IsHidden())
+    {
+        level_ptr->HiddenOrderVolume -= order_ptr->LeavesQuantity;
+        --level_ptr->HiddenOrders;
+    }
+
+    // Erase the order from the active price level queue
+    LevelQueue& queue = order_ptr->IsHidden() ? level_ptr->HiddenQueue : level_ptr->Queue;
+    if (queue.active())
+        queue.erase(order_ptr->Sequence, order_ptr->VisibleQuantity(), order_ptr->HiddenQuantity());
+
     // Unlink the empty order from the orders list of the price level
-    level_ptr->OrderList.pop_current(*order_ptr);
+    (order_ptr->IsHidden() ? level_ptr->HiddenOrderList : level_ptr->OrderList).pop_current(*order_ptr);
     --level_ptr->Orders;
 
+    // Mark the price level owners filter as stale
+    if (order_ptr->OwnerId != 0)
+        level_ptr->OwnerMaskStale = true;
+
+    // Clear the price level top order
+    if (level_ptr->TopOrder == order_ptr)
+        level_ptr->TopOrder = nullptr;
+
     Level level(*level_ptr);
 
     // Delete the empty price level
@@ -211,74 +337,253 @@ LevelUpdate OrderBook::DeleteOrder(OrderNode* order_ptr)
         update = UpdateType::DELETE;
     }
 
+    // Update the price level depth cache
+    UpdateDepth(update, level);
+
     // Price level was changed. Return top of the book modification flag.
     return LevelUpdate(update, level, ((order_ptr->Level == nullptr) || (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask))));
 }
 
-LevelNode* OrderBook::AddStopLevel(OrderNode* order_ptr)
+template <class TLevels>
+void OrderBookT<TLevels>::ReplenishOrder(OrderNode* order_ptr)
+{
+    // Find the price level for the order
+    LevelNode* level_ptr = order_ptr->Level;
+
+    QuantityValue hidden = order_ptr->HiddenQuantity();
+
+    // Reload the displayed slice from the hidden quantity
+    order_ptr->SliceExecutedQuantity = 0;
+    QuantityValue visible = order_ptr->VisibleQuantity();
+
+    // Update the price level volume
+    level_ptr->HiddenVolume -= visible;
+    level_ptr->VisibleVolume += visible;
+
+    // Move the order to the end of the displayed orders list
+    level_ptr->OrderList.pop_current(*order_ptr);
+    level_ptr->OrderList.push_back(*order_ptr);
+
+    // Requeued order is not the price level top order anymore
+    if (level_ptr->TopOrder == order_ptr)
+        level_ptr->TopOrder = nullptr;
+
+    // Requeue the order in the active price level queue
+    if (level_ptr->Queue.active())
+    {
+        level_ptr->Queue.erase(order_ptr->Sequence, 0, hidden);
+        if (level_ptr->Queue.full())
+            RebuildQueue(level_ptr);
+        else
+            order_ptr->Sequence = level_ptr->Queue.push(visible, order_ptr->HiddenQuantity());
+    }
+}
+
+template <class TLevels>
+void OrderBookT<TLevels>::ResetDepth(size_t depth)
+{
+    _bid_depth.reset(depth);
+    _ask_depth.reset(depth);
+
+    // Fill depth caches with the top price levels
+    for (LevelNode* level_ptr = _best_bid; (level_ptr != nullptr) && !_bid_depth.full(); level_ptr = GetNextLevel(level_ptr))
+        _bid_depth.push_back(*level_ptr);
+    for (LevelNode* level_ptr = _best_ask; (level_ptr != nullptr) && !_ask_depth.full(); level_ptr = GetNextLevel(level_ptr))
+        _ask_depth.push_back(*level_ptr);
+}
+
+template <class TLevels>
+void OrderBookT<TLevels>::ResetTopOfBook(bool publish)
+{
+    if (!publish)
+    {
+        _top_of_book.reset();
+        return;
+    }
+
+    // Publish the current top of the book
+    if (_top_of_book == nullptr)
+        _top_of_book.reset(new TopOfBook());
+    PublishTopOfBook();
+}
+
+template <class TLevels>
+void OrderBookT<TLevels>::UpdateDepth(UpdateType update, const Level& level)
+{
+    LevelDepth& depth = level.IsBid() ? _bid_depth : _ask_depth;
+
+    // Skip disabled depth cache
+    if (depth.capacity() == 0)
+        return;
+
+    switch (update)
+    {
+        case UpdateType::ADD:
+            depth.insert(level);
+            break;
+        case UpdateType::UPDATE:
+            depth.update(level);
+            break;
+        case UpdateType::DELETE:
+        {
+            // Refill the full depth cache with the next price level
+            bool refill = depth.full();
+            if (depth.erase(level) && refill)
+            {
+                Levels& levels = level.IsBid() ? _bids : _asks;
+                LevelNode* next_ptr = depth.empty() ? (level.IsBid() ? _best_bid : _best_ask) : GetNextLevel(levels.find(depth[depth.size() - 1].Price));
+                if (next_ptr != nullptr)
+                    depth.push_back(*next_ptr);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+template <class TLevels>
+QueuePosition OrderBookT<TLevels>::GetQueuePosition(OrderNode* order_ptr)
+{
+    // Find the price level for the order
+    LevelNode* level_ptr = order_ptr->Level;
+
+    // Build price level queues on the first request
+    if (!level_ptr->Queue.active())
+        RebuildQueue(level_ptr);
+
+    if (!order_ptr->IsHidden())
+        return level_ptr->Queue.position(order_ptr->Sequence);
+
+    // Hidden orders are queued behind all displayed orders of the price level
+    QueuePosition position = level_ptr->HiddenQueue.position(order_ptr->Sequence);
+    position.Position += level_ptr->Orders - level_ptr->HiddenOrders;
+    position.VisibleVolume += level_ptr->VisibleVolume;
+    position.HiddenVolume += level_ptr->HiddenVolume - level_ptr->HiddenOrderVolume;
+    return position;
+}
+
+template <class TLevels>
+void OrderBookT<TLevels>::RebuildQueue(LevelNode* level_ptr)
+{
+    // Reset price level queues with the capacity twice the count of their orders
+    level_ptr->Queue.reset(std::max<size_t>(LevelQueue::MIN_CAPACITY, 2 * (size_t)(level_ptr->Orders - level_ptr->HiddenOrders)));
+    level_ptr->HiddenQueue.reset(std::max<size_t>(LevelQueue::MIN_CAPACITY, 2 * (size_t)level_ptr->HiddenOrders));
+
+    // Push all orders of the price level to their queues in the queue order
+    for (OrderNode* order_ptr = level_ptr->OrderList.front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+        order_ptr->Sequence = level_ptr->Queue.push(order_ptr->VisibleQuantity(), order_ptr->HiddenQuantity());
+    for (OrderNode* order_ptr = level_ptr->HiddenOrderList.front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+        order_ptr->Sequence = level_ptr->HiddenQueue.push(order_ptr->VisibleQuantity(), order_ptr->HiddenQuantity());
+}
+
+template <class TLevels>
+OrderBookT<TLevels>::StopBook::StopBook(size_t size, uint64_t tick)
+    : BestBuyStop(nullptr),
+      BestSellStop(nullptr),
+      BuyStop(LevelType::ASK, size, tick),
+      SellStop(LevelType::BID, size, tick),
+      BestTrailingBuyStop(nullptr),
+      BestTrailingSellStop(nullptr),
+      TrailingBuyStop(LevelType::ASK, size, tick),
+      TrailingSellStop(LevelType::BID, size, tick),
+      BestTrailingBuyOffset(nullptr),
+      BestTrailingSellOffset(nullptr),
+      TrailingBuyOffset(LevelType::ASK, size, tick),
+      TrailingSellOffset(LevelType::ASK, size, tick),
+      TrailingBuyReference(std::numeric_limits<PriceValue>::max()),
+      TrailingSellReference(0),
+      MatchingBidPrice(0),
+      MatchingAskPrice(std::numeric_limits<PriceValue>::max()),
+      TrailingBidPrice(0),
+      TrailingAskPrice(std::numeric_limits<PriceValue>::max())
+{
+}
+
+template <class TLevels>
+typename OrderBookT<TLevels>::StopBook& OrderBookT<TLevels>::GetStopBook()
+{
+    // Allocate the stop book on the first stop order
+    if (_stops == nullptr)
+        _stops.reset(new StopBook(_levels_size, _levels_tick));
+
+    return *_stops;
+}
+
+template <class TLevels>
+const TLevels& OrderBookT<TLevels>::EmptyLevels(LevelType type)
+{
+    static const Levels empty_bids(LevelType::BID);
+    static const Levels empty_asks(LevelType::ASK);
+    return (type == LevelType::BID) ? empty_bids : empty_asks;
+}
+
+template <class TLevels>
+LevelNode* OrderBookT<TLevels>::AddStopLevel(OrderNode* order_ptr)
 {
     LevelNode* level_ptr = nullptr;
 
     if (order_ptr->IsBuy())
     {
         // Create a new price level
-        level_ptr = _manager._level_pool.Create(LevelType::ASK, order_ptr->StopPrice);
+        level_ptr = CreateLevel(LevelType::ASK, order_ptr->StopPrice);
 
         // Insert the price level into the buy stop orders collection
-        _buy_stop.insert(*level_ptr);
+        _stops->BuyStop.insert(*level_ptr);
 
         // Update the best buy stop order price level
-        if ((_best_buy_stop == nullptr) || (level_ptr->Price < _best_buy_stop->Price))
-            _best_buy_stop = level_ptr;
+        _stops->BestBuyStop = _stops->BuyStop.best();
     }
     else
     {
         // Create a new price level
-        level_ptr = _manager._level_pool.Create(LevelType::BID, order_ptr->StopPrice);
+        level_ptr = CreateLevel(LevelType::BID, order_ptr->StopPrice);
 
         // Insert the price level into the sell stop orders collection
-        _sell_stop.insert(*level_ptr);
+        _stops->SellStop.insert(*level_ptr);
 
         // Update the best sell stop order price level
-        if ((_best_sell_stop == nullptr) || (level_ptr->Price > _best_sell_stop->Price))
-            _best_sell_stop = level_ptr;
+        _stops->BestSellStop = _stops->SellStop.best();
     }
 
     return level_ptr;
 }
 
-LevelNode* OrderBook::DeleteStopLevel(OrderNode* order_ptr)
+template <class TLevels>
+LevelNode* OrderBookT<TLevels>::DeleteStopLevel(OrderNode* order_ptr)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
     if (order_ptr->IsBuy())
     {
-        // Update the best buy stop order price level
-        if (level_ptr == _best_buy_stop)
-            _best_buy_stop = (_best_buy_stop->right != nullptr) ? _best_buy_stop->right : _best_buy_stop->parent;
-
         // Erase the price level from the buy stop orders collection
-        _buy_stop.erase(Levels::iterator(&_buy_stop, level_ptr));
+        _stops->BuyStop.erase(*level_ptr);
+
+        // Update the best buy stop order price level
+        _stops->BestBuyStop = _stops->BuyStop.best();
     }
     else
     {
-        // Update the best sell stop order price level
-        if (level_ptr == _best_sell_stop)
-            _best_sell_stop = (_best_sell_stop->left != nullptr) ? _best_sell_stop->left : _best_sell_stop->parent;
-
         // Erase the price level from the sell stop orders collection
-        _sell_stop.erase(Levels::iterator(&_sell_stop, level_ptr));
+        _stops->SellStop.erase(*level_ptr);
+
+        // Update the best sell stop order price level
+        _stops->BestSellStop = _stops->SellStop.best();
     }
 
     // Release the price level
-    _manager._level_pool.Release(level_ptr);
+    ReleaseLevel(level_ptr);
 
     return nullptr;
 }
 
-void OrderBook::AddStopOrder(OrderNode* order_ptr)
+template <class TLevels>
+void OrderBookT<TLevels>::AddStopOrder(OrderNode* order_ptr)
 {
+    // Allocate the stop book if necessary
+    GetStopBook();
+
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->IsBuy() ? (LevelNode*)GetBuyStopLevel(order_ptr->StopPrice) : (LevelNode*)GetSellStopLevel(order_ptr->StopPrice);
 
@@ -299,7 +604,8 @@ void OrderBook::AddStopOrder(OrderNode* order_ptr)
     order_ptr->Level = level_ptr;
 }
 
-void OrderBook::ReduceStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible)
+template <class TLevels>
+void OrderBookT<TLevels>::ReduceStopOrder(OrderNode* order_ptr, QuantityValue quantity, QuantityValue hidden, QuantityValue visible)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
@@ -324,7 +630,8 @@ void OrderBook::ReduceStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_
     }
 }
 
-void OrderBook::DeleteStopOrder(OrderNode* order_ptr)
+template <class TLevels>
+void OrderBookT<TLevels>::DeleteStopOrder(OrderNode* order_ptr)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
@@ -346,72 +653,112 @@ void OrderBook::DeleteStopOrder(OrderNode* order_ptr)
     }
 }
 
-LevelNode* OrderBook::AddTrailingStopLevel(OrderNode* order_ptr)
+template <class TLevels>
+LevelNode* OrderBookT<TLevels>::AddTrailingStopLevel(OrderNode* order_ptr)
 {
     LevelNode* level_ptr = nullptr;
 
-    if (order_ptr->IsBuy())
+    if (order_ptr->Tracking)
+    {
+        // Create a new price level keyed by the trailing distance. The price
+        // level type keeps the order side, while both offset collections take
+        // the nearest trailing distance as the best one.
+        level_ptr = CreateLevel(order_ptr->IsBuy() ? LevelType::ASK : LevelType::BID, (PriceValue)order_ptr->TrailingDistance);
+
+        // Insert the price level into the tracking trailing stop orders collection
+        Levels& offsets = order_ptr->IsBuy() ? _stops->TrailingBuyOffset : _stops->TrailingSellOffset;
+        offsets.insert(*level_ptr);
+
+        // Update the best tracking trailing stop order price level
+        (order_ptr->IsBuy() ? _stops->BestTrailingBuyOffset : _stops->BestTrailingSellOffset) = offsets.best();
+    }
+    else if (order_ptr->IsBuy())
     {
         // Create a new price level
-        level_ptr = _manager._level_pool.Create(LevelType::ASK, order_ptr->StopPrice);
+        level_ptr = CreateLevel(LevelType::ASK, order_ptr->StopPrice);
 
         // Insert the price level into the trailing buy stop orders collection
-        _trailing_buy_stop.insert(*level_ptr);
+        _stops->TrailingBuyStop.insert(*level_ptr);
 
         // Update the best trailing buy stop order price level
-        if ((_best_trailing_buy_stop == nullptr) || (level_ptr->Price < _best_trailing_buy_stop->Price))
-            _best_trailing_buy_stop = level_ptr;
+        _stops->BestTrailingBuyStop = _stops->TrailingBuyStop.best();
     }
     else
     {
         // Create a new price level
-        level_ptr = _manager._level_pool.Create(LevelType::BID, order_ptr->StopPrice);
+        level_ptr = CreateLevel(LevelType::BID, order_ptr->StopPrice);
 
         // Insert the price level into the trailing sell stop orders collection
-        _trailing_sell_stop.insert(*level_ptr);
+        _stops->TrailingSellStop.insert(*level_ptr);
 
         // Update the best trailing sell stop order price level
-        if ((_best_trailing_sell_stop == nullptr) || (level_ptr->Price > _best_trailing_sell_stop->Price))
-            _best_trailing_sell_stop = level_ptr;
+        _stops->BestTrailingSellStop = _stops->TrailingSellStop.best();
     }
 
     return level_ptr;
 }
 
-LevelNode* OrderBook::DeleteTrailingStopLevel(OrderNode* order_ptr)
+template <class TLevels>
+LevelNode* OrderBookT<TLevels>::DeleteTrailingStopLevel(OrderNode* order_ptr)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
-    if (order_ptr->IsBuy())
+    if (order_ptr->Tracking)
     {
-        // Update the best trailing buy stop order price level
-        if (level_ptr == _best_trailing_buy_stop)
-            _best_trailing_buy_stop = (_best_trailing_buy_stop->right != nullptr) ? _best_trailing_buy_stop->right : _best_trailing_buy_stop->parent;
+        // Erase the price level from the tracking trailing stop orders collection
+        Levels& offsets = order_ptr->IsBuy() ? _stops->TrailingBuyOffset : _stops->TrailingSellOffset;
+        offsets.erase(*level_ptr);
 
+        // Update the best tracking trailing stop order price level
+        (order_ptr->IsBuy() ? _stops->BestTrailingBuyOffset : _stops->BestTrailingSellOffset) = offsets.best();
+    }
+    else if (order_ptr->IsBuy())
+    {
         // Erase the price level from the trailing buy stop orders collection
-        _trailing_buy_stop.erase(Levels::iterator(&_trailing_buy_stop, level_ptr));
+        _stops->TrailingBuyStop.erase(*level_ptr);
+
+        // Update the best trailing buy stop order price level
+        _stops->BestTrailingBuyStop = _stops->TrailingBuyStop.best();
     }
     else
     {
-        // Update the best trailing sell stop order price level
-        if (level_ptr == _best_trailing_sell_stop)
-            _best_trailing_sell_stop = (_best_trailing_sell_stop->left != nullptr) ? _best_trailing_sell_stop->left : _best_trailing_sell_stop->parent;
-
         // Erase the price level from the trailing sell stop orders collection
-        _trailing_sell_stop.erase(Levels::iterator(&_trailing_sell_stop, level_ptr));
+        _stops->TrailingSellStop.erase(*level_ptr);
+
+        // Update the best trailing sell stop order price level
+        _stops->BestTrailingSellStop = _stops->TrailingSellStop.best();
     }
 
     // Release the price level
-    _manager._level_pool.Release(level_ptr);
+    ReleaseLevel(level_ptr);
 
     return nullptr;
 }
 
-void OrderBook::AddTrailingStopOrder(OrderNode* order_ptr)
+template <class TLevels>
+void OrderBookT<TLevels>::AddTrailingStopOrder(OrderNode* order_ptr)
 {
+    // Allocate the stop book if necessary
+    GetStopBook();
+
+    // Track the trailing reference price if possible
+    order_ptr->Tracking = IsTrailingOffsetOrder(order_ptr);
+    if (order_ptr->Tracking)
+    {
+        // The first tracking trailing stop order sets the trailing reference price
+        if (order_ptr->IsBuy() && _stops->TrailingBuyOffset.empty())
+            _stops->TrailingBuyReference = order_ptr->StopPrice - (PriceValue)order_ptr->TrailingDistance;
+        if (order_ptr->IsSell() && _stops->TrailingSellOffset.empty())
+            _stops->TrailingSellReference = order_ptr->StopPrice + (PriceValue)order_ptr->TrailingDistance;
+    }
+
     // Find the price level for the order
-    LevelNode* level_ptr = order_ptr->IsBuy() ? (LevelNode*)GetTrailingBuyStopLevel(order_ptr->StopPrice) : (LevelNode*)GetTrailingSellStopLevel(order_ptr->StopPrice);
+    LevelNode* level_ptr;
+    if (order_ptr->Tracking)
+        level_ptr = order_ptr->IsBuy() ? _stops->TrailingBuyOffset.find((PriceValue)order_ptr->TrailingDistance) : _stops->TrailingSellOffset.find((PriceValue)order_ptr->TrailingDistance);
+    else
+        level_ptr = order_ptr->IsBuy() ? (LevelNode*)GetTrailingBuyStopLevel(order_ptr->StopPrice) : (LevelNode*)GetTrailingSellStopLevel(order_ptr->StopPrice);
 
     // Create a new price level if no one found
     if (level_ptr == nullptr)
@@ -430,7 +777,8 @@ void OrderBook::AddTrailingStopOrder(OrderNode* order_ptr)
     order_ptr->Level = level_ptr;
 }
 
-void OrderBook::ReduceTrailingStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible)
+template <class TLevels>
+void OrderBookT<TLevels>::ReduceTrailingStopOrder(OrderNode* order_ptr, QuantityValue quantity, QuantityValue hidden, QuantityValue visible)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
@@ -453,10 +801,18 @@ void OrderBook::ReduceTrailingStopOrder(OrderNode* order_ptr, uint64_t quantity,
         // Clear the price level cache in the given order
         order_ptr->Level = DeleteTrailingStopLevel(order_ptr);
     }
+
+    // Stop tracking the trailing reference price by the empty order
+    if (order_ptr->LeavesQuantity == 0)
+        order_ptr->Tracking = false;
 }
 
-void OrderBook::DeleteTrailingStopOrder(OrderNode* order_ptr)
+template <class TLevels>
+void OrderBookT<TLevels>::DeleteTrailingStopOrder(OrderNode* order_ptr)
 {
+    // Update the stop price of the tracking trailing stop order
+    UpdateTrailingOffsetStopPrice(order_ptr);
+
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
@@ -475,9 +831,42 @@ void OrderBook::DeleteTrailingStopOrder(OrderNode* order_ptr)
         // Clear the price level cache in the given order
         order_ptr->Level = DeleteTrailingStopLevel(order_ptr);
     }
+
+    // Stop tracking the trailing reference price
+    order_ptr->Tracking = false;
 }
 
-uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcept
+template <class TLevels>
+bool OrderBookT<TLevels>::IsTrailingOffsetOrder(const OrderNode* order_ptr) const noexcept
+{
+    // Only trailing stop orders with the absolute trailing distance and without the trailing step could track the trailing reference price
+    if ((order_ptr->TrailingDistance < 0) || (order_ptr->TrailingStep != 0) || !IsRepresentable<PriceValue>((uint64_t)order_ptr->TrailingDistance))
+        return false;
+
+    PriceValue distance = (PriceValue)order_ptr->TrailingDistance;
+
+    if (order_ptr->IsBuy())
+    {
+        // Skip the saturated stop price
+        if ((order_ptr->StopPrice == std::numeric_limits<PriceValue>::max()) || (order_ptr->StopPrice < distance))
+            return false;
+
+        // Check the stop price is the trailing distance from the common trailing reference price
+        return _stops->TrailingBuyOffset.empty() || ((order_ptr->StopPrice - distance) == _stops->TrailingBuyReference);
+    }
+    else
+    {
+        // Skip the saturated stop price
+        if ((order_ptr->StopPrice == 0) || (order_ptr->StopPrice > (std::numeric_limits<PriceValue>::max() - distance)))
+            return false;
+
+        // Check the stop price is the trailing distance from the common trailing reference price
+        return _stops->TrailingSellOffset.empty() || ((order_ptr->StopPrice + distance) == _stops->TrailingSellReference);
+    }
+}
+
+template <class TLevels>
+PriceValue OrderBookT<TLevels>::CalculateTrailingStopPrice(const Order& order) const noexcept
 {
     // Get the current market price
     uint64_t market_price = order.IsBuy() ? GetMarketTrailingStopPriceAsk() : GetMarketTrailingStopPriceBid();
@@ -496,12 +885,12 @@ uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcep
     if (order.IsBuy())
     {
         // Calculate a new stop price
-        uint64_t new_price = (market_price < (std::numeric_limits<uint64_t>::max() - trailing_distance)) ? (market_price + trailing_distance) : std::numeric_limits<uint64_t>::max();
+        uint64_t new_price = (market_price < ((uint64_t)std::numeric_limits<PriceValue>::max() - trailing_distance)) ? (market_price + trailing_distance) : std::numeric_limits<PriceValue>::max();
 
         // If the new price is better and we get through the trailing step
         if (new_price < old_price)
             if ((old_price - new_price) >= (uint64_t)trailing_step)
-                return new_price;
+                return (PriceValue)new_price;
     }
     else
     {
@@ -511,11 +900,16 @@ uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcep
         // If the new price is better and we get through the trailing step
         if (new_price > old_price)
             if ((new_price - old_price) >= (uint64_t)trailing_step)
-                return new_price;
+                return (PriceValue)new_price;
     }
 
-    return old_price;
+    return (PriceValue)old_price;
 }
 
+// Explicit instantiation of the order book for the supported price level containers
+template class OrderBookT<LevelTree>;
+template class OrderBookT<LevelVector>;
+template class OrderBookT<LevelLadder>;
+
 } // namespace Matching
 } // namespace CppTrader
@@ -0,0 +1,148 @@
+/*!
+    \file order_index.cpp
+    \brief Order index implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/order_index.h"
+
+namespace CppTrader {
+namespace Matching {
+
+OrderIndex::OrderIndex(size_t capacity)
+    : _base(0),
+      _size(0),
+      _allocated(0),
+      _sparse(capacity, 0)
+{
+}
+
+std::pair<OrderIndex::iterator, bool> OrderIndex::insert(const value_type& value)
+{
+    // Check for the order with the same Id in the sparse hash map
+    if (!_sparse.empty() && (_sparse.find(value.first) != _sparse.end()))
+        return std::make_pair(find(value.first), false);
+
+    // Get the dense page for the order or insert the order into the sparse hash map
+    Page* page_ptr = CreatePage(value.first);
+    if (page_ptr == nullptr)
+    {
+        bool inserted = _sparse.insert(value).second;
+        return std::make_pair(find(value.first), inserted);
+    }
+
+    // Check for the order with the same Id in the dense page
+    OrderNode*& slot = page_ptr->Orders[GetSlot(value.first)];
+    if (slot != nullptr)
+        return std::make_pair(find(value.first), false);
+
+    // Insert the order into the dense page
+    slot = value.second;
+    ++page_ptr->Count;
+    ++_size;
+
+    return std::make_pair(find(value.first), true);
+}
+
+void OrderIndex::erase(const iterator& it)
+{
+    assert((it != end()) && "Order index iterator must be valid!");
+
+    // Erase the order from the sparse hash map
+    if (it._page >= _pages.size())
+    {
+        _sparse.erase(it._sparse);
+        return;
+    }
+
+    // Erase the order from the dense page
+    Page* page_ptr = _pages[it._page];
+    page_ptr->Orders[it._slot] = nullptr;
+    --page_ptr->Count;
+    --_size;
+
+    // Release the empty page unless it is the last one where new orders are coming
+    if ((page_ptr->Count == 0) && ((it._page + 1) < _pages.size()))
+        ReleasePage(it._page);
+}
+
+size_t OrderIndex::erase(OrderIdValue id)
+{
+    auto it = find(id);
+    if (it == end())
+        return 0;
+
+    erase(it);
+    return 1;
+}
+
+void OrderIndex::clear()
+{
+    for (auto page_ptr : _pages)
+        delete page_ptr;
+    _pages.clear();
+    _sparse.clear();
+    _base = 0;
+    _size = 0;
+    _allocated = 0;
+}
+
+OrderIndex::Page* OrderIndex::CreatePage(OrderIdValue id)
+{
+    uint64_t page = GetPage(id);
+
+    // Start the empty directory from the page of the new order
+    if ((_size == 0) && ((page < _base) || ((page - _base) >= _pages.size())))
+    {
+        for (auto page_ptr : _pages)
+            delete page_ptr;
+        _pages.clear();
+        _allocated = 0;
+        _base = page;
+    }
+
+    // Order Ids behind the directory are kept in the sparse hash map
+    if (page < _base)
+        return nullptr;
+
+    // Grow the directory or keep order Ids far ahead of it in the sparse hash map
+    uint64_t index = page - _base;
+    if (index >= _pages.size())
+    {
+        if (index >= (_pages.size() + PAGE_GAP))
+            return nullptr;
+        _pages.resize((size_t)index + 1, nullptr);
+    }
+
+    // Allocate a new page lazily
+    Page*& page_ptr = _pages[(size_t)index];
+    if (page_ptr == nullptr)
+    {
+        page_ptr = new Page();
+        ++_allocated;
+    }
+
+    return page_ptr;
+}
+
+void OrderIndex::ReleasePage(size_t index)
+{
+    delete _pages[index];
+    _pages[index] = nullptr;
+    --_allocated;
+
+    // Trim released pages at the beginning of the directory
+    if (index == 0)
+    {
+        size_t count = 0;
+        while ((count < _pages.size()) && (_pages[count] == nullptr))
+            ++count;
+        _pages.erase(_pages.begin(), _pages.begin() + count);
+        _base += count;
+    }
+}
+
+} // namespace Matching
+} // namespace CppTrader
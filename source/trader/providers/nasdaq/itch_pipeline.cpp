@@ -0,0 +1,173 @@
+/*!
+    \file itch_pipeline.cpp
+    \brief NASDAQ ITCH pipeline implementation
+    \author Ivan Shynkarenka
+    \date 16.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/providers/nasdaq/itch_pipeline.h"
+
+#include "system/cpu.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+
+namespace CppTrader {
+namespace ITCH {
+
+template <class TLevels>
+ITCHPipelineT<TLevels>::ITCHPipelineT(MarketManager& market, size_t capacity, size_t batch)
+    : _market(market),
+      _ring(capacity),
+      _mask(capacity - 1),
+      _batch(std::max(std::min(batch, capacity / 2), (size_t)1)),
+      _published(0),
+      _applied(0),
+      _decoded(0),
+      _available(capacity),
+      _messages(0),
+      _errors(0),
+      _running(false),
+      _started(false)
+{
+    assert((capacity > 1) && ((capacity & (capacity - 1)) == 0) && "Ring buffer capacity must be a power of two!");
+}
+
+template <class TLevels>
+ITCHPipelineT<TLevels>::~ITCHPipelineT()
+{
+    Stop();
+}
+
+template <class TLevels>
+bool ITCHPipelineT<TLevels>::Start(bool pin)
+{
+    if (IsStarted())
+        return false;
+
+    // Pin the worker thread to the CPU core 1, the caller thread should run the decoder on another core
+    int cores = CppCommon::CPU::LogicalCores();
+    int cpu = (pin && (cores > 1)) ? 1 : -1;
+
+    _running = true;
+    _thread = CppCommon::Thread::Start([this, cpu]() { Run(cpu); });
+
+    _started = true;
+    return true;
+}
+
+template <class TLevels>
+bool ITCHPipelineT<TLevels>::Stop()
+{
+    if (!IsStarted())
+        return false;
+
+    // Apply all decoded commands before stopping
+    Flush();
+
+    _running = false;
+    _thread.join();
+
+    _started = false;
+    return true;
+}
+
+template <class TLevels>
+bool ITCHPipelineT<TLevels>::Process(void* buffer, size_t size)
+{
+    bool result = ITCHHandler::Process(buffer, size);
+
+    // Publish the rest of decoded commands
+    Publish();
+
+    return result;
+}
+
+template <class TLevels>
+void ITCHPipelineT<TLevels>::Flush()
+{
+    if (!IsStarted())
+        return;
+
+    Publish();
+    while (_applied.load(std::memory_order_acquire) < _decoded)
+        CppCommon::Thread::Yield();
+}
+
+template <class TLevels>
+void ITCHPipelineT<TLevels>::Run(int cpu)
+{
+    // Pin the worker thread to the given CPU core
+    if (cpu >= 0)
+    {
+        std::bitset<64> affinity;
+        affinity.set((size_t)cpu);
+        CppCommon::Thread::SetAffinity(affinity);
+    }
+
+    uint64_t applied = _applied.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        uint64_t published = _published.load(std::memory_order_acquire);
+        if (applied == published)
+        {
+            // Stop only when all decoded commands are applied
+            if (!_running.load(std::memory_order_acquire) && (applied == _published.load(std::memory_order_acquire)))
+                break;
+
+            CppCommon::Thread::Yield();
+            continue;
+        }
+
+        // Apply the batch of commands and release their ring buffer slots at once
+        uint64_t last = std::min(published, applied + _batch);
+        for (; applied < last; ++applied)
+            Apply(_ring[applied & _mask]);
+        _applied.store(applied, std::memory_order_release);
+    }
+}
+
+template <class TLevels>
+void ITCHPipelineT<TLevels>::Apply(const Command& command)
+{
+    switch (command.Type)
+    {
+        case CommandType::ADD_SYMBOL:
+        {
+            Matching::Symbol symbol(command.SymbolId, command.Name);
+            _market.AddSymbol(symbol);
+            _market.AddOrderBook(symbol);
+            break;
+        }
+        case CommandType::ADD_ORDER:
+            _market.AddOrder(Matching::Order::Limit(command.Id, command.SymbolId, command.Side, command.Price, command.Quantity));
+            break;
+        case CommandType::REDUCE_ORDER:
+            _market.ReduceOrder(command.Id, command.Quantity);
+            break;
+        case CommandType::DELETE_ORDER:
+            _market.DeleteOrder(command.Id);
+            break;
+        case CommandType::REPLACE_ORDER:
+            _market.ReplaceOrder(command.Id, command.NewId, command.Price, command.Quantity);
+            break;
+        case CommandType::EXECUTE_ORDER:
+            _market.ExecuteOrder(command.Id, command.Quantity);
+            break;
+        case CommandType::EXECUTE_ORDER_PRICE:
+            _market.ExecuteOrder(command.Id, command.Price, command.Quantity);
+            break;
+        default:
+            break;
+    }
+}
+
+// Explicit instantiation of the ITCH pipeline for the supported price level containers
+template class ITCHPipelineT<Matching::LevelTree>;
+template class ITCHPipelineT<Matching::LevelVector>;
+template class ITCHPipelineT<Matching::LevelLadder>;
+
+} // namespace ITCH
+} // namespace CppTrader
@@ -6,6 +6,7 @@
 
 #include "trader/matching/market_manager.h"
 #include "trader/providers/nasdaq/itch_handler.h"
+#include "trader/providers/nasdaq/itch_pipeline.h"
 
 #include "filesystem/file.h"
 
@@ -161,3 +162,50 @@ TEST_CASE("Market manager", "[CppTrader][Matching]")
     REQUIRE(market_handler.delete_orders() == 58915);
     REQUIRE(market_handler.execute_orders() == 2435);
 }
+
+TEST_CASE("Market manager pipeline", "[CppTrader][Matching]")
+{
+    MyMarketHandler market_handler;
+    MarketManager market(market_handler);
+    ITCHPipeline pipeline(market, 1024, 64);
+    REQUIRE(pipeline.Start());
+
+    // Open the input file
+    File input("../../tools/itch/sample.itch");
+    if (!input.IsExists())
+        input = File("../tools/itch/sample.itch");
+    REQUIRE(input.IsExists());
+    input.Open(true, false);
+
+    // Perform input
+    size_t size;
+    uint8_t buffer[8192];
+    while ((size = input.Read(buffer, sizeof(buffer))) > 0)
+    {
+        // Process the buffer
+        pipeline.Process(buffer, size);
+    }
+
+    // Apply all decoded commands
+    pipeline.Flush();
+    REQUIRE(pipeline.applied() == pipeline.decoded());
+    REQUIRE(pipeline.Stop());
+
+    // Check results
+    REQUIRE(pipeline.errors() == 0);
+    REQUIRE(pipeline.messages() == 1563071);
+    REQUIRE(market_handler.updates() == 254853);
+
+    // Check market statistics
+    REQUIRE(market_handler.max_symbols() == 8352);
+    REQUIRE(market_handler.max_order_books() == 8352);
+    REQUIRE(market_handler.max_order_book_levels() == 562);
+    REQUIRE(market_handler.max_order_book_orders() == 517);
+    REQUIRE(market_handler.max_orders() == 56245);
+
+    // Check order statistics
+    REQUIRE(market_handler.add_orders() == 58915);
+    REQUIRE(market_handler.update_orders() == 27);
+    REQUIRE(market_handler.delete_orders() == 58915);
+    REQUIRE(market_handler.execute_orders() == 2435);
+}
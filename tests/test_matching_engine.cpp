@@ -4,14 +4,22 @@
 
 #include "test.h"
 
+#include "trader/matching/market_gateway.h"
+#include "trader/matching/market_handler_async.h"
 #include "trader/matching/market_manager.h"
+#include "trader/matching/market_manager_sharded.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
 
 using namespace CppCommon;
 using namespace CppTrader::Matching;
 
 namespace {
 
-std::pair<int, int> BookOrders(const OrderBook* order_book_ptr)
+template <class TOrderBook>
+std::pair<int, int> BookOrders(const TOrderBook* order_book_ptr)
 {
     if (order_book_ptr == nullptr)
         return std::make_pair(0, 0);
@@ -27,7 +35,8 @@ std::pair<int, int> BookOrders(const OrderBook* order_book_ptr)
     return std::make_pair(bid_orders, ask_orders);
 }
 
-std::pair<int, int> BookVolume(const OrderBook* order_book_ptr)
+template <class TOrderBook>
+std::pair<int, int> BookVolume(const TOrderBook* order_book_ptr)
 {
     if (order_book_ptr == nullptr)
         return std::make_pair(0, 0);
@@ -43,7 +52,8 @@ std::pair<int, int> BookVolume(const OrderBook* order_book_ptr)
     return std::make_pair(bid_volume, ask_volume);
 }
 
-std::pair<int, int> BookVisibleVolume(const OrderBook* order_book_ptr)
+template <class TOrderBook>
+std::pair<int, int> BookVisibleVolume(const TOrderBook* order_book_ptr)
 {
     if (order_book_ptr == nullptr)
         return std::make_pair(0, 0);
@@ -59,7 +69,8 @@ std::pair<int, int> BookVisibleVolume(const OrderBook* order_book_ptr)
     return std::make_pair(bid_volume, ask_volume);
 }
 
-std::pair<int, int> BookStopOrders(const OrderBook* order_book_ptr)
+template <class TOrderBook>
+std::pair<int, int> BookStopOrders(const TOrderBook* order_book_ptr)
 {
     if (order_book_ptr == nullptr)
         return std::make_pair(0, 0);
@@ -79,7 +90,8 @@ std::pair<int, int> BookStopOrders(const OrderBook* order_book_ptr)
     return std::make_pair(buy_orders, sell_orders);
 }
 
-std::pair<int, int> BookStopVolume(const OrderBook* order_book_ptr)
+template <class TOrderBook>
+std::pair<int, int> BookStopVolume(const TOrderBook* order_book_ptr)
 {
     if (order_book_ptr == nullptr)
         return std::make_pair(0, 0);
@@ -99,6 +111,69 @@ std::pair<int, int> BookStopVolume(const OrderBook* order_book_ptr)
     return std::make_pair(buy_volume, sell_volume);
 }
 
+class SweepHandler : public MarketHandler
+{
+public:
+    size_t executions = 0;
+    size_t sweeps = 0;
+    size_t levels = 0;
+    size_t updates = 0;
+    std::vector<Fill> fills;
+    std::string events;
+
+protected:
+    void onUpdateOrderBook(const OrderBook& order_book, bool top, int symbol_id) override { ++updates; events += 'B'; }
+    void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override { ++levels; events += 'L'; }
+    void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override { ++levels; events += 'L'; }
+    void onUpdateOrder(const Order& order) override { events += 'U'; }
+    void onDeleteOrder(const Order& order) override { events += 'D'; }
+    void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { ++executions; events += 'E'; }
+    void onExecuteSweep(const Order& order, const Fill* data, size_t count) override { ++sweeps; fills.assign(data, data + count); events += 'S'; }
+};
+
+class ActivationHandler : public MarketHandler
+{
+public:
+    std::vector<uint64_t> activated;
+
+protected:
+    void onUpdateOrder(const Order& order) override { if (order.IsBuy() && (order.StopPrice == 0)) activated.push_back(order.Id); }
+};
+
+class TrailingHandler : public MarketHandler
+{
+public:
+    std::vector<std::pair<uint64_t, uint64_t>> updates;
+
+protected:
+    void onUpdateOrder(const Order& order) override { if (order.IsTrailingStop() || order.IsTrailingStopLimit()) updates.emplace_back(order.Id, order.StopPrice); }
+};
+
+class EventHandler : public MarketHandler
+{
+public:
+    std::vector<std::pair<char, uint64_t>> events;
+
+protected:
+    void onAddOrder(const Order& order) override { events.emplace_back('A', order.Id); }
+    void onDeleteOrder(const Order& order) override { events.emplace_back('D', order.Id); }
+    void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { events.emplace_back('E', order.Id); }
+};
+
+class AsyncEventHandler : public AsyncMarketHandler
+{
+public:
+    AsyncEventHandler(size_t capacity, AsyncPolicy policy) : AsyncMarketHandler(capacity, policy) {}
+
+    using AsyncMarketHandler::onUpdateLevel;
+
+    std::mutex lock;
+    std::vector<std::pair<uint64_t, MarketEvent>> events;
+
+protected:
+    void onMarketEvent(uint64_t sequence, const MarketEvent& event) override { std::lock_guard<std::mutex> locker(lock); events.emplace_back(sequence, event); }
+};
+
 }
 
 TEST_CASE("Automatic matching - market order", "[CppTrader][Matching]")
@@ -713,3 +788,1375 @@ TEST_CASE("Manual matching", "[CppTrader][Matching]")
     REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 4));
     REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(60, 65));
 }
+
+TEST_CASE("Automatic matching - price level ladder", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book with 8 ticks ladder and price tick 10
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol, 8, 10);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Add buy limit orders
+    market.AddOrder(Order::BuyLimit(1, 0, 10, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 20, 20));
+    market.AddOrder(Order::BuyLimit(3, 0, 30, 30));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 0));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(60, 0));
+    REQUIRE(market.GetOrderBook(0)->best_bid()->Price == 30);
+
+    // Add sell limit orders inside the ladder, off the price tick and far away from the ladder
+    market.AddOrder(Order::SellLimit(4, 0, 40, 10));
+    market.AddOrder(Order::SellLimit(5, 0, 45, 20));
+    market.AddOrder(Order::SellLimit(6, 0, 60, 30));
+    market.AddOrder(Order::SellLimit(7, 0, 500, 40));
+    market.AddOrder(Order::SellLimit(8, 0, 1000, 50));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 5));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(60, 150));
+    REQUIRE(market.GetOrderBook(0)->best_ask()->Price == 40);
+    REQUIRE(market.GetOrderBook(0)->GetAsk(45) != nullptr);
+    REQUIRE(market.GetOrderBook(0)->GetAsk(500) != nullptr);
+    REQUIRE(market.GetOrderBook(0)->GetAsk(50) == nullptr);
+
+    // Price levels must be iterated in the ascending price order
+    std::vector<uint64_t> prices;
+    for (const auto& ask : market.GetOrderBook(0)->asks())
+        prices.push_back(ask.Price);
+    REQUIRE(prices == std::vector<uint64_t>({ 40, 45, 60, 500, 1000 }));
+
+    // Automatic matching on several levels including the off tick one
+    market.AddOrder(Order::BuyLimit(9, 0, 60, 40));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 3));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(60, 110));
+    REQUIRE(market.GetOrderBook(0)->best_ask()->Price == 60);
+
+    // Automatic matching recentres the ladder on the far away price levels
+    market.AddOrder(Order::BuyLimit(10, 0, 500, 60));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(60, 50));
+    REQUIRE(market.GetOrderBook(0)->best_ask()->Price == 1000);
+
+    // Add buy limit order near the new ask price and delete the old best bid
+    market.AddOrder(Order::BuyLimit(11, 0, 990, 10));
+    market.DeleteOrder(3);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(40, 50));
+    REQUIRE(market.GetOrderBook(0)->best_bid()->Price == 990);
+    market.DeleteOrder(11);
+    REQUIRE(market.GetOrderBook(0)->best_bid()->Price == 20);
+    market.DeleteOrder(2);
+    REQUIRE(market.GetOrderBook(0)->best_bid()->Price == 10);
+}
+
+TEMPLATE_TEST_CASE("Automatic matching - price level containers", "[CppTrader][Matching]", LevelTree, LevelVector, LevelLadder)
+{
+    MarketManagerT<TestType> market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol, 16, 10);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Add limit orders
+    market.AddOrder(Order::BuyLimit(1, 0, 20, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 10, 20));
+    market.AddOrder(Order::BuyLimit(3, 0, 30, 30));
+    market.AddOrder(Order::SellLimit(4, 0, 60, 30));
+    market.AddOrder(Order::SellLimit(5, 0, 40, 10));
+    market.AddOrder(Order::SellLimit(6, 0, 50, 20));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 3));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(60, 60));
+    REQUIRE(market.GetOrderBook(0)->best_bid()->Price == 30);
+    REQUIRE(market.GetOrderBook(0)->best_ask()->Price == 40);
+
+    // Price levels must be iterated in the ascending price order
+    std::vector<uint64_t> prices;
+    for (const auto& bid : market.GetOrderBook(0)->bids())
+        prices.push_back(bid.Price);
+    for (const auto& ask : market.GetOrderBook(0)->asks())
+        prices.push_back(ask.Price);
+    REQUIRE(prices == std::vector<uint64_t>({ 10, 20, 30, 40, 50, 60 }));
+
+    // Add stop orders
+    market.AddOrder(Order::BuyStop(7, 0, 50, 20));
+    market.AddOrder(Order::SellStop(8, 0, 20, 20));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+    REQUIRE(BookStopVolume(market.GetOrderBook(0)) == std::make_pair(20, 20));
+
+    // Automatic matching on several levels activates the buy stop order
+    market.AddOrder(Order::BuyLimit(9, 0, 50, 20));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(60, 20));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 1));
+    REQUIRE(market.GetOrderBook(0)->best_ask()->Price == 60);
+
+    // Automatic matching on several levels activates the sell stop order
+    market.AddOrder(Order::SellLimit(10, 0, 20, 40));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 20));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+    REQUIRE(market.GetOrderBook(0)->best_bid() == nullptr);
+}
+
+TEST_CASE("Price level bitmap", "[CppTrader][Matching]")
+{
+    LevelBitmap bitmap(5000);
+    REQUIRE(bitmap.FindNext(0) == LevelBitmap::npos);
+    REQUIRE(bitmap.FindPrev(4999) == LevelBitmap::npos);
+
+    // Set bits in different words and bitmap levels
+    bitmap.set(3);
+    bitmap.set(64);
+    bitmap.set(4100);
+    REQUIRE(bitmap.test(64));
+    REQUIRE(!bitmap.test(65));
+    REQUIRE(bitmap.FindNext(0) == 3);
+    REQUIRE(bitmap.FindNext(4) == 64);
+    REQUIRE(bitmap.FindNext(65) == 4100);
+    REQUIRE(bitmap.FindNext(4101) == LevelBitmap::npos);
+    REQUIRE(bitmap.FindPrev(4999) == 4100);
+    REQUIRE(bitmap.FindPrev(4099) == 64);
+    REQUIRE(bitmap.FindPrev(63) == 3);
+    REQUIRE(bitmap.FindPrev(2) == LevelBitmap::npos);
+
+    // Reset bits
+    bitmap.reset(64);
+    REQUIRE(bitmap.FindNext(4) == 4100);
+    REQUIRE(bitmap.FindPrev(4099) == 3);
+    bitmap.clear();
+    REQUIRE(bitmap.FindNext(0) == LevelBitmap::npos);
+}
+
+TEST_CASE("Numeric types range", "[CppTrader][Matching]")
+{
+    REQUIRE(IsRepresentable<uint32_t>(std::numeric_limits<uint32_t>::max()));
+    REQUIRE(!IsRepresentable<uint32_t>((uint64_t)std::numeric_limits<uint32_t>::max() + 1));
+    REQUIRE(IsRepresentable<uint64_t>(std::numeric_limits<uint64_t>::max()));
+
+    MarketManager market;
+    market.EnableMatching();
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.AddOrder(Order::BuyLimit(1, 0, 10, 10));
+
+    // Values which do not fit into the configured numeric types are rejected
+    uint64_t max = std::numeric_limits<uint64_t>::max();
+    if (!IsRepresentable<OrderIdValue>(max))
+    {
+        REQUIRE(market.GetOrder(max) == nullptr);
+        REQUIRE(market.DeleteOrder(max) == ErrorCode::ORDER_ID_INVALID);
+    }
+    if (!IsRepresentable<PriceValue>(max))
+        REQUIRE(market.ModifyOrder(1, max, 10) == ErrorCode::ORDER_PARAMETER_INVALID);
+    if (!IsRepresentable<QuantityValue>(max))
+        REQUIRE(market.ReduceOrder(1, max) == ErrorCode::ORDER_QUANTITY_INVALID);
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 10);
+}
+
+TEST_CASE("Order index", "[CppTrader][Matching]")
+{
+    std::vector<OrderNode> nodes;
+    for (uint64_t i = 0; i < 10; ++i)
+        nodes.emplace_back(Order::BuyLimit(i + 1, 0, 10, 10));
+
+    OrderIndex index;
+    REQUIRE(index.empty());
+    REQUIRE(index.find(1) == index.end());
+
+    // Near-monotonic order Ids are kept in dense pages
+    REQUIRE(index.insert(std::make_pair(1, &nodes[0])).second);
+    REQUIRE(index.insert(std::make_pair(2, &nodes[1])).second);
+    REQUIRE(index.insert(std::make_pair(OrderIndex::PAGE_SIZE + 1, &nodes[2])).second);
+    REQUIRE(!index.insert(std::make_pair(2, &nodes[3])).second);
+    REQUIRE(index.size() == 3);
+    REQUIRE(index.sparse() == 0);
+    REQUIRE(index.pages() == 2);
+    REQUIRE(index.find(2)->second == &nodes[1]);
+    REQUIRE(index.find(OrderIndex::PAGE_SIZE + 1)->second == &nodes[2]);
+    REQUIRE(index.find(3) == index.end());
+
+    // Order Ids far ahead of the directory are kept in the sparse hash map
+    uint64_t far = OrderIndex::PAGE_SIZE * (OrderIndex::PAGE_GAP + 2);
+    REQUIRE(index.insert(std::make_pair(far, &nodes[4])).second);
+    REQUIRE(!index.insert(std::make_pair(far, &nodes[5])).second);
+    REQUIRE(index.size() == 4);
+    REQUIRE(index.sparse() == 1);
+    REQUIRE(index.find(far)->second == &nodes[4]);
+
+    // Iterate all orders
+    size_t count = 0;
+    for (const auto& order : index)
+    {
+        REQUIRE(index.find(order.first)->second == order.second);
+        ++count;
+    }
+    REQUIRE(count == 4);
+
+    // Fully erased pages are released
+    index.erase(index.find(1));
+    index.erase(index.find(2));
+    REQUIRE(index.pages() == 1);
+    REQUIRE(index.find(OrderIndex::PAGE_SIZE + 1)->second == &nodes[2]);
+
+    // Order Ids behind the directory are kept in the sparse hash map
+    REQUIRE(index.insert(std::make_pair(1, &nodes[0])).second);
+    REQUIRE(index.sparse() == 2);
+    REQUIRE(index.find(1)->second == &nodes[0]);
+
+    index.erase(index.find(far));
+    index.erase(index.find(1));
+    index.erase(index.find(OrderIndex::PAGE_SIZE + 1));
+    REQUIRE(index.empty());
+    REQUIRE(index.begin() == index.end());
+
+    // Empty directory restarts from the page of the next order
+    uint64_t next = far * 2;
+    REQUIRE(index.insert(std::make_pair(next, &nodes[6])).second);
+    REQUIRE(index.insert(std::make_pair(next + OrderIndex::PAGE_SIZE, &nodes[7])).second);
+    REQUIRE(index.sparse() == 0);
+    REQUIRE(index.pages() == 2);
+    REQUIRE(index.find(next)->second == &nodes[6]);
+    REQUIRE(index.find(next + OrderIndex::PAGE_SIZE)->second == &nodes[7]);
+}
+
+TEST_CASE("Queue position", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Queue orders at the same price level
+    market.AddOrder(Order::BuyLimit(1, 0, 10, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 10, 20, OrderTimeInForce::GTC, 5));
+    market.AddOrder(Order::BuyLimit(3, 0, 10, 30));
+    market.AddOrder(Order::BuyStop(4, 0, 20, 10));
+
+    QueuePosition position;
+    REQUIRE(market.GetQueuePosition(3, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 2);
+    REQUIRE(position.VisibleVolume == 15);
+    REQUIRE(position.HiddenVolume == 15);
+    REQUIRE(market.GetQueuePosition(1, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 0);
+    REQUIRE(position.VisibleVolume == 0);
+    REQUIRE(market.GetQueuePosition(4, position) == ErrorCode::ORDER_TYPE_INVALID);
+    REQUIRE(market.GetQueuePosition(5, position) == ErrorCode::ORDER_NOT_FOUND);
+
+    // Reduce and delete orders ahead
+    market.ReduceOrder(2, 10);
+    REQUIRE(market.GetQueuePosition(3, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 2);
+    REQUIRE(position.VisibleVolume == 15);
+    REQUIRE(position.HiddenVolume == 5);
+    market.DeleteOrder(1);
+    REQUIRE(market.GetQueuePosition(3, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 1);
+    REQUIRE(position.VisibleVolume == 5);
+    REQUIRE(position.HiddenVolume == 5);
+
+    // Heavy churn behind the order rebuilds the price level queue
+    for (uint64_t id = 10; id < 1000; ++id)
+    {
+        market.AddOrder(Order::BuyLimit(id, 0, 10, 1));
+        if ((id % 3) != 0)
+            market.DeleteOrder(id);
+    }
+    REQUIRE(market.GetQueuePosition(999, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 2 + 329);
+    REQUIRE(position.VisibleVolume == 5 + 30 + 329);
+    REQUIRE(position.HiddenVolume == 5);
+}
+
+TEMPLATE_TEST_CASE("Order book depth cache", "[CppTrader][Matching]", LevelTree, LevelVector, LevelLadder)
+{
+    MarketManagerT<TestType> market;
+    market.EnableMatching();
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable the depth cache on the non empty order book
+    market.AddOrder(Order::BuyLimit(1, 0, 10, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 20, 10));
+    REQUIRE(market.SetOrderBookDepth(0, 2) == ErrorCode::OK);
+    const auto& bids = market.GetOrderBook(0)->bid_depth();
+    const auto& asks = market.GetOrderBook(0)->ask_depth();
+    REQUIRE(bids.size() == 2);
+    REQUIRE(bids[0].Price == 20);
+    REQUIRE(bids[1].Price == 10);
+    REQUIRE(asks.empty());
+
+    // Worse price level does not fit into the full depth cache
+    uint64_t version = bids.version();
+    market.AddOrder(Order::BuyLimit(3, 0, 5, 10));
+    REQUIRE(bids.version() == version);
+    REQUIRE(bids.size() == 2);
+
+    // Better price level drops the worst cached one
+    market.AddOrder(Order::BuyLimit(4, 0, 30, 10));
+    REQUIRE(bids.version() != version);
+    REQUIRE(bids[0].Price == 30);
+    REQUIRE(bids[1].Price == 20);
+
+    // Price level volume is updated in place
+    market.AddOrder(Order::BuyLimit(5, 0, 20, 15));
+    REQUIRE(bids[1].TotalVolume == 25);
+    REQUIRE(bids[1].Orders == 2);
+
+    // Deleted price level is refilled from the order book
+    market.DeleteOrder(4);
+    REQUIRE(bids[0].Price == 20);
+    REQUIRE(bids[1].Price == 10);
+
+    // Matching updates the depth cache of both sides
+    market.AddOrder(Order::SellLimit(6, 0, 40, 10));
+    market.AddOrder(Order::SellLimit(7, 0, 20, 30));
+    REQUIRE(bids.size() == 2);
+    REQUIRE(bids[0].Price == 10);
+    REQUIRE(bids[1].Price == 5);
+    REQUIRE(asks.size() == 2);
+    REQUIRE(asks[0].Price == 20);
+    REQUIRE(asks[0].TotalVolume == 5);
+    REQUIRE(asks[1].Price == 40);
+
+    // Disable the depth cache
+    REQUIRE(market.SetOrderBookDepth(0, 0) == ErrorCode::OK);
+    REQUIRE(bids.empty());
+    market.AddOrder(Order::BuyLimit(8, 0, 15, 10));
+    REQUIRE(bids.empty());
+}
+
+TEMPLATE_TEST_CASE("Lazy stop book", "[CppTrader][Matching]", LevelTree, LevelVector, LevelLadder)
+{
+    MarketManagerT<TestType> market;
+    market.EnableMatching();
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    const auto* order_book_ptr = market.GetOrderBook(0);
+
+    // Matching limit orders does not allocate the stop book
+    market.AddOrder(Order::BuyLimit(1, 0, 10, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 10, 5));
+    REQUIRE(!order_book_ptr->has_stops());
+    REQUIRE(order_book_ptr->best_buy_stop() == nullptr);
+    REQUIRE(order_book_ptr->buy_stop().empty());
+    REQUIRE(order_book_ptr->trailing_sell_stop().empty());
+    REQUIRE(order_book_ptr->GetSellStopLevel(10) == nullptr);
+    REQUIRE(order_book_ptr->size() == 1);
+
+    // The first stop order allocates the stop book
+    market.AddOrder(Order::SellStop(3, 0, 5, 5));
+    REQUIRE(order_book_ptr->has_stops());
+    REQUIRE(order_book_ptr->best_sell_stop() != nullptr);
+    REQUIRE(order_book_ptr->size() == 2);
+
+    // Stop orders are activated by matching
+    market.AddOrder(Order::SellLimit(4, 0, 5, 10));
+    REQUIRE(BookStopOrders(order_book_ptr) == std::make_pair(0, 0));
+    REQUIRE(order_book_ptr->size() == 1);
+    REQUIRE(order_book_ptr->best_ask()->TotalVolume == 5);
+}
+
+TEST_CASE("Order book memory arenas", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableMatching();
+    const char name[8] = "test";
+    Symbol hot = { 0, name };
+    Symbol cold = { 1, name };
+    Symbol shared = { 2, name };
+    market.AddSymbol(hot);
+    market.AddSymbol(cold);
+    market.AddSymbol(shared);
+
+    // Only order books added with enabled arenas own them
+    market.EnableOrderBookArenas(1024);
+    REQUIRE(market.IsOrderBookArenasEnabled());
+    market.AddOrderBook(hot);
+    market.AddOrderBook(cold);
+    market.DisableOrderBookArenas();
+    market.AddOrderBook(shared);
+    REQUIRE(market.GetOrderBook(0)->has_arena());
+    REQUIRE(market.GetOrderBook(1)->has_arena());
+    REQUIRE(!market.GetOrderBook(2)->has_arena());
+
+    // Nodes are recycled within the order book arena
+    for (uint64_t i = 1; i <= 100; ++i)
+        market.AddOrder(Order::BuyLimit(i, 0, i, 10));
+    market.AddOrder(Order::SellLimit(101, 0, 51, 500));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(50, 0));
+    market.AddOrder(Order::BuyLimit(102, 1, 10, 10));
+    market.AddOrder(Order::SellStop(103, 1, 5, 10));
+    market.AddOrder(Order::BuyLimit(104, 2, 10, 10));
+
+    // Deleting the order book erases its orders
+    REQUIRE(market.DeleteOrderBook(0) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(50) == nullptr);
+    REQUIRE(market.GetOrder(102) != nullptr);
+    REQUIRE(market.GetOrder(103) != nullptr);
+    REQUIRE(market.GetOrder(104) != nullptr);
+
+    // Other order books keep working
+    market.AddOrder(Order::SellLimit(105, 1, 10, 10));
+    REQUIRE(market.GetOrder(102) == nullptr);
+    REQUIRE(market.DeleteOrder(104) == ErrorCode::OK);
+}
+
+TEST_CASE("Call auction uncrossing", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Collect crossed orders without matching
+    market.AddOrder(Order::BuyLimit(1, 0, 12, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 11, 20));
+    market.AddOrder(Order::BuyLimit(3, 0, 10, 30));
+    market.AddOrder(Order::BuyLimit(4, 0, 12, 100, OrderTimeInForce::AON));
+    market.AddOrder(Order::SellLimit(5, 0, 9, 15));
+    market.AddOrder(Order::SellLimit(6, 0, 10, 15));
+    market.AddOrder(Order::SellLimit(7, 0, 11, 25));
+    market.AddOrder(Order::BuyStop(8, 0, 11, 10));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(4, 3));
+
+    // Equilibrium price maximizes the executable volume with the minimal imbalance
+    uint64_t price = 0;
+    uint64_t volume = 0;
+    REQUIRE(market.GetAuctionPrice(0, price, volume) == ErrorCode::OK);
+    REQUIRE(price == 11);
+    REQUIRE(volume == 30);
+
+    // Uncross the order book at the equilibrium price
+    REQUIRE(market.UncrossOrderBook(0) == ErrorCode::OK);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(2, 1));
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(2) == nullptr);
+    REQUIRE(market.GetOrder(5) == nullptr);
+    REQUIRE(market.GetOrder(6) == nullptr);
+    REQUIRE(market.GetOrder(4)->ExecutedQuantity == 0);
+
+    // Buy stop order is activated by the new best ask price after the uncross
+    REQUIRE(market.GetOrder(8) == nullptr);
+    REQUIRE(market.GetOrder(7)->ExecutedQuantity == 10);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(130, 15));
+
+    // Nothing is left to uncross except 'All-Or-None' orders
+    REQUIRE(market.GetAuctionPrice(0, price, volume) == ErrorCode::OK);
+    REQUIRE(volume == 0);
+}
+
+TEST_CASE("Price level 'All-Or-None' volume", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Price levels track 'All-Or-None' orders volume
+    market.AddOrder(Order::SellLimit(1, 0, 10, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 10, 20, OrderTimeInForce::AON));
+    market.AddOrder(Order::SellLimit(3, 0, 20, 30));
+    market.AddOrder(Order::SellLimit(4, 0, 30, 15, OrderTimeInForce::AON));
+    const LevelNode* best_ask = market.GetOrderBook(0)->best_ask();
+    REQUIRE(best_ask->AONVolume == 20);
+    REQUIRE(best_ask->AONOrders == 1);
+
+    // Rejected 'Fill-Or-Kill' order does not change the order book
+    market.AddOrder(Order::BuyLimit(5, 0, 30, 80, OrderTimeInForce::FOK));
+    market.AddOrder(Order::BuyLimit(6, 0, 20, 25, OrderTimeInForce::FOK));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 75));
+
+    // Accepted 'Fill-Or-Kill' order takes the chain through the price level without 'All-Or-None' orders
+    market.AddOrder(Order::BuyLimit(7, 0, 20, 40, OrderTimeInForce::FOK));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 35));
+    REQUIRE(market.GetOrderBook(0)->best_ask()->AONVolume == 0);
+    REQUIRE(market.GetOrderBook(0)->best_ask()->AONOrders == 0);
+
+    // Deleted 'All-Or-None' order is removed from the price level volume
+    REQUIRE(market.DeleteOrder(4) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->best_ask()->AONVolume == 0);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 20));
+}
+
+TEST_CASE("Order handle", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Resting order gets the valid handle
+    OrderHandle handle;
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 0, 10, 100), handle) == ErrorCode::OK);
+    REQUIRE(handle);
+    REQUIRE(handle->Id == 1);
+    REQUIRE((*handle).LeavesQuantity == 100);
+
+    // Manage the order using its handle
+    REQUIRE(market.ReduceOrder(handle, 10) == ErrorCode::OK);
+    REQUIRE(handle->LeavesQuantity == 90);
+    REQUIRE(market.ModifyOrder(handle, 20, 50) == ErrorCode::OK);
+    REQUIRE(handle->Price == 20);
+    REQUIRE(market.GetOrderBook(0)->best_bid()->Price == 20);
+    REQUIRE(market.ExecuteOrder(handle, 20) == ErrorCode::OK);
+    REQUIRE(handle->LeavesQuantity == 30);
+    REQUIRE(market.ReplaceOrder(handle, 2, 30, 40) == ErrorCode::OK);
+    REQUIRE(handle->Id == 2);
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(2) == &*handle);
+
+    // Replace the order with a new one and update the handle
+    REQUIRE(market.ReplaceOrder(handle, Order::SellLimit(3, 0, 40, 10)) == ErrorCode::OK);
+    REQUIRE(handle);
+    REQUIRE(handle->Id == 3);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 10));
+
+    // Delete the order using its handle
+    REQUIRE(market.DeleteOrder(handle) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(3) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+
+    // Order filled completely on arrival gets the empty handle
+    OrderHandle filled;
+    REQUIRE(market.AddOrder(Order::SellLimit(4, 0, 10, 10), handle) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::BuyLimit(5, 0, 10, 10), filled) == ErrorCode::OK);
+    REQUIRE(!filled);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+
+    // Order replaced and filled completely on arrival clears the handle
+    REQUIRE(market.AddOrder(Order::SellLimit(6, 0, 50, 10)) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::BuyLimit(7, 0, 40, 10), handle) == ErrorCode::OK);
+    REQUIRE(handle);
+    REQUIRE(market.ReplaceOrder(handle, 8, 50, 10) == ErrorCode::OK);
+    REQUIRE(!handle);
+    REQUIRE(market.GetOrder(8) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+}
+
+TEST_CASE("Batched sweep executions", "[CppTrader][Matching]")
+{
+    SweepHandler handler;
+    MarketManager market(handler);
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching and batched sweep executions
+    market.EnableMatching();
+    market.EnableSweepExecutions();
+
+    market.AddOrder(Order::SellLimit(1, 0, 10, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 10, 20));
+    market.AddOrder(Order::SellLimit(3, 0, 20, 30));
+    market.AddOrder(Order::SellLimit(4, 0, 30, 40));
+    handler.levels = 0;
+    handler.updates = 0;
+    handler.events.clear();
+
+    // Aggressive order sweeps three price levels with a single notification
+    market.AddOrder(Order::BuyLimit(5, 0, 30, 70));
+    REQUIRE(handler.executions == 0);
+    REQUIRE(handler.sweeps == 1);
+    REQUIRE(handler.fills.size() == 4);
+    REQUIRE(handler.fills[0].Id == 1);
+    REQUIRE(handler.fills[1].Id == 2);
+    REQUIRE(handler.fills[2].Price == 20);
+    REQUIRE(handler.fills[2].Quantity == 30);
+    REQUIRE(handler.fills[3].Id == 4);
+    REQUIRE(handler.fills[3].Quantity == 10);
+    REQUIRE(handler.levels == 3);
+    REQUIRE(handler.updates == 1);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 30));
+
+    // Resting order notifications follow the sweep notification
+    REQUIRE(handler.events == "SDDDULLLBD");
+
+    // Disabled batched sweep executions notify about every execution
+    market.DisableSweepExecutions();
+    market.AddOrder(Order::BuyLimit(6, 0, 30, 10));
+    REQUIRE(handler.executions == 2);
+    REQUIRE(handler.sweeps == 1);
+}
+
+TEST_CASE("Stop orders cascade", "[CppTrader][Matching]")
+{
+    ActivationHandler handler;
+    MarketManager market(handler);
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    market.AddOrder(Order::SellLimit(1, 0, 10, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 20, 10));
+    market.AddOrder(Order::SellLimit(3, 0, 30, 10));
+    market.AddOrder(Order::SellLimit(4, 0, 40, 10));
+    market.AddOrder(Order::SellLimit(5, 0, 50, 10));
+
+    // Buy stop orders at several price levels
+    market.AddOrder(Order::BuyStop(10, 0, 30, 10));
+    market.AddOrder(Order::BuyStopLimit(11, 0, 20, 40, 10));
+    market.AddOrder(Order::BuyStop(12, 0, 20, 10));
+    market.AddOrder(Order::BuyStop(13, 0, 50, 10));
+    REQUIRE(handler.activated.empty());
+
+    // Stop orders crossed by the market price are activated from the best price level in the queue order
+    market.AddOrder(Order::BuyLimit(20, 0, 20, 10));
+    REQUIRE(handler.activated == std::vector<uint64_t>({ 11, 12, 10, 13 }));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+    REQUIRE(BookStopVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+}
+
+TEST_CASE("Tracking trailing stop orders", "[CppTrader][Matching]")
+{
+    TrailingHandler handler;
+    MarketManager market(handler);
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Create the market with last prices
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 20));
+    market.AddOrder(Order::SellLimit(2, 0, 200, 20));
+    market.AddOrder(Order::SellMarket(3, 0, 10));
+    market.AddOrder(Order::BuyMarket(4, 0, 10));
+    const auto* order_book_ptr = market.GetOrderBook(0);
+
+    // Trailing stop orders without the trailing step track the common trailing reference price
+    market.AddOrder(Order::TrailingBuyStop(5, 0, 1000, 10, 10));
+    market.AddOrder(Order::TrailingBuyStop(6, 0, 1000, 10, 20));
+    market.AddOrder(Order::TrailingBuyStop(7, 0, 1000, 10, 10, 5));
+    REQUIRE(market.GetOrder(5)->StopPrice == 210);
+    REQUIRE(market.GetOrder(6)->StopPrice == 220);
+    REQUIRE(order_book_ptr->trailing_buy_reference() == 200);
+    REQUIRE(order_book_ptr->trailing_buy_offset().size() == 2);
+    REQUIRE(order_book_ptr->trailing_buy_stop().size() == 1);
+    REQUIRE(BookStopOrders(order_book_ptr) == std::make_pair(1, 0));
+
+    // Market move updates the trailing reference price and tracking orders in their price levels
+    market.ModifyOrder(2, 180, 20);
+    handler.updates.clear();
+    market.AddOrder(Order::BuyMarket(8, 0, 10));
+    REQUIRE(order_book_ptr->trailing_buy_reference() == 180);
+    REQUIRE(order_book_ptr->trailing_buy_offset().size() == 2);
+    REQUIRE(market.GetOrder(5)->StopPrice == 190);
+    REQUIRE(market.GetOrder(6)->StopPrice == 200);
+    REQUIRE(market.GetOrder(7)->StopPrice == 190);
+
+    // Market handler is notified about each updated trailing stop order
+    std::vector<std::pair<uint64_t, uint64_t>> updates = { { 5, 190 }, { 6, 200 }, { 7, 190 } };
+    REQUIRE(handler.updates == updates);
+
+    // Tracking trailing stop orders are activated by the stop price
+    market.AddOrder(Order::SellLimit(9, 0, 195, 30));
+    market.AddOrder(Order::BuyMarket(10, 0, 10));
+    REQUIRE(market.GetOrder(5) == nullptr);
+    REQUIRE(market.GetOrder(6) != nullptr);
+    REQUIRE(market.GetOrder(7) == nullptr);
+    REQUIRE(order_book_ptr->trailing_buy_offset().size() == 1);
+    REQUIRE(BookVolume(order_book_ptr) == std::make_pair(10, 10));
+
+    // Deleted tracking trailing stop order leaves its price level
+    REQUIRE(market.DeleteOrder(6) == ErrorCode::OK);
+    REQUIRE(order_book_ptr->trailing_buy_offset().empty());
+
+    // Prepare another symbol & order book for tracking trailing sell stop orders
+    const char name2[8] = "test2";
+    Symbol symbol2 = { 1, name2 };
+    market.AddSymbol(symbol2);
+    market.AddOrderBook(symbol2);
+
+    // Create the market with last prices
+    market.AddOrder(Order::BuyLimit(11, 1, 100, 20));
+    market.AddOrder(Order::SellLimit(12, 1, 200, 20));
+    market.AddOrder(Order::SellMarket(13, 1, 10));
+    market.AddOrder(Order::BuyMarket(14, 1, 10));
+    order_book_ptr = market.GetOrderBook(1);
+
+    // Tracking trailing sell stop orders with different trailing distances
+    market.AddOrder(Order::TrailingSellStop(15, 1, 0, 10, 20));
+    market.AddOrder(Order::TrailingSellStop(16, 1, 0, 10, 10));
+    REQUIRE(market.GetOrder(15)->StopPrice == 80);
+    REQUIRE(market.GetOrder(16)->StopPrice == 90);
+    REQUIRE(order_book_ptr->trailing_sell_reference() == 100);
+    REQUIRE(order_book_ptr->trailing_sell_offset().size() == 2);
+    REQUIRE(order_book_ptr->trailing_sell_offset().best()->Price == 10);
+
+    // Only the nearest tracking trailing sell stop order is activated
+    market.AddOrder(Order::BuyLimit(17, 1, 85, 30));
+    market.DeleteOrder(11);
+    REQUIRE(market.GetOrder(15) != nullptr);
+    REQUIRE(market.GetOrder(16) == nullptr);
+    REQUIRE(market.GetOrder(17)->LeavesQuantity == 20);
+    REQUIRE(order_book_ptr->trailing_sell_offset().size() == 1);
+    REQUIRE(order_book_ptr->trailing_sell_offset().best()->Price == 20);
+}
+
+TEST_CASE("Pro-rata allocation", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Order book is created with the FIFO allocation policy
+    REQUIRE(market.GetOrderBook(0)->allocation() == AllocationType::FIFO);
+    REQUIRE(market.SetOrderBookAllocation(0, AllocationType::PRO_RATA) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->allocation() == AllocationType::PRO_RATA);
+
+    // Allocate the execution proportionally to the resting orders leaves quantity
+    market.AddOrder(Order::SellLimit(1, 0, 10, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 10, 30));
+    market.AddOrder(Order::SellLimit(3, 0, 10, 60));
+    market.AddOrder(Order::BuyLimit(4, 0, 10, 50));
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 5);
+    REQUIRE(market.GetOrder(2)->LeavesQuantity == 15);
+    REQUIRE(market.GetOrder(3)->LeavesQuantity == 30);
+    REQUIRE(market.GetOrder(4) == nullptr);
+
+    // Allocate the rounding remainder in the time priority
+    market.AddOrder(Order::BuyLimit(5, 0, 10, 7));
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 4);
+    REQUIRE(market.GetOrder(2)->LeavesQuantity == 13);
+    REQUIRE(market.GetOrder(3)->LeavesQuantity == 26);
+
+    // Price level taken entirely is executed in the price-time priority
+    market.AddOrder(Order::BuyLimit(6, 0, 10, 50));
+    REQUIRE(market.GetOrder(6)->LeavesQuantity == 7);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(7, 0));
+    market.DeleteOrder(6);
+
+    // Allocate the execution to the top order first
+    REQUIRE(market.SetOrderBookAllocation(0, AllocationType::TOP_ORDER_PRO_RATA) == ErrorCode::OK);
+    market.AddOrder(Order::BuyLimit(7, 0, 100, 20));
+    market.AddOrder(Order::BuyLimit(8, 0, 100, 20));
+    market.AddOrder(Order::BuyLimit(9, 0, 100, 60));
+    REQUIRE(market.GetOrderBook(0)->best_bid()->TopOrder == market.GetOrder(7));
+    market.AddOrder(Order::SellLimit(10, 0, 100, 40));
+    REQUIRE(market.GetOrder(7) == nullptr);
+    REQUIRE(market.GetOrder(8)->LeavesQuantity == 15);
+    REQUIRE(market.GetOrder(9)->LeavesQuantity == 45);
+    REQUIRE(market.GetOrderBook(0)->best_bid()->TopOrder == nullptr);
+
+    auto OwnedOrder = [](Order order, uint64_t owner, OrderSelfTradePrevention stp = OrderSelfTradePrevention::NONE)
+    {
+        order.OwnerId = owner;
+        order.SelfTradePrevention = stp;
+        return order;
+    };
+
+    // Allocate the execution among resting orders of other owners
+    REQUIRE(market.SetOrderBookAllocation(0, AllocationType::PRO_RATA) == ErrorCode::OK);
+    market.AddOrder(OwnedOrder(Order::SellLimit(11, 0, 200, 20), 7));
+    market.AddOrder(OwnedOrder(Order::SellLimit(12, 0, 200, 20), 8));
+    market.AddOrder(OwnedOrder(Order::SellLimit(13, 0, 200, 60), 9));
+    market.AddOrder(OwnedOrder(Order::BuyLimit(14, 0, 200, 40), 7, OrderSelfTradePrevention::CANCEL_RESTING));
+    REQUIRE(market.GetOrder(11)->LeavesQuantity == 20);
+    REQUIRE(market.GetOrder(12)->LeavesQuantity == 10);
+    REQUIRE(market.GetOrder(13)->LeavesQuantity == 30);
+    REQUIRE(market.GetOrder(14) == nullptr);
+
+    // Rebuild the stale price level owners filter after the owner left the price level
+    market.DeleteOrder(11);
+    REQUIRE(market.GetOrderBook(0)->best_ask()->OwnerMaskStale);
+    market.AddOrder(OwnedOrder(Order::BuyLimit(15, 0, 200, 10), 7, OrderSelfTradePrevention::CANCEL_AGGRESSOR));
+    REQUIRE(!market.GetOrderBook(0)->best_ask()->OwnerMaskStale);
+    REQUIRE((market.GetOrderBook(0)->best_ask()->OwnerMask & OwnedOrder(Order::BuyLimit(15, 0, 200, 10), 7).OwnerMask()) == 0);
+    REQUIRE(market.GetOrder(12)->LeavesQuantity == 7);
+    REQUIRE(market.GetOrder(13)->LeavesQuantity == 23);
+    REQUIRE(market.GetOrder(15) == nullptr);
+}
+
+TEST_CASE("Hidden orders queue", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Hidden orders are kept apart from displayed orders of the price level
+    market.AddOrder(Order::SellLimit(1, 0, 10, 10, OrderTimeInForce::GTC, 0));
+    market.AddOrder(Order::SellLimit(2, 0, 10, 20));
+    market.AddOrder(Order::SellLimit(3, 0, 10, 30, OrderTimeInForce::GTC, 0));
+    market.AddOrder(Order::SellLimit(4, 0, 10, 40));
+    const LevelNode* level = market.GetOrderBook(0)->best_ask();
+    REQUIRE(level->Orders == 4);
+    REQUIRE(level->HiddenOrders == 2);
+    REQUIRE(level->HiddenOrderVolume == 40);
+    REQUIRE(level->VisibleVolume == 60);
+    REQUIRE(level->OrderList.size() == 2);
+    REQUIRE(level->HiddenOrderList.size() == 2);
+
+    // Hidden orders are queued behind all displayed orders
+    QueuePosition position;
+    REQUIRE(market.GetQueuePosition(4, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 1);
+    REQUIRE(position.VisibleVolume == 20);
+    REQUIRE(position.HiddenVolume == 0);
+    REQUIRE(market.GetQueuePosition(3, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 3);
+    REQUIRE(position.VisibleVolume == 60);
+    REQUIRE(position.HiddenVolume == 10);
+
+    // Displayed liquidity is matched first
+    market.AddOrder(Order::BuyLimit(5, 0, 10, 70));
+    REQUIRE(market.GetOrder(2) == nullptr);
+    REQUIRE(market.GetOrder(4) == nullptr);
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(3)->LeavesQuantity == 30);
+    REQUIRE(level->HiddenOrderVolume == 30);
+    REQUIRE(level->OrderList.empty());
+
+    // Hidden liquidity is matched after displayed one
+    market.AddOrder(Order::BuyLimit(6, 0, 10, 20));
+    REQUIRE(market.GetOrder(3)->LeavesQuantity == 10);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 10));
+}
+
+TEST_CASE("Iceberg replenishment", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    market.AddOrder(Order::SellLimit(1, 0, 10, 100, OrderTimeInForce::GTC, 20));
+    market.AddOrder(Order::SellLimit(2, 0, 10, 30));
+    const LevelNode* level = market.GetOrderBook(0)->best_ask();
+    REQUIRE(level->VisibleVolume == 50);
+    REQUIRE(level->HiddenVolume == 80);
+
+    // Executions consume the displayed slice
+    market.AddOrder(Order::BuyLimit(3, 0, 10, 15));
+    REQUIRE(market.GetOrder(1)->VisibleQuantity() == 5);
+    REQUIRE(market.GetOrder(1)->HiddenQuantity() == 80);
+    REQUIRE(level->VisibleVolume == 35);
+    REQUIRE(level->HiddenVolume == 80);
+
+    // Executed slice is replenished and loses its time priority
+    QueuePosition position;
+    REQUIRE(market.GetQueuePosition(2, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 1);
+    market.AddOrder(Order::BuyLimit(4, 0, 10, 5));
+    REQUIRE(market.GetOrder(1)->VisibleQuantity() == 20);
+    REQUIRE(market.GetOrder(1)->HiddenQuantity() == 60);
+    REQUIRE(level->VisibleVolume == 50);
+    REQUIRE(level->HiddenVolume == 60);
+    REQUIRE(level->OrderList.front()->Id == 2);
+    REQUIRE(market.GetQueuePosition(1, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 1);
+    REQUIRE(position.VisibleVolume == 30);
+    REQUIRE(market.GetQueuePosition(2, position) == ErrorCode::OK);
+    REQUIRE(position.Position == 0);
+
+    // Replenished slice is executed after orders ahead of it
+    market.AddOrder(Order::BuyLimit(5, 0, 10, 40));
+    REQUIRE(market.GetOrder(2) == nullptr);
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 70);
+    REQUIRE(market.GetOrder(1)->VisibleQuantity() == 10);
+    REQUIRE(level->VisibleVolume == 10);
+    REQUIRE(level->HiddenVolume == 60);
+
+    // External executions replenish the slice as well
+    REQUIRE(market.ExecuteOrder(1, 10) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(1)->VisibleQuantity() == 20);
+    REQUIRE(level->VisibleVolume == 20);
+    REQUIRE(level->HiddenVolume == 40);
+
+    // Large aggressive order takes only the displayed slice before displayed orders behind it
+    market.AddOrder(Order::SellLimit(6, 0, 10, 15));
+    market.AddOrder(Order::BuyLimit(7, 0, 10, 50));
+    REQUIRE(market.GetOrder(7) == nullptr);
+    REQUIRE(market.GetOrder(6) == nullptr);
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 25);
+    REQUIRE(market.GetOrder(1)->VisibleQuantity() == 5);
+    REQUIRE(level->VisibleVolume == 5);
+    REQUIRE(level->HiddenVolume == 20);
+
+    // The last displayed order is executed by its replenished slices
+    market.AddOrder(Order::BuyLimit(8, 0, 10, 30));
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(8)->LeavesQuantity == 5);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(5, 0));
+
+    // Modified order is added with the full displayed slice
+    market.AddOrder(Order::SellLimit(9, 0, 20, 100, OrderTimeInForce::GTC, 20));
+    REQUIRE(market.ExecuteOrder(9, 5) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(9)->VisibleQuantity() == 15);
+    REQUIRE(market.ModifyOrder(9, 20, 50) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(9)->VisibleQuantity() == 20);
+    REQUIRE(market.GetOrder(9)->HiddenQuantity() == 30);
+    REQUIRE(market.GetOrderBook(0)->best_ask()->VisibleVolume == 20);
+}
+
+TEST_CASE("Self-trade prevention", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    auto OwnedOrder = [](Order order, uint64_t owner, OrderSelfTradePrevention stp = OrderSelfTradePrevention::NONE)
+    {
+        order.OwnerId = owner;
+        order.SelfTradePrevention = stp;
+        return order;
+    };
+
+    // Cancel resting orders of the same owner and continue matching
+    market.AddOrder(OwnedOrder(Order::SellLimit(1, 0, 10, 10), 7));
+    market.AddOrder(OwnedOrder(Order::SellLimit(2, 0, 10, 10), 8));
+    market.AddOrder(OwnedOrder(Order::BuyLimit(3, 0, 10, 15), 7, OrderSelfTradePrevention::CANCEL_RESTING));
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(2) == nullptr);
+    REQUIRE(market.GetOrder(3)->LeavesQuantity == 5);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(5, 0));
+    market.DeleteOrder(3);
+
+    // Cancel the aggressive order
+    market.AddOrder(OwnedOrder(Order::SellLimit(4, 0, 10, 10), 8));
+    market.AddOrder(OwnedOrder(Order::SellLimit(5, 0, 10, 10), 7));
+    market.AddOrder(OwnedOrder(Order::SellLimit(6, 0, 10, 10), 8));
+    market.AddOrder(OwnedOrder(Order::BuyLimit(7, 0, 10, 30), 7, OrderSelfTradePrevention::CANCEL_AGGRESSOR));
+    REQUIRE(market.GetOrder(4) == nullptr);
+    REQUIRE(market.GetOrder(5)->LeavesQuantity == 10);
+    REQUIRE(market.GetOrder(7) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 20));
+
+    // Cancel both orders
+    market.AddOrder(OwnedOrder(Order::BuyLimit(8, 0, 10, 30), 7, OrderSelfTradePrevention::CANCEL_BOTH));
+    REQUIRE(market.GetOrder(5) == nullptr);
+    REQUIRE(market.GetOrder(6)->LeavesQuantity == 10);
+    REQUIRE(market.GetOrder(8) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 10));
+
+    // Decrement both orders
+    market.AddOrder(OwnedOrder(Order::SellLimit(9, 0, 10, 10), 7));
+    market.AddOrder(OwnedOrder(Order::BuyLimit(10, 0, 10, 15), 7, OrderSelfTradePrevention::DECREMENT));
+    REQUIRE(market.GetOrder(6) == nullptr);
+    REQUIRE(market.GetOrder(9)->LeavesQuantity == 5);
+    REQUIRE(market.GetOrder(10) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 5));
+
+    // Orders of the same owner without self-trade prevention are matched as usual
+    market.AddOrder(OwnedOrder(Order::BuyLimit(11, 0, 10, 5), 7));
+    REQUIRE(market.GetOrder(9) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+
+    // 'Fill-Or-Kill' order is cancelled by the resting order of the same owner ahead of the matching chain
+    market.AddOrder(OwnedOrder(Order::SellLimit(12, 0, 10, 10), 7));
+    market.AddOrder(OwnedOrder(Order::SellLimit(13, 0, 10, 10), 8));
+    market.AddOrder(OwnedOrder(Order::BuyLimit(14, 0, 10, 10, OrderTimeInForce::FOK), 7, OrderSelfTradePrevention::CANCEL_AGGRESSOR));
+    REQUIRE(market.GetOrder(12)->LeavesQuantity == 10);
+    REQUIRE(market.GetOrder(13)->LeavesQuantity == 10);
+    REQUIRE(market.GetOrder(14) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 20));
+
+    // 'Fill-Or-Kill' order cancels resting orders of the same owner and fills the matching chain
+    market.AddOrder(OwnedOrder(Order::BuyLimit(15, 0, 10, 10, OrderTimeInForce::FOK), 7, OrderSelfTradePrevention::CANCEL_RESTING));
+    REQUIRE(market.GetOrder(12) == nullptr);
+    REQUIRE(market.GetOrder(13) == nullptr);
+    REQUIRE(market.GetOrder(15) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+
+    // 'Fill-Or-Kill' order decrements both orders and fills the rest of the matching chain
+    market.AddOrder(OwnedOrder(Order::SellLimit(16, 0, 10, 10), 7));
+    market.AddOrder(OwnedOrder(Order::SellLimit(17, 0, 10, 10), 8));
+    market.AddOrder(OwnedOrder(Order::BuyLimit(18, 0, 10, 15, OrderTimeInForce::FOK), 7, OrderSelfTradePrevention::DECREMENT));
+    REQUIRE(market.GetOrder(16) == nullptr);
+    REQUIRE(market.GetOrder(17)->LeavesQuantity == 5);
+    REQUIRE(market.GetOrder(18) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 5));
+
+    // 'Fill-Or-Kill' order cancels both orders when the resting order of the same owner is reached
+    market.AddOrder(OwnedOrder(Order::SellLimit(19, 0, 10, 10), 7));
+    market.AddOrder(OwnedOrder(Order::BuyLimit(20, 0, 10, 10, OrderTimeInForce::FOK), 7, OrderSelfTradePrevention::CANCEL_BOTH));
+    REQUIRE(market.GetOrder(17)->LeavesQuantity == 5);
+    REQUIRE(market.GetOrder(19) == nullptr);
+    REQUIRE(market.GetOrder(20) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 5));
+}
+
+TEST_CASE("Sharded market manager", "[CppTrader][Matching]")
+{
+    EventHandler handler;
+    ShardedMarketManager market(handler, 2, 16);
+    REQUIRE(market.Start());
+
+    // Prepare symbols & order books in both shards
+    const char name[8] = "test";
+    Symbol symbol0 = { 0, name };
+    Symbol symbol1 = { 1, name };
+    market.AddSymbol(symbol0);
+    market.AddOrderBook(symbol0);
+    market.AddSymbol(symbol1);
+    market.AddOrderBook(symbol1);
+    REQUIRE(market.GetShard(0) != market.GetShard(1));
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Add orders interleaved between shards
+    for (uint64_t i = 0; i < 20; ++i)
+        REQUIRE(market.AddOrder(Order::BuyLimit(i + 1, (uint32_t)(i % 2), 10, 10)) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 1, 10, 10)) == ErrorCode::ORDER_DUPLICATE);
+    market.AddOrder(Order::SellLimit(21, 0, 10, 30));
+    market.AddOrder(Order::SellLimit(22, 1, 10, 15));
+    REQUIRE(market.ReduceOrder(100, 10) == ErrorCode::ORDER_NOT_FOUND);
+    market.DeleteOrder(20);
+    market.Synchronize();
+
+    // Merged events must follow the commands sequence order
+    REQUIRE(handler.events.size() == 39);
+    for (size_t i = 0; i < 20; ++i)
+        REQUIRE(handler.events[i] == std::make_pair('A', (uint64_t)(i + 1)));
+    REQUIRE(handler.events[20] == std::make_pair('A', (uint64_t)21));
+    REQUIRE(handler.events[31] == std::make_pair('A', (uint64_t)22));
+    REQUIRE(handler.events[38] == std::make_pair('D', (uint64_t)20));
+
+    // Cross-shard orders are found with the order Id directory
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(4)->LeavesQuantity == 5);
+    REQUIRE(market.GetOrder(7)->LeavesQuantity == 10);
+    REQUIRE(market.GetOrder(20) == nullptr);
+    REQUIRE(market.GetOrder(21) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(70, 0));
+    REQUIRE(BookVolume(market.GetOrderBook(1)) == std::make_pair(75, 0));
+
+    // Order Id is released when its delete event is dispatched
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 1, 10, 10)) == ErrorCode::OK);
+
+    // Order Ids of the deleted order book orders are released
+    market.DeleteOrderBook(1);
+    market.AddOrderBook(symbol1);
+    market.Synchronize();
+    REQUIRE(market.AddOrder(Order::BuyLimit(4, 1, 10, 10)) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 1, 10, 10)) == ErrorCode::OK);
+    market.Synchronize();
+    REQUIRE(market.GetOrder(4)->LeavesQuantity == 10);
+    REQUIRE(BookOrders(market.GetOrderBook(1)) == std::make_pair(2, 0));
+    REQUIRE(BookVolume(market.GetOrderBook(1)) == std::make_pair(20, 0));
+
+    // Old order Id is still routed when the shard rejects the replace
+    uint64_t max = std::numeric_limits<uint64_t>::max();
+    if (!IsRepresentable<QuantityValue>(max))
+    {
+        REQUIRE(market.ReplaceOrder(4, 30, 10, max) == ErrorCode::OK);
+        market.Synchronize();
+        REQUIRE(market.GetOrder(30) == nullptr);
+        REQUIRE(market.GetOrder(4)->LeavesQuantity == 10);
+    }
+
+    // Old order Id is released when the delete event of the replaced order is dispatched
+    REQUIRE(market.ReplaceOrder(4, 31, 10, 5) == ErrorCode::OK);
+    market.Synchronize();
+    REQUIRE(market.GetOrder(4) == nullptr);
+    REQUIRE(market.GetOrder(31)->LeavesQuantity == 5);
+    REQUIRE(market.AddOrder(Order::BuyLimit(4, 1, 10, 10)) == ErrorCode::OK);
+
+    REQUIRE(market.Stop());
+    REQUIRE(market.GetOrder(1)->SymbolId == 1);
+}
+
+TEST_CASE("Top of the book", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    REQUIRE(market.GetOrderBook(0)->top_of_book() == nullptr);
+
+    // Enable automatic matching and the top of the book publishing
+    market.EnableMatching();
+    market.AddOrder(Order::BuyLimit(1, 0, 10, 10));
+    REQUIRE(market.SetOrderBookTopOfBook(0, true) == ErrorCode::OK);
+    const TopOfBook* top = market.GetOrderBook(0)->top_of_book();
+    REQUIRE(top != nullptr);
+    TopOfBookSnapshot snapshot = top->Read();
+    REQUIRE(snapshot.BidPrice == 10);
+    REQUIRE(snapshot.BidVolume == 10);
+    REQUIRE(snapshot.AskPrice == 0);
+
+    // Hidden volume is not published
+    market.AddOrder(Order::BuyLimit(2, 0, 20, 10, OrderTimeInForce::GTC, 5));
+    market.AddOrder(Order::SellLimit(3, 0, 30, 20));
+    snapshot = top->Read();
+    REQUIRE(snapshot.BidPrice == 20);
+    REQUIRE(snapshot.BidVolume == 5);
+    REQUIRE(snapshot.AskPrice == 30);
+    REQUIRE(snapshot.AskVolume == 20);
+
+    // Executions publish the last trade price
+    uint64_t version = top->version();
+    market.AddOrder(Order::SellLimit(4, 0, 20, 10));
+    snapshot = top->Read();
+    REQUIRE(snapshot.Version > version);
+    REQUIRE(snapshot.BidPrice == 10);
+    REQUIRE(snapshot.LastPrice == 20);
+
+    // Concurrent readers always take uncrossed snapshots
+    std::atomic<bool> done(false);
+    std::atomic<size_t> crossed(0);
+    std::thread reader([top, &done, &crossed]()
+    {
+        while (!done)
+        {
+            TopOfBookSnapshot current = top->Read();
+            if ((current.BidPrice >= current.AskPrice) && (current.AskPrice != 0))
+                ++crossed;
+        }
+    });
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        market.AddOrder(Order::BuyLimit(100 + i, 0, 10 + (i % 19), 10));
+        market.AddOrder(Order::SellLimit(100000 + i, 0, 29 - (i % 19), 10));
+    }
+    done = true;
+    reader.join();
+    REQUIRE(crossed == 0);
+
+    // Disable the top of the book publishing
+    REQUIRE(market.SetOrderBookTopOfBook(0, false) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->top_of_book() == nullptr);
+}
+
+TEST_CASE("Asynchronous market handler", "[CppTrader][Matching]")
+{
+    // Prepare the order book to publish price level updates
+    MarketManager source;
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    source.AddSymbol(symbol);
+    source.AddOrderBook(symbol);
+    const auto& order_book = *source.GetOrderBook(0);
+
+    SECTION("Block")
+    {
+        AsyncEventHandler handler(16, AsyncPolicy::BLOCK);
+        MarketManager market(handler);
+        REQUIRE(handler.Start(2));
+
+        market.AddSymbol(symbol);
+        market.AddOrderBook(symbol);
+        for (uint64_t i = 1; i <= 100; ++i)
+            market.AddOrder(Order::BuyLimit(i, 0, i, 10));
+        REQUIRE(handler.Stop());
+
+        // All events are handled
+        REQUIRE(handler.lost() == 0);
+        REQUIRE(handler.consumed() == handler.published());
+        REQUIRE(handler.events.size() == handler.published());
+
+        // Event sequence numbers are contiguous
+        std::sort(handler.events.begin(), handler.events.end(), [](const auto& event1, const auto& event2) { return event1.first < event2.first; });
+        for (size_t i = 0; i < handler.events.size(); ++i)
+            REQUIRE(handler.events[i].first == i);
+        REQUIRE(handler.events[0].second.Type == MarketEventType::ADD_SYMBOL);
+        REQUIRE(std::count_if(handler.events.begin(), handler.events.end(), [](const auto& event) { return event.second.Type == MarketEventType::ADD_ORDER; }) == 100);
+    }
+
+    SECTION("Drop oldest")
+    {
+        AsyncEventHandler handler(8, AsyncPolicy::DROP_OLDEST);
+
+        // Overload the events ring before consumers are started
+        Level level(LevelType::BID, 10);
+        for (uint64_t i = 1; i <= 20; ++i)
+        {
+            level.TotalVolume = level.VisibleVolume = i;
+            handler.onUpdateLevel(order_book, level, true);
+        }
+        REQUIRE(handler.published() == 20);
+        REQUIRE(handler.lost() == 12);
+
+        REQUIRE(handler.Start());
+        REQUIRE(handler.Stop());
+
+        // Only the latest events are handled
+        REQUIRE(handler.consumed() == 8);
+        REQUIRE(handler.events.size() == 8);
+        REQUIRE(handler.events.front().first == 12);
+        REQUIRE(handler.events.front().second.LevelData.TotalVolume == 13);
+        REQUIRE(handler.events.back().second.LevelData.TotalVolume == 20);
+    }
+
+    SECTION("Conflate")
+    {
+        AsyncEventHandler handler(8, AsyncPolicy::CONFLATE);
+
+        // Fill the events ring before consumers are started
+        for (uint64_t i = 1; i <= 8; ++i)
+        {
+            Level level(LevelType::BID, i);
+            handler.onUpdateLevel(order_book, level, false);
+        }
+
+        // Conflate updates of two price levels
+        for (uint64_t i = 1; i <= 10; ++i)
+        {
+            Level level(LevelType::ASK, ((i % 2) == 0) ? 100 : 200);
+            level.TotalVolume = level.VisibleVolume = i;
+            handler.onUpdateLevel(order_book, level, (i == 1));
+        }
+        REQUIRE(handler.published() == 8);
+        REQUIRE(handler.lost() == 8);
+
+        REQUIRE(handler.Start());
+        REQUIRE(handler.Stop());
+
+        // Conflated updates keep the latest price level state
+        REQUIRE(handler.consumed() == 10);
+        REQUIRE(handler.events.size() == 10);
+        REQUIRE(handler.events[8].second.LevelData.Price == 200);
+        REQUIRE(handler.events[8].second.LevelData.TotalVolume == 9);
+        REQUIRE(handler.events[8].second.Top);
+        REQUIRE(handler.events[9].second.LevelData.Price == 100);
+        REQUIRE(handler.events[9].second.LevelData.TotalVolume == 10);
+    }
+}
+
+TEST_CASE("Market gateway", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    MarketGateway gateway(market, 16, 8);
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Submit commands from several session threads
+    const size_t sessions = 4;
+    const size_t orders = 1000;
+    std::atomic<size_t> finished(0);
+    std::atomic<size_t> succeeded(0);
+    std::vector<std::thread> threads;
+    for (size_t session = 0; session < sessions; ++session)
+    {
+        threads.emplace_back([&gateway, &finished, &succeeded, session]()
+        {
+            MarketCompletion completion;
+            bool success = true;
+            for (uint64_t i = 1; success && (i <= orders); ++i)
+            {
+                uint64_t id = session * orders + i;
+                gateway.AddOrder(Order::BuyLimit(id, 0, 10 + (id % 7), 10), &completion);
+                if ((completion.Wait() != ErrorCode::OK) || !completion.Active || (completion.State.Id != id))
+                    success = false;
+
+                // Delete every second order
+                if (success && ((i % 2) == 0))
+                {
+                    gateway.DeleteOrder(id, &completion);
+                    if ((completion.Wait() != ErrorCode::OK) || completion.Active)
+                        success = false;
+                }
+            }
+            if (success)
+                ++succeeded;
+            ++finished;
+        });
+    }
+
+    // Apply commands in batches in the market manager thread
+    while (finished < sessions)
+        REQUIRE(gateway.Process() <= gateway.batch());
+    for (auto& thread : threads)
+        thread.join();
+    REQUIRE(succeeded == sessions);
+
+    REQUIRE(gateway.applied() == gateway.submitted());
+    REQUIRE(gateway.applied() == (sessions * orders * 3 / 2));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair((int)(sessions * orders / 2), 0));
+
+    // Completion reports the order state after the command
+    MarketCompletion completion;
+    REQUIRE(gateway.ModifyOrder(1, 20, 5, &completion) == ErrorCode::OK);
+    REQUIRE(!completion.IsDone());
+    REQUIRE(gateway.Process() == 1);
+    REQUIRE(completion.Wait() == ErrorCode::OK);
+    REQUIRE(completion.Active);
+    REQUIRE(completion.State.Price == 20);
+    REQUIRE(completion.State.LeavesQuantity == 5);
+
+    // Failed commands report their error codes
+    REQUIRE(gateway.DeleteOrder(2, &completion) == ErrorCode::OK);
+    REQUIRE(gateway.Process() == 1);
+    REQUIRE(completion.Wait() == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(!completion.Active);
+}